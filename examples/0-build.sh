@@ -12,5 +12,6 @@ function build() {
 }
 
 build ./models/dcdc_bdd
+build ./models/dcdc
 build ./models/vehicle_bdd
 build ./models/aircraft_bdd
@@ -12,5 +12,6 @@ function run() {
 }
 
 run ./models/dcdc_bdd dcdc
+run ./models/dcdc dcdc
 run ./models/vehicle_bdd vehicle
 # run ./models/aircraft_bdd aircraft
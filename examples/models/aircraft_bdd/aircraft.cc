@@ -78,12 +78,45 @@ auto radius_post = [] (state_type &r, const state_type &, const input_type &u) {
   scots::runge_kutta_fixed4(rhs,r,u,state_dim,tau,5);
 };
 
+/* the same for lanes (x,u) pairs at a time, the loops over the lanes are vectorized */
+const int lanes = 4;
+using state_batch = scots::point_batch<state_type,lanes>;
+using input_batch = scots::point_batch<input_type,lanes>;
+
+auto aircraft_post_batch = [] (state_batch &x, const input_batch &u) {
+  auto rhs =[] (state_batch& xx,  const state_batch &x, const input_batch &u) {
+    double mg = 60000.0*9.81;
+    double mi = 1.0/60000;
+    for(int l=0; l<lanes; l++) {
+      double c=(1.25+4.2*u[1][l]);
+      xx[0][l] = mi*(u[0][l]*std::cos(u[1][l])-(2.7+3.08*c*c)*x[0][l]*x[0][l]-mg*std::sin(x[1][l]));
+      xx[1][l] = (1.0/(60000*x[0][l]))*(u[0][l]*std::sin(u[1][l])+68.6*c*x[0][l]*x[0][l]-mg*std::cos(x[1][l]));
+      xx[2][l] = x[0][l]*std::sin(x[1][l]);
+    }
+  };
+  scots::runge_kutta_fixed4_batch(rhs,x,u,state_dim,tau,5);
+};
+
+auto radius_post_batch = [] (state_batch &r, const state_batch &, const input_batch &u) {
+  auto rhs =[] (state_batch& rr,  const state_batch &r, const input_batch &u) {
+    for(int l=0; l<lanes; l++) {
+      double L00=-0.00191867*(2.7+3.08*(1.25+4.2*u[1][l])*(1.25+4.2*u[1][l]));
+      double L10=0.002933+0.004802*u[1][l];
+      rr[0][l] = L00*r[0][l]+9.81*r[1][l]+.108;
+      rr[1][l] = L10*r[0][l]+0.003623*r[1][l]+0.002;
+      rr[2][l] = 0.07483*r[0][l]+83.22*r[1][l];
+    }
+  };
+  scots::runge_kutta_fixed4_batch(rhs,r,u,state_dim,tau,5);
+};
+
 int main() {
   /* to measure time */
   TicToc tt;
 
   /* cudd manager */
   Cudd mgr;
+  /* sifting moves the variable groups of SymbolicModel::group_bdd_vars as a whole */
   mgr.AutodynEnable();
 
 
@@ -116,7 +149,8 @@ int main() {
   ss_input.print_info();
   scots::SymbolicSet controller(ss_pre,ss_input);
 
-  scots::SymbolicSet ss_post(mgr, state_dim,s_lb,s_ub,s_eta);
+  /* the post variables are interleaved with the pre variables */
+  scots::SymbolicSet ss_post = scots::SymbolicSet::interleaved(mgr,ss_pre);
   /* transition function of symbolic model */
   BDD TF;
 
@@ -129,7 +163,8 @@ int main() {
   std::cout << "Computing the transition function: " << std::endl;
   tt.tic();
   size_t no_trans;
-  TF = sym_model.compute_gb(mgr,aircraft_post,radius_post,no_trans);
+  /* aircraft_post and radius_post give the same transitions, one pair at a time */
+  TF = sym_model.compute_gb(mgr,scots::make_batch_post<lanes,state_type,input_type>(aircraft_post_batch,radius_post_batch),no_trans);
   tt.toc();
   std::cout << "Number of transitions: " << no_trans << std::endl;
   if(!getrusage(RUSAGE_SELF, &usage))
@@ -0,0 +1,184 @@
+/*
+ * dcdc.cc
+ *
+ *  created: Oct 2026
+ *   author: Antonio Rueda
+ */
+
+/*
+ * the dcdc example of dcdc_bdd with the explicit engine (Abstraction and
+ * solve_invariance_game), information is given in the readme file
+ */
+
+#include <iostream>
+#include <array>
+#include <cmath>
+#include <string>
+
+/* SCOTS header */
+#include "scots.hh"
+/* ode solver */
+#include "RungeKutta4.hh"
+
+/* time profiling */
+#include "TicToc.hh"
+/* memory profiling */
+#include <sys/time.h>
+#include <sys/resource.h>
+struct rusage usage;
+
+
+/* state space dim */
+const int state_dim=2;
+/* input space dim */
+const int input_dim=1;
+/* sampling time */
+const double tau = 0.5;
+
+/*
+ * data types for the elements of the state space
+ * and input space used by the ODE solver
+ */
+using state_type = std::array<double,state_dim>;
+using input_type = std::array<double,input_dim>;
+
+/* abbrev of the type for abstract states and inputs */
+using abs_type = scots::abs_type;
+
+/* parameters for system dynamics */
+const double xc=70;
+const double xl=3;
+const double rc=0.005;
+const double rl=0.05;
+const double ro=1;
+const double vs=1;
+/* we integrate the dcdc ode by 0.5 sec (the result is stored in x)  */
+auto system_post = [](state_type &x, const input_type &u) noexcept {
+  /* the ode describing the dcdc converter */
+  auto rhs =[](state_type& xx,  const state_type &x, const input_type &u) noexcept {
+    if(u[0]==1) {
+      xx[0]=-rl/xl*x[0]+vs/xl;
+      xx[1]=-1/(xc*(ro+rc))*x[1];
+    } else {
+      xx[0]=-(1/xl)*(rl+ro*rc/(ro+rc))*x[0]-(1/xl)*ro/(5*(ro+rc))*x[1]+vs/xl;
+      xx[1]=(1/xc)*5*ro/(ro+rc)*x[0]-(1/xc)*(1/(ro+rc))*x[1];
+    }
+  };
+  scots::runge_kutta_fixed4(rhs,x,u,state_dim,tau);
+};
+/* we integrate the growth bound by 0.5 sec (the result is stored in r)  */
+auto radius_post = [](state_type &r, const state_type&, const input_type &u) noexcept {
+  /* the ode for the growth bound */
+  auto rhs =[](state_type& rr,  const state_type &r, const input_type &u) noexcept {
+    if(u[0]==1) {
+      rr[0]=-rl/xl*r[0];
+      rr[1]=-1/(xc*(ro+rc))*r[1];
+    } else {
+      rr[0]=-(1/xl)*(rl+ro*rc/(ro+rc))*r[0]+(1/xl)*ro/(5*(ro+rc))*r[1];
+      rr[1]=5*(1/xc)*ro/(ro+rc)*r[0]-(1/xc)*(1/(ro+rc))*r[1];
+    }
+  };
+  scots::runge_kutta_fixed4(rhs,r,u,state_dim,tau);
+};
+
+/* true iff both transition functions have the same pres, in the same order */
+bool same_transitions(const scots::TransitionFunction& a, const scots::TransitionFunction& b) {
+  if(a.m_no_states!=b.m_no_states || a.m_no_inputs!=b.m_no_inputs ||
+     a.m_no_transitions!=b.m_no_transitions)
+    return false;
+  scots::abs_ptr_type NM=static_cast<scots::abs_ptr_type>(a.m_no_states)*a.m_no_inputs;
+  for(scots::abs_ptr_type p=0; p<NM; p++) {
+    if(a.m_no_pre[p]!=b.m_no_pre[p] || a.m_no_post[p]!=b.m_no_post[p] ||
+       a.m_pre_ptr[p]!=b.m_pre_ptr[p])
+      return false;
+  }
+  for(scots::abs_ptr_type t=0; t<a.m_no_transitions; t++) {
+    if(a.m_pre[t]!=b.m_pre[t])
+      return false;
+  }
+  return true;
+}
+
+/*
+ * usage: dcdc [number of threads]
+ *
+ * the transition function is computed on the given number of threads, by
+ * default one per hardware thread. With more than one thread it is compared
+ * with the one computed on a single thread.
+ */
+int main(int argc, char* argv[]) {
+  /* to measure time */
+  TicToc tt;
+
+  /* setup the workspace of the synthesis problem and the uniform grid */
+  /* grid node distance diameter */
+  state_type eta={{20.0/4e3,20.0/4e3}};
+  /* lower bounds of the hyper-rectangle */
+  state_type lb={{0.649,4.949}};
+  /* upper bounds of the hyper-rectangle */
+  state_type ub={{1.65,5.95}};
+  scots::UniformGrid ss(state_dim,lb,ub,eta);
+  std::cout << "Unfiorm grid details:\n";
+  ss.print_info();
+
+  /* construct grid for the input alphabet */
+  /* hyper-rectangle [1,2] with grid node distance 1 */
+  scots::UniformGrid is(input_dim,input_type{{.99}},input_type{{2.1}},input_type{{1}});
+  is.print_info();
+
+  /* the posts are pure functions, so compute_gb can call them concurrently */
+  int no_threads = (argc>1) ? std::stoi(argv[1]) : scots::default_no_threads();
+  scots::Abstraction<state_type,input_type> abs(ss,is);
+  abs.set_no_threads(no_threads);
+
+  /* compute transition function of the abstraction */
+  std::cout << "Computing the transition function on " << abs.get_no_threads() << " threads:\n";
+  scots::TransitionFunction tf;
+  tt.tic();
+  abs.compute_gb(tf,system_post,radius_post);
+  tt.toc();
+
+  std::cout << "No of Transitions " << tf.get_no_transitions()  << "\n";
+  if(!getrusage(RUSAGE_SELF, &usage)) {
+    std::cout << "Memory pro Transition: " << usage.ru_maxrss/(double)tf.get_no_transitions() << "\n";
+  }
+
+  if(abs.get_no_threads()>1) {
+    std::cout << "Checking against the transition function of a single thread:\n";
+    scots::TransitionFunction tf_single;
+    abs.set_no_threads(1);
+    abs.compute_gb(tf_single,system_post,radius_post);
+    if(!same_transitions(tf,tf_single)) {
+      std::cerr << "The transition functions differ\n";
+      return 1;
+    }
+    std::cout << "Same transition function\n";
+  }
+
+  /* we continue with the controller synthesis for G (safe) */
+  std::cout << "Synthesis: ";
+  /* inner approximation of safe set */
+  auto safe = [&ss,&eta](const abs_type& idx) {
+    double h[4] = {1.1,1.6,5.4, 5.9};
+    state_type x{};
+    ss.itox(idx,x);
+    double c1= eta[0]/2.0+1e-10;
+    double c2= eta[1]/2.0+1e-10;
+    if ((h[0]+c1) <= x[0] && x[0] <= (h[1]-c1) &&
+        (h[2]+c2) <= x[1] && x[1] <= (h[3]-c2)) {
+      return true;
+    }
+    return false;
+  };
+  tt.tic();
+  scots::WinningDomain win = scots::solve_invariance_game(tf,safe);
+  tt.toc();
+
+  std::cout << "Winning domain size: " << win.get_size() << std::endl;
+
+  std::cout << "\nWrite controller to controller.scs \n";
+  if(write_to_file(scots::StaticController(ss,is,std::move(win)),"controller"))
+    std::cout << "Done. \n";
+
+  return 0;
+}
@@ -13,6 +13,7 @@
 
 #include <iostream>
 #include <array>
+#include <cstdio>
 
 /* SCOTS header */
 #include "scots.hh"
@@ -69,6 +70,7 @@ int main() {
   TicToc tt;
   /* cudd manager */
   Cudd mgr;
+  /* sifting moves the variable groups of SymbolicModel::group_bdd_vars as a whole */
   mgr.AutodynEnable();
   //mgr.AutodynDisable();
 
@@ -110,62 +112,59 @@ int main() {
 
   scots::SymbolicSet ss_post;
   if(!scots::read_from_file(mgr,ss_post,"state_post")) {
-   /* lower bounds of the hyper rectangle */
-    state_type s_lb={{0,0,-3.5}};
-    /* upper bounds of the hyper rectangle */
-    state_type s_ub={{10,10,3.5}};
-    /* grid node distance diameter */
-    state_type s_eta={{.2,.2,.2}};
     /* construct SymbolicSet with the UniformGrid information for the state space
-     * and BDD variable IDs for the post */
-    ss_post = scots::SymbolicSet(mgr, state_dim,s_lb,s_ub,s_eta);
+     * and BDD variable IDs for the post, each right below the one of the pre */
+    ss_post = scots::SymbolicSet::interleaved(mgr,ss_pre);
 
     scots::write_to_file(ss_post,"state_post");
+  } else {
+    /* the file only holds the IDs, restore the interleaved order */
+    scots::SymbolicSet::interleave(mgr,ss_pre,ss_post);
   }
 
 
+  /* set up constraint functions with obtacles */
+  double H[15][4] = {
+    { 1  , 1.2, 0  ,   9 },
+    { 2.2, 2.4, 0  ,   5 },
+    { 2.2, 2.4, 6  ,  10 },
+    { 3.4, 3.6, 0  ,   9 },
+    { 4.6, 4.8, 1  ,  10 },
+    { 5.8, 6  , 0  ,   6 },
+    { 5.8, 6  , 7  ,  10 },
+    { 7  , 7.2, 1  ,  10 },
+    { 8.2, 8.4, 0  ,  8.5},
+    { 8.4, 9.3, 8.3,  8.5},
+    { 9.3, 10 , 7.1,  7.3},
+    { 8.4, 9.3, 5.9,  6.1},
+    { 9.3, 10 , 4.7,  4.9},
+    { 8.4, 9.3, 3.5,  3.7},
+    { 9.3, 10 , 2.3,  2.5}
+  };
+  /* avoid function returns 1 if x is in avoid set  */
+  auto avoid = [&H,&ss_pre](const abs_type& idx) {
+    state_type x;
+    ss_pre.itox(idx,x);
+    double c1= ss_pre.get_eta()[0]/2.0+1e-10;
+    double c2= ss_pre.get_eta()[1]/2.0+1e-10;
+    for(size_t i=0; i<15; i++) {
+      if ((H[i][0]-c1) <= x[0] && x[0] <= (H[i][1]+c1) &&
+          (H[i][2]-c2) <= x[1] && x[1] <= (H[i][3]+c2))
+        return true;
+    }
+    return false;
+  };
+  /* compute BDD for the avoid set (returns the number of elements) */
+  BDD A = ss_pre.ap_to_bdd(mgr,avoid);
+  /* write ap to files avoid.scs/avoid.bdd */
+  scots::write_to_file(mgr,ss_pre,A,"obstacles");
+
   BDD TF;
   /* initialize SymbolicModel class with the abstract state and input alphabet */
   scots::SymbolicModel<state_type,input_type> sym_model(ss_pre,ss_input,ss_post);
   /* does there exist the transition function file ?*/
   scots::SymbolicSet set;
   if(!scots::read_from_file(mgr,set,TF,"tf")) {
-    /* set up constraint functions with obtacles */
-    double H[15][4] = {
-      { 1  , 1.2, 0  ,   9 },
-      { 2.2, 2.4, 0  ,   5 },
-      { 2.2, 2.4, 6  ,  10 },
-      { 3.4, 3.6, 0  ,   9 },
-      { 4.6, 4.8, 1  ,  10 },
-      { 5.8, 6  , 0  ,   6 },
-      { 5.8, 6  , 7  ,  10 },
-      { 7  , 7.2, 1  ,  10 },
-      { 8.2, 8.4, 0  ,  8.5},
-      { 8.4, 9.3, 8.3,  8.5},
-      { 9.3, 10 , 7.1,  7.3},
-      { 8.4, 9.3, 5.9,  6.1},
-      { 9.3, 10 , 4.7,  4.9},
-      { 8.4, 9.3, 3.5,  3.7},
-      { 9.3, 10 , 2.3,  2.5}
-    };
-    /* avoid function returns 1 if x is in avoid set  */
-    auto avoid = [&H,&ss_pre](const abs_type& idx) {
-      state_type x;
-      ss_pre.itox(idx,x);
-      double c1= ss_pre.get_eta()[0]/2.0+1e-10;
-      double c2= ss_pre.get_eta()[1]/2.0+1e-10;
-      for(size_t i=0; i<15; i++) {
-        if ((H[i][0]-c1) <= x[0] && x[0] <= (H[i][1]+c1) &&
-            (H[i][2]-c2) <= x[1] && x[1] <= (H[i][3]+c2))
-          return true;
-      }
-      return false;
-    };
-    /* compute BDD for the avoid set (returns the number of elements) */
-    BDD A = ss_pre.ap_to_bdd(mgr,avoid);
-    /* write ap to files avoid.scs/avoid.bdd */
-    scots::write_to_file(mgr,ss_pre,A,"obstacles");
-
     set = scots::SymbolicSet(scots::SymbolicSet(ss_pre,ss_input),ss_post);
 
     std::cout << "Computing the transition function: " << std::endl;
@@ -178,6 +177,9 @@ int main() {
       std::cout << "Memory per transition: " << usage.ru_maxrss/(double)no_trans << std::endl;
 
     scots::write_to_file(mgr,set,TF,"tf");
+    /* the layers of synthesis.scs/bdd belong to the old transition function */
+    std::remove("synthesis.scs");
+    std::remove("synthesis.bdd");
   }
 
   /* define target set */
@@ -202,33 +204,47 @@ int main() {
   /*
    * we implement the fixed point algorithm
    *
-   * mu X. ( pre(X) | T )
+   * mu X. ( (pre(X) & !A) | T )
    *
+   * the obstacles of tf.bdd have no transitions, further obstacles only
+   * need to be added to A. The controller and value layers are kept in
+   * synthesis.scs/bdd, which are removed when tf.bdd is recomputed. If
+   * present and over the grid of ss_pre, only the layers affected by a
+   * changed target or avoid set are recomputed.
    */
 
   /* setup enforcable predecessor */
   scots::EnfPre enf_pre(mgr,TF,sym_model);
-  tt.tic();
-  BDD X = mgr.bddOne();
-  BDD XX =mgr.bddZero();
-  /* the controller */
-  BDD C = mgr.bddZero();
   /* BDD cube for existential abstract inputs */
   BDD U = ss_input.get_cube(mgr);
-  /* as long as not converged */
-  size_t i;
-  for(i=1; XX != X; i++ ) {
-    X=XX;
-    XX=enf_pre(X) | T;
-    /* new (state/input) pairs */
-    BDD N = XX & (!(C.ExistAbstract(U)));
-    /* add new (state/input) pairs to the controller */
-    C=C | N;
-    /* print progress */
-    scots::print_progress(i);
+  tt.tic();
+  scots::SymbolicReachResult previous;
+  scots::SymbolicReachResult result;
+  scots::SymbolicSet ss_synthesis;
+  /* the layers are only reused if they are over the grid and BDD variables of ss_pre */
+  auto same_grid = [&ss_pre](const scots::SymbolicSet& set) {
+    if(set.get_dim()!=ss_pre.get_dim() ||
+       set.get_no_gp_per_dim()!=ss_pre.get_no_gp_per_dim() ||
+       set.get_bdd_var_ids()!=ss_pre.get_bdd_var_ids())
+      return false;
+    for(int i=0; i<ss_pre.get_dim(); i++) {
+      double tol=ss_pre.get_eta()[i]*1e-6;
+      if(std::abs(set.get_eta()[i]-ss_pre.get_eta()[i])>tol ||
+         std::abs(set.get_lower_left()[i]-ss_pre.get_lower_left()[i])>tol)
+        return false;
+    }
+    return true;
+  };
+  if(scots::read_from_file(mgr,ss_synthesis,previous,"synthesis") && same_grid(ss_synthesis)) {
+    std::cout << "Warm start from synthesis.scs" << std::endl;
+    result = scots::resolve_reachability_game(mgr,enf_pre,U,previous,T,A);
+  } else {
+    result = scots::solve_reachability_game(mgr,enf_pre,U,T,A);
   }
-  std::cout << "\nNumber of iterations: " << i << std::endl;
   tt.toc();
+  scots::write_to_file(mgr,ss_pre,result,"synthesis");
+  /* the controller */
+  BDD C = result.controller;
 
   std::cout << "Winning domain size: " << ss_pre.get_size(mgr,C) << std::endl;
 
@@ -13,9 +13,12 @@
 #include <cstring>
 #include <memory>
 #include <vector>
+#include <algorithm>
 
 #include "UniformGrid.hh"
 #include "TransitionFunction.hh"
+#include "Threads.hh"
+#include "BatchPost.hh"
 
 /** @namespace scots **/ 
 namespace scots {
@@ -23,7 +26,7 @@ namespace scots {
 /** @cond **/
 /* default parameter for the third parameter of Abstraction::compute_gb  */
 namespace params {
-  auto avoid_abs = [](const abs_type&) noexcept {return false;};
+  static auto avoid_abs = [](const abs_type&) noexcept {return false;};
 }
 /** @endcond **/
 
@@ -54,6 +57,8 @@ private:
   std::unique_ptr<double[]> m_z;
   /* print progress to the console (default m_verbose=true) */
   bool m_verbose=true;
+  /* number of threads of compute_gb (default m_no_threads=1, see set_no_threads) */
+  int m_no_threads=1;
   /* to display the progress of the computation of the abstraction */
   void progress(const abs_type& i, const abs_type& N, abs_type& counter) {
     if(!m_verbose)
@@ -129,6 +134,17 @@ public:
    * attainable set of cell with ID=i under input ID=j
    * 
    * In the second loop the data members of the TransitionFunction are computed.
+   *
+   * Both loops run on get_no_threads() threads, one by default, each one
+   * taking a contiguous range of cells. With more than one thread
+   * system_post, radius_post and avoid are called concurrently and need to
+   * be thread safe. In the first loop every thread
+   * counts the pres of its cells in its own histogram. The histograms are
+   * summed to m_no_pre, m_pre_ptr is the prefix sum of m_no_pre and every
+   * thread gets its own range in each list of pres, so that the second loop
+   * fills m_pre without locks. The pres are stored in the same order as with
+   * a single thread. Each thread besides the first needs an additional array
+   * of N*M abs_type for its histogram.
    * 
    **/
   template<class F1, class F2, class F3=decltype(params::avoid_abs)>
@@ -136,29 +152,44 @@ public:
                   F1& system_post, 
                   F2& radius_post, 
                   F3& avoid=params::avoid_abs) {
+    ScalarPost<state_type,input_type,F1,F2> post(system_post,radius_post);
+    compute_gb_post(transition_function,post,avoid);
+  }
+
+  /** 
+   * @brief computes the transition function with the posts of LANES (cell,
+   * input) pairs at a time
+   *
+   * The same as compute_gb with system_post and radius_post, but the
+   * lambda expressions of post work on point_batch arguments (see BatchPost
+   * and runge_kutta_fixed4_batch). The pairs of consecutive cells of a thread
+   * are integrated together, LANES at a time.
+   **/
+  template<int LANES, class F1, class F2, class F3=decltype(params::avoid_abs)>
+  void compute_gb(TransitionFunction& transition_function, 
+                  BatchPost<state_type,input_type,LANES,F1,F2> post, 
+                  F3& avoid=params::avoid_abs) {
+    compute_gb_post(transition_function,post,avoid);
+  }
+
+private:
+  /* compute_gb with the posts of post (ScalarPost or BatchPost) */
+  template<class P, class F3>
+  void compute_gb_post(TransitionFunction& transition_function, 
+                       const P& post, 
+                       F3& avoid) {
     /* number of cells */
     abs_type N=m_state_alphabet.size(); 
     /* number of inputs */
     abs_type M=m_input_alphabet.size();
-    /* number of transitions (to be computed) */
-    abs_ptr_type T=0; 
+    /* number of (cell, input) pairs */
+    abs_ptr_type NM=static_cast<abs_ptr_type>(N)*M;
     /* state space dimension */
     int dim=m_state_alphabet.get_dim();
-    /* for display purpose */
-    abs_type counter=0;
     /* some grid information */
     std::vector<abs_type> NN=m_state_alphabet.get_nn();
-    /* variables for managing the post */
-    std::vector<abs_type> lb(dim);  /* lower-left corner */
-    std::vector<abs_type> ub(dim);  /* upper-right corner */
-    std::vector<abs_type> no(dim);  /* number of cells per dim */
-    std::vector<abs_type> cc(dim);  /* coordinate of current cell in the post */
     /* radius of hyper interval containing the attainable set */
     state_type eta;
-    state_type r;
-    /* state and input variables */
-    state_type x;
-    input_type u;
     /* for out of bounds check */
     state_type lower_left;
     state_type upper_right;
@@ -174,160 +205,267 @@ public:
     std::unique_ptr<abs_type[]> corner_IDs(new abs_type[N*M*2]());
     /* is post of (i,j) out of domain ? */
     std::unique_ptr<bool[]> out_of_domain(new bool[N*M]());
+    /* the threads, thread t works on the cells [first_cell(t); first_cell(t+1)) */
+    const int no_threads = static_cast<int>(std::max<abs_type>(1, std::min<abs_type>(m_no_threads, N)));
+    auto first_cell = [N,no_threads](const int t) {
+      return static_cast<abs_type>(static_cast<abs_ptr_type>(N)*t/no_threads);
+    };
+    /* number of pres of (q,j) per thread, a single thread counts in m_no_pre directly */
+    std::vector<std::unique_ptr<abs_type[]>> thread_no_pre(no_threads);
+    std::vector<abs_type*> no_pre(no_threads, transition_function.m_no_pre.get());
+    if(no_threads>1) {
+      for(int t=0; t<no_threads; t++) {
+        thread_no_pre[t].reset(new abs_type[NM]());
+        no_pre[t]=thread_no_pre[t].get();
+      }
+    }
+    /* number of transitions per thread */
+    std::vector<abs_ptr_type> no_trans(no_threads,0);
+    /* the input values, the same for all cells */
+    std::vector<input_type> input_values(M);
+    m_input_alphabet.itox_batch(0,M,input_values.data());
+
     /*
      * first loop: compute corner_IDs:
      * corner_IDs[i*M+j][0] = lower-left cell index of over-approximation of attainable set 
      * corner_IDs[i*M+j][1] = upper-right cell index of over-approximation of attainable set 
      */
-    /* loop over all cells */
-    for(abs_type i=0; i<N; i++) {
-      /* is i an element of the avoid symbols ? */
-      if(avoid(i)) {
-        for(abs_type j=0; j<M; j++) {
-          out_of_domain[i*M+j]=true;
-        }
-        continue;
-      }
-      /* loop over all inputs */
-      for(abs_type j=0; j<M; j++) {
-        out_of_domain[i*M+j]=false;
-        /* get center x of cell */
-        m_state_alphabet.itox(i,x);
-        /* cell radius (including measurement errors) */
-        for(int k=0; k<dim; k++)
-          r[k]=eta[k]/2.0+m_z[k];
-        /* current input */
-        m_input_alphabet.itox(j,u);
+    run_threads(no_threads, [&](const int t) {
+      /* for display purpose */
+      abs_type counter=0;
+      /* variables for managing the post */
+      std::vector<abs_type> lb(dim);  /* lower-left corner */
+      std::vector<abs_type> ub(dim);  /* upper-right corner */
+      std::vector<abs_type> no(dim);  /* number of cells per dim */
+      std::vector<abs_type> cc(dim);  /* coordinate of current cell in the post */
+      /* the pairs (cell, input) waiting for their post, their centers and radii */
+      const int lanes=P::lanes;
+      std::vector<abs_type> cell(lanes), input(lanes);
+      std::vector<state_type> x(lanes), r(lanes);
+      std::vector<input_type> u(lanes);
+      int no_pairs=0;
+      /* the centers of the cells of the thread, computed a block of cells at a time */
+      const abs_type block=1024;
+      std::vector<state_type> centers(block);
+      /* integrate the waiting pairs and count their transitions */
+      auto add_posts = [&]() {
         /* integrate system and radius growth bound */
         /* the result is stored in x and r */
-        radius_post(r,x,u);
-        system_post(x,u);
-        /* determine the cells which intersect with the attainable set: 
-         * discrete hyper interval of cell indices 
-         * [lb[0]; ub[0]] x .... x [lb[dim-1]; ub[dim-1]]
-         * covers attainable set 
-         */
-        abs_type npost=1;
-        for(int k=0; k<dim; k++) {
-          /* check for out of bounds */
-          double left = x[k]-r[k]-m_z[k];
-          double right = x[k]+r[k]+m_z[k];
-          if(left <= lower_left[k]-eta[k]/2.0  || right >= upper_right[k]+eta[k]/2.0)  {
-            out_of_domain[i*M+j]=true;
-            break;
-          } 
+        post(x.data(),r.data(),u.data(),no_pairs);
+        for(int p=0; p<no_pairs; p++) {
+          const abs_type i=cell[p], j=input[p];
+          /* determine the cells which intersect with the attainable set: 
+           * discrete hyper interval of cell indices 
+           * [lb[0]; ub[0]] x .... x [lb[dim-1]; ub[dim-1]]
+           * covers attainable set 
+           */
+          abs_type npost=1;
+          for(int k=0; k<dim; k++) {
+            /* check for out of bounds */
+            double left = x[p][k]-r[p][k]-m_z[k];
+            double right = x[p][k]+r[p][k]+m_z[k];
+            if(left <= lower_left[k]-eta[k]/2.0  || right >= upper_right[k]+eta[k]/2.0)  {
+              out_of_domain[i*M+j]=true;
+              break;
+            } 
 
-          /* integer coordinate of lower left corner of post */
-          lb[k] = static_cast<abs_type>((left-lower_left[k]+eta[k]/2.0)/eta[k]);
-          /* integer coordinate of upper right corner of post */
-          ub[k] = static_cast<abs_type>((right-lower_left[k]+eta[k]/2.0)/eta[k]);
-          /* number of grid points in the post in each dimension */
-          no[k]=(ub[k]-lb[k]+1);
-          /* total number of post */
-          npost*=no[k];
-          cc[k]=0;
-        }
-        corner_IDs[i*(2*M)+2*j]=0;
-        corner_IDs[i*(2*M)+2*j+1]=0;
-        if(out_of_domain[i*M+j]) 
-          continue;
+            /* integer coordinate of lower left corner of post */
+            lb[k] = static_cast<abs_type>((left-lower_left[k]+eta[k]/2.0)/eta[k]);
+            /* integer coordinate of upper right corner of post */
+            ub[k] = static_cast<abs_type>((right-lower_left[k]+eta[k]/2.0)/eta[k]);
+            /* number of grid points in the post in each dimension */
+            no[k]=(ub[k]-lb[k]+1);
+            /* total number of post */
+            npost*=no[k];
+            cc[k]=0;
+          }
+          corner_IDs[i*(2*M)+2*j]=0;
+          corner_IDs[i*(2*M)+2*j+1]=0;
+          if(out_of_domain[i*M+j]) 
+            continue;
 
-        /* compute indices of post */
-        for(abs_type k=0; k<npost; k++) {
-          abs_type q=0;
-          for(int l=0; l<dim; l++) 
-            q+=(lb[l]+cc[l])*NN[l];
-          cc[0]++;
-          for(int l=0; l<dim-1; l++) {
-            if(cc[l]==no[l]) {
-              cc[l]=0;
-              cc[l+1]++;
+          /* compute indices of post */
+          for(abs_type k=0; k<npost; k++) {
+            abs_type q=0;
+            for(int l=0; l<dim; l++) 
+              q+=(lb[l]+cc[l])*NN[l];
+            cc[0]++;
+            for(int l=0; l<dim-1; l++) {
+              if(cc[l]==no[l]) {
+                cc[l]=0;
+                cc[l+1]++;
+              }
             }
+            /* (i,j,q) is a transition */    
+            /* increment number of pres for (q,j) */ 
+            no_pre[t][q*M+j]++;
+            /* store id's of lower-left and upper-right cell */
+            if(k==0)
+              corner_IDs[i*(2*M)+2*j]=q;
+            if(k==npost-1)
+              corner_IDs[i*(2*M)+2*j+1]=q;
+          }
+          /* increment number of transitions by number of post */
+          no_trans[t]+=npost;
+          transition_function.m_no_post[i*M+j]=npost;
+        }
+        no_pairs=0;
+      };
+      /* loop over the cells of the thread */
+      const abs_type begin=first_cell(t), end=first_cell(t+1);
+      for(abs_type i=begin; i<end; i++) {
+        if((i-begin)%block==0)
+          m_state_alphabet.itox_batch(i,std::min(block,end-i),centers.data());
+        /* is i an element of the avoid symbols ? */
+        if(avoid(i)) {
+          for(abs_type j=0; j<M; j++) {
+            out_of_domain[i*M+j]=true;
+          }
+          continue;
+        }
+        /* loop over all inputs */
+        for(abs_type j=0; j<M; j++) {
+          out_of_domain[i*M+j]=false;
+          cell[no_pairs]=i;
+          input[no_pairs]=j;
+          /* get center x of cell */
+          x[no_pairs]=centers[(i-begin)%block];
+          /* cell radius (including measurement errors) */
+          for(int k=0; k<dim; k++)
+            r[no_pairs][k]=eta[k]/2.0+m_z[k];
+          /* current input */
+          u[no_pairs]=input_values[j];
+          if(++no_pairs==lanes)
+            add_posts();
+        }
+        /* print progress of the first thread */
+        if(t==0) {
+          if(m_verbose) {
+            if(counter==0)
+              std::cout << "1st loop: ";
           }
-          /* (i,j,q) is a transition */    
-          /* increment number of pres for (q,j) */ 
-          transition_function.m_no_pre[q*M+j]++;
-          /* store id's of lower-left and upper-right cell */
-          if(k==0)
-            corner_IDs[i*(2*M)+2*j]=q;
-          if(k==npost-1)
-            corner_IDs[i*(2*M)+2*j+1]=q;
+          progress(i-begin,end-begin,counter);
         }
-        /* increment number of transitions by number of post */
-        T+=npost;
-        transition_function.m_no_post[i*M+j]=npost;
       }
-      /* print progress */
-      if(m_verbose) {
-        if(counter==0)
-          std::cout << "1st loop: ";
+      if(no_pairs)
+        add_posts();
+    });
+
+    /* 
+     * compute m_no_pre and pre_ptr: every thread sums a range of (q,j) and the
+     * range sums are accumulated to the offsets of the ranges
+     */
+    auto first_pair = [NM,no_threads](const int t) {
+      return NM*t/no_threads;
+    };
+    std::vector<abs_ptr_type> range_sum(no_threads+1,0);
+    run_threads(no_threads, [&](const int t) {
+      for(abs_ptr_type b=first_pair(t); b<first_pair(t+1); b++) {
+        if(no_threads>1) {
+          abs_type sum=0;
+          for(int s=0; s<no_threads; s++)
+            sum+=no_pre[s][b];
+          transition_function.m_no_pre[b]=sum;
+        }
+        range_sum[t+1]+=transition_function.m_no_pre[b];
       }
-      progress(i,N,counter);
-    }
-    /* compute pre_ptr */
-    abs_ptr_type sum=0;
-    for(abs_type i=0; i<N; i++) {
-      for(abs_type j=0; j<M; j++) {
-        sum+=transition_function.m_no_pre[i*M+j];
-        transition_function.m_pre_ptr[i*M+j]=sum;
+    });
+    for(int t=0; t<no_threads; t++)
+      range_sum[t+1]+=range_sum[t];
+    run_threads(no_threads, [&](const int t) {
+      abs_ptr_type sum=range_sum[t];
+      for(abs_ptr_type b=first_pair(t); b<first_pair(t+1); b++) {
+        if(no_threads>1) {
+          /* the pres of (q,j) start at m_pre_ptr, the last thread takes the first
+           * part, no_pre becomes the end of the part of each thread */
+          transition_function.m_pre_ptr[b]=sum;
+          abs_type end=0;
+          for(int s=no_threads-1; s>=0; s--) {
+            end+=no_pre[s][b];
+            no_pre[s][b]=end;
+          }
+          sum+=transition_function.m_no_pre[b];
+        } else {
+          /* a single thread moves m_pre_ptr from the end to the start */
+          sum+=transition_function.m_no_pre[b];
+          transition_function.m_pre_ptr[b]=sum;
+        }
       }
-    }
+    });
     /* allocate memory for pre list */
+    abs_ptr_type T=0;
+    for(int t=0; t<no_threads; t++)
+      T+=no_trans[t];
     transition_function.init_transitions(T);
 
     /* second loop: fill pre array */
-    counter=0;
-    for(abs_type i=0; i<N; i++) {
-      /* loop over all inputs */
-      for(abs_type j=0; j<M; j++) {
-      /* is x an element of the overflow symbols ? */
-        if(out_of_domain[i*M+j]) 
-          continue;
-        /* extract lower-left and upper-bound points */
-        abs_type k_lb=corner_IDs[i*2*M+2*j];
-        abs_type k_ub=corner_IDs[i*2*M+2*j+1];
-        abs_type npost=1;
+    run_threads(no_threads, [&](const int t) {
+      /* for display purpose */
+      abs_type counter=0;
+      /* variables for managing the post */
+      std::vector<abs_type> lb(dim);  /* lower-left corner */
+      std::vector<abs_type> ub(dim);  /* upper-right corner */
+      std::vector<abs_type> no(dim);  /* number of cells per dim */
+      std::vector<abs_type> cc(dim);  /* coordinate of current cell in the post */
+      const abs_type begin=first_cell(t), end=first_cell(t+1);
+      for(abs_type i=begin; i<end; i++) {
+        /* loop over all inputs */
+        for(abs_type j=0; j<M; j++) {
+        /* is x an element of the overflow symbols ? */
+          if(out_of_domain[i*M+j]) 
+            continue;
+          /* extract lower-left and upper-bound points */
+          abs_type k_lb=corner_IDs[i*2*M+2*j];
+          abs_type k_ub=corner_IDs[i*2*M+2*j+1];
+          abs_type npost=1;
 
-        /* cell idx to coordinates */
-        for(int k=dim-1; k>=0; k--) {
-          /* integer coordinate of lower left corner */
-          lb[k]=k_lb/NN[k];
-          k_lb=k_lb-lb[k]*NN[k];
-          /* integer coordinate of upper right corner */
-          ub[k]=k_ub/NN[k];
-          k_ub=k_ub-ub[k]*NN[k];
-          /* number of grid points in each dimension in the post */
-          no[k]=(ub[k]-lb[k]+1);
-          /* total no of post of (i,j) */
-          npost*=no[k];
-          cc[k]=0;
+          /* cell idx to coordinates */
+          for(int k=dim-1; k>=0; k--) {
+            /* integer coordinate of lower left corner */
+            lb[k]=k_lb/NN[k];
+            k_lb=k_lb-lb[k]*NN[k];
+            /* integer coordinate of upper right corner */
+            ub[k]=k_ub/NN[k];
+            k_ub=k_ub-ub[k]*NN[k];
+            /* number of grid points in each dimension in the post */
+            no[k]=(ub[k]-lb[k]+1);
+            /* total no of post of (i,j) */
+            npost*=no[k];
+            cc[k]=0;
 
-        }
+          }
 
-        for(abs_type k=0; k<npost; k++) {
-          abs_type q=0;
-          for(int l=0; l<dim; l++) 
-            q+=(lb[l]+cc[l])*NN[l];
-          cc[0]++;
-          for(int l=0; l<dim-1; l++) {
-            if(cc[l]==no[l]) {
-              cc[l]=0;
-              cc[l+1]++;
+          for(abs_type k=0; k<npost; k++) {
+            abs_type q=0;
+            for(int l=0; l<dim; l++) 
+              q+=(lb[l]+cc[l])*NN[l];
+            cc[0]++;
+            for(int l=0; l<dim-1; l++) {
+              if(cc[l]==no[l]) {
+                cc[l]=0;
+                cc[l+1]++;
+              }
             }
+            /* (i,j,q) is a transition */
+            if(no_threads>1)
+              transition_function.m_pre[transition_function.m_pre_ptr[q*M+j]+(--no_pre[t][q*M+j])]=i;
+            else
+              transition_function.m_pre[--transition_function.m_pre_ptr[q*M+j]]=i;
           }
-          /* (i,j,q) is a transition */
-          transition_function.m_pre[--transition_function.m_pre_ptr[q*M+j]]=i;
+        }
+        /* print progress of the first thread */
+        if(t==0) {
+          if(m_verbose) {
+            if(counter==0)
+              std::cout << "2nd loop: ";
+          }
+          progress(i-begin,end-begin,counter);
         }
       }
-      /* print progress */
-      if(m_verbose) {
-        if(counter==0)
-          std::cout << "2nd loop: ";
-      }
-      progress(i,N,counter);
-    }
+    });
   }
- 
+
+public:
   /** @brief get the center of cells that are used to over-approximated the
    *  attainable set associated with cell (with center x) and input u
    *
@@ -476,6 +614,18 @@ public:
     }
     return z;
   }
+  /** @brief set the number of threads used by compute_gb, e.g. default_no_threads()
+   *
+   * With more than one thread the posts and avoid must be thread safe and
+   * every thread besides the first needs N*M abs_type more memory
+   **/
+  void set_no_threads(const int no_threads) {
+    m_no_threads=std::max(1, no_threads);
+  }
+  /** @brief get the number of threads used by compute_gb **/
+  int get_no_threads() const {
+    return m_no_threads;
+  }
   /** @brief activate console output **/
   void verbose_on() {
     m_verbose=true;
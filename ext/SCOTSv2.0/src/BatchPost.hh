@@ -0,0 +1,109 @@
+/*
+ * BatchPost.hh
+ *
+ *  created: Oct 2026
+ *   author: Antonio Rueda
+ *
+ */
+
+/** @file **/
+
+#ifndef BATCHPOST_HH_
+#define BATCHPOST_HH_
+
+#include <array>
+#include <tuple>
+
+/** @namespace scots **/
+namespace scots {
+
+/**
+ * @brief LANES points of type point_type (a std::array) as structure of arrays
+ *
+ * b[k][l] is coordinate k of point l, so that a loop over the lanes of a
+ * coordinate runs over contiguous doubles and can be vectorized.
+ **/
+template<class point_type, int LANES>
+using point_batch = std::array<std::array<double,LANES>,std::tuple_size<point_type>::value>;
+
+/**
+ * @brief the posts of compute_gb for the lambda expressions system_post and radius_post
+ *
+ * The scalar fallback, the lambda expressions are called for each (cell, input) pair.
+ **/
+template<class state_type, class input_type, class F1, class F2>
+class ScalarPost {
+private:
+  F1& m_system_post;
+  F2& m_radius_post;
+public:
+  /* number of (cell, input) pairs of one call */
+  static constexpr int lanes=1;
+
+  ScalarPost(F1& system_post, F2& radius_post) :
+             m_system_post(system_post), m_radius_post(radius_post) {}
+
+  /** @brief integrates the n pairs (x[l],u[l]) and the radius r[l] of their cells **/
+  void operator()(state_type* x, state_type* r, const input_type* u, int n) const {
+    for(int l=0; l<n; l++) {
+      m_radius_post(r[l],x[l],u[l]);
+      m_system_post(x[l],u[l]);
+    }
+  }
+};
+
+/**
+ * @brief the posts of compute_gb for lambda expressions over LANES pairs at a time
+ *
+ * system_post and radius_post take point_batch arguments
+ * \verbatim [] (point_batch<state_type,LANES> &x, const point_batch<input_type,LANES> &u) ->  void  \endverbatim
+ * \verbatim [] (point_batch<state_type,LANES> &r, const point_batch<state_type,LANES> &x, const point_batch<input_type,LANES> &u) ->  void  \endverbatim
+ * and compute the same as the lambda expressions of compute_gb, lane by lane.
+ * With runge_kutta_fixed4_batch the ODE of all lanes is integrated at once.
+ * Unused lanes of the last call repeat the first pair.
+ **/
+template<class state_type, class input_type, int LANES, class F1, class F2>
+class BatchPost {
+private:
+  F1 m_system_post;
+  F2 m_radius_post;
+public:
+  /* number of (cell, input) pairs of one call */
+  static constexpr int lanes=LANES;
+
+  BatchPost(F1 system_post, F2 radius_post) :
+            m_system_post(system_post), m_radius_post(radius_post) {}
+
+  /** @brief integrates the n<=LANES pairs (x[l],u[l]) and the radius r[l] of their cells **/
+  void operator()(state_type* x, state_type* r, const input_type* u, int n) const {
+    point_batch<state_type,LANES> xb, rb;
+    point_batch<input_type,LANES> ub;
+    for(int l=0; l<LANES; l++) {
+      int p = (l<n) ? l : 0;
+      for(size_t k=0; k<xb.size(); k++) {
+        xb[k][l]=x[p][k];
+        rb[k][l]=r[p][k];
+      }
+      for(size_t k=0; k<ub.size(); k++)
+        ub[k][l]=u[p][k];
+    }
+    m_radius_post(rb,xb,ub);
+    m_system_post(xb,ub);
+    for(int l=0; l<n; l++) {
+      for(size_t k=0; k<xb.size(); k++) {
+        x[l][k]=xb[k][l];
+        r[l][k]=rb[k][l];
+      }
+    }
+  }
+};
+
+/** @brief BatchPost of the batched lambda expressions system_post and radius_post **/
+template<int LANES, class state_type, class input_type, class F1, class F2>
+BatchPost<state_type,input_type,LANES,F1,F2> make_batch_post(F1 system_post, F2 radius_post) {
+  return BatchPost<state_type,input_type,LANES,F1,F2>(system_post,radius_post);
+}
+
+} /* close namespace */
+
+#endif /* BATCHPOST_HH_ */
@@ -0,0 +1,218 @@
+/*
+ * CubeRange.hh
+ *
+ *  created: Oct 2026
+ *   author: Antonio Rueda
+ *
+ */
+
+/** @file **/
+
+#ifndef CUBERANGE_HH_
+#define CUBERANGE_HH_
+
+#include <vector>
+#include <utility>
+
+#include "UniformGrid.hh"
+
+/* cudd library */
+#include "cuddObj.hh"
+
+/** @namespace scots **/
+namespace scots {
+
+/**
+ * @brief a cube of a BDD over the variables of a SymbolicSet
+ *
+ * In dimension i the cube holds the integer coordinates base()[i] | s of every
+ * s that only has bits in mask()[i], the don't care bits of the cube. The grid
+ * points of the cube are enumerated on demand in the order of
+ * SymbolicSet::bdd_to_grid_points.
+ **/
+class GridCube {
+private:
+  friend class CubeRange;
+  /* integer coordinates with the don't care bits zero */
+  std::vector<abs_type> m_base{};
+  /* don't care bits of each dimension */
+  std::vector<abs_type> m_mask{};
+  /* the don't care bits as (dimension, bit) in the order of the BDD variables */
+  std::vector<std::pair<int,abs_type>> m_free{};
+  /* m_NN of the grid */
+  const abs_type* m_NN=nullptr;
+
+  /* call f(coordinates,id) for every assignment of the don't care bits, the
+   * first one in m_free toggling fastest */
+  template<class F>
+  void enumerate(F&& f) const {
+    std::vector<abs_type> x(m_base);
+    abs_type id=0;
+    for(size_t i=0; i<x.size(); i++)
+      id+=x[i]*m_NN[i];
+    while(true) {
+      f(x,id);
+      /* binary counter over the don't care bits */
+      size_t t=0;
+      for(; t<m_free.size(); t++) {
+        const int i=m_free[t].first;
+        const abs_type bit=m_free[t].second;
+        x[i]^=bit;
+        if(x[i]&bit) {
+          id+=bit*m_NN[i];
+          break;
+        }
+        id-=bit*m_NN[i];
+      }
+      if(t==m_free.size())
+        return;
+    }
+  }
+public:
+  /** @brief integer coordinates of the cube with the don't care bits zero **/
+  const std::vector<abs_type>& base() const { return m_base; }
+  /** @brief the don't care bits of the integer coordinates **/
+  const std::vector<abs_type>& mask() const { return m_mask; }
+  /** @brief number of grid points in the cube **/
+  abs_type size() const { return abs_type{1}<<m_free.size(); }
+
+  /** @brief call f(const std::vector<abs_type>& x) for the integer coordinates x of the grid points **/
+  template<class F>
+  void for_each_coordinates(F&& f) const {
+    enumerate([&f](const std::vector<abs_type>& x, abs_type) { f(x); });
+  }
+
+  /** @brief call f(abs_type id) for the ids of the grid points **/
+  template<class F>
+  void for_each_id(F&& f) const {
+    enumerate([&f](const std::vector<abs_type>&, abs_type id) { f(id); });
+  }
+};
+
+/**
+ * @brief single pass range over the cubes of a BDD of a SymbolicSet
+ *
+ * The range owns the CUDD cube generator, so the cubes are produced one by one
+ * and the memory does not depend on the number of grid points of the BDD.
+ * Dynamic reordering is disabled while the range lives. Obtain it with
+ * SymbolicSet::cubes:
+ * \verbatim for(const GridCube& c : set.cubes(manager,bdd)) c.for_each_id(...); \endverbatim
+ **/
+class CubeRange {
+private:
+  const Cudd* m_manager=nullptr;
+  /* the BDD iterated over, referenced while the generator lives */
+  BDD m_bdd{};
+  DdGen* m_gen=nullptr;
+  int* m_cube=nullptr;
+  bool m_done=true;
+  bool m_reordering=false;
+  /* BDD variable ids of each dimension, most significant bit first */
+  std::vector<std::vector<unsigned int>> m_var_ids{};
+  std::vector<abs_type> m_NN{};
+  GridCube m_current{};
+
+  /* decode m_cube into m_current */
+  void decode() {
+    m_current.m_free.clear();
+    for(size_t i=0; i<m_var_ids.size(); i++) {
+      const size_t no_vars=m_var_ids[i].size();
+      m_current.m_base[i]=0;
+      m_current.m_mask[i]=0;
+      for(size_t j=0; j<no_vars; j++) {
+        const abs_type bit=abs_type{1}<<(no_vars-1-j);
+        const int v=m_cube[m_var_ids[i][j]];
+        if(v==1)
+          m_current.m_base[i]|=bit;
+        if(v==2) {
+          m_current.m_mask[i]|=bit;
+          m_current.m_free.emplace_back(static_cast<int>(i),bit);
+        }
+      }
+    }
+  }
+
+  void next() {
+    CUDD_VALUE_TYPE value;
+    m_done = !Cudd_NextCube(m_gen,&m_cube,&value);
+    if(!m_done)
+      decode();
+  }
+public:
+  /** @brief input iterator over the cubes **/
+  class iterator {
+  private:
+    CubeRange* m_range;
+  public:
+    explicit iterator(CubeRange* range) : m_range(range) {}
+    const GridCube& operator*() const { return m_range->m_current; }
+    const GridCube* operator->() const { return &m_range->m_current; }
+    iterator& operator++() {
+      m_range->next();
+      if(m_range->m_done)
+        m_range=nullptr;
+      return *this;
+    }
+    bool operator==(const iterator& other) const { return m_range==other.m_range; }
+    bool operator!=(const iterator& other) const { return m_range!=other.m_range; }
+  };
+
+  /** @brief empty range **/
+  CubeRange() = default;
+
+  /**
+   * @brief range over the cubes of bdd
+   *
+   * @param manager - the Cudd manager
+   * @param bdd     - BDD over the variables in var_ids only
+   * @param var_ids - the BDD variable ids of each dimension, most significant bit first
+   * @param NN      - m_NN of the grid, to compute the ids
+   **/
+  CubeRange(const Cudd& manager, const BDD& bdd,
+            std::vector<std::vector<unsigned int>> var_ids,
+            std::vector<abs_type> NN) :
+            m_manager(&manager), m_bdd(bdd),
+            m_var_ids(std::move(var_ids)), m_NN(std::move(NN)) {
+    /* disable reordering (if enabled) */
+    m_reordering = manager.ReorderingStatus(nullptr);
+    if(m_reordering)
+      manager.AutodynDisable();
+    m_current.m_base.resize(m_var_ids.size());
+    m_current.m_mask.resize(m_var_ids.size());
+    m_current.m_NN=m_NN.data();
+    CUDD_VALUE_TYPE value;
+    m_gen = Cudd_FirstCube(manager.getManager(),m_bdd.getNode(),&m_cube,&value);
+    m_done = (m_gen==nullptr) || Cudd_IsGenEmpty(m_gen);
+    if(!m_done)
+      decode();
+  }
+
+  CubeRange(const CubeRange&) = delete;
+  CubeRange& operator=(const CubeRange&) = delete;
+
+  CubeRange(CubeRange&& other) :
+            m_manager(other.m_manager), m_bdd(other.m_bdd), m_gen(other.m_gen),
+            m_cube(other.m_cube), m_done(other.m_done), m_reordering(other.m_reordering),
+            m_var_ids(std::move(other.m_var_ids)), m_NN(std::move(other.m_NN)),
+            m_current(std::move(other.m_current)) {
+    m_current.m_NN=m_NN.data();
+    other.m_gen=nullptr;
+    other.m_done=true;
+    other.m_reordering=false;
+  }
+
+  ~CubeRange() {
+    if(m_gen)
+      Cudd_GenFree(m_gen);
+    /* reactivate reordering if it was enabled */
+    if(m_reordering)
+      m_manager->AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
+  }
+
+  iterator begin() { return iterator(m_done ? nullptr : this); }
+  iterator end() { return iterator(nullptr); }
+};
+
+} /* close namespace */
+
+#endif /* CUBERANGE_HH_ */
@@ -34,6 +34,7 @@ class EnfPre {
 private:
   /* stores the permutation array used to swap pre with post variables */
   std::unique_ptr<int[]> m_permute;
+  size_t m_no_vars;
   /* transition relation */
   BDD m_tr;  
   /* transition relation with m_cube_post abstracted */
@@ -55,6 +56,7 @@ public:
          const SymbolicModel<state_type,input_type>& model) : m_tr(transition_relation) {
     /* the permutation array */
     size_t size = manager.ReadSize();
+    m_no_vars = size;
     m_permute = std::unique_ptr<int[]>(new int[size]);
     std::iota(m_permute.get(),m_permute.get()+size,0);
     auto pre_ids = model.get_sym_set_pre().get_bdd_var_ids();
@@ -68,6 +70,17 @@ public:
     /* copy the transition relation */
     m_tr_nopost=m_tr.ExistAbstract(m_cube_post);
   }
+  /** @brief initialize the enforcable predecessor restricted to the states in S
+   *
+   * The result of operator() is the one of other intersected with S, at the
+   * cost of the transitions of the states in S only
+   **/
+  EnfPre(const EnfPre& other, const BDD& S) :
+    m_permute(new int[other.m_no_vars]), m_no_vars(other.m_no_vars),
+    m_tr(other.m_tr & S), m_tr_nopost(other.m_tr_nopost & S),
+    m_cube_post(other.m_cube_post), m_cube_input(other.m_cube_input) {
+    std::copy(other.m_permute.get(),other.m_permute.get()+m_no_vars,m_permute.get());
+  }
   /** @brief computes the enforcable predecessor of the BDD Z **/
   BDD operator()(BDD Z) const {
     /* project onto state alphabet */
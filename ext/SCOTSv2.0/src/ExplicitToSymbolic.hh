@@ -0,0 +1,159 @@
+/*
+ * ExplicitToSymbolic.hh
+ *
+ *  created: Oct 2026
+ *   author: Antonio Rueda
+ *
+ */
+
+/** @file **/
+
+#ifndef EXPLICITTOSYMBOLIC_HH_
+#define EXPLICITTOSYMBOLIC_HH_
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cuddObj.hh"
+
+#include "WinningDomain.hh"
+#include "SymbolicSet.hh"
+
+/** @namespace scots **/ 
+namespace scots {
+
+/**
+ * @brief BDD of the state-input pairs (i,j) of a WinningDomain, where j is a valid input at i
+ *
+ * The result is a BDD over the variables of ss and is and can be written with
+ * the SymbolicSet(ss,is) as a controller, like the ones of the BDD based
+ * engine (SymbolicModel and EnfPre). This way a controller of the explicit
+ * engine (Abstraction and solve_*_game) can be determinized and implemented
+ * with the same tools.
+ *
+ * The pairs are visited in the order of their minterms, the first variable of
+ * the first state dimension being the most significant bit, and the BDD is
+ * built bottom up from that sorted sequence: a node is created once all the
+ * minterms below it are known. Every minterm costs at most one node per BDD
+ * variable, instead of a conjunction and a disjunction with the whole result
+ * for every pair.
+ *
+ * @param manager - the Cudd manager of ss and is
+ * @param ss      - SymbolicSet of the state space, with the grid of the WinningDomain
+ * @param is      - SymbolicSet of the input space, with the grid of the WinningDomain
+ * @param wd      - the WinningDomain
+ *
+ * The BDD variables of ss need to precede the ones of is in the variable
+ * order, each dimension in turn, which is the case for SymbolicSets created
+ * in this order with a new Cudd manager.
+ **/
+inline
+BDD winning_domain_to_bdd(const Cudd& manager,
+                          const SymbolicSet& ss,
+                          const SymbolicSet& is,
+                          const WinningDomain& wd) {
+  if(wd.get_no_states()!=ss.size() || wd.get_no_inputs()!=is.size()) {
+    throw std::runtime_error("\nscots::winning_domain_to_bdd: the grids do not match the WinningDomain.");
+  }
+  int sdim=ss.get_dim();
+  int idim=is.get_dim();
+  /* BDD variables in the order of the minterm bits and the bits of each dimension */
+  std::vector<BDD> vars;
+  std::vector<int> no_bits;
+  for(const auto& interval : ss.get_bdd_intervals()) {
+    std::vector<BDD> v=interval.get_bdd_vars();
+    vars.insert(vars.end(),v.begin(),v.end());
+    no_bits.push_back(v.size());
+  }
+  for(const auto& interval : is.get_bdd_intervals()) {
+    std::vector<BDD> v=interval.get_bdd_vars();
+    vars.insert(vars.end(),v.begin(),v.end());
+    no_bits.push_back(v.size());
+  }
+  int n=vars.size();
+  for(int l=1; l<n; l++) {
+    if(manager.ReadPerm(vars[l].NodeReadIndex())<=manager.ReadPerm(vars[l-1].NodeReadIndex()))
+      throw std::runtime_error("\nscots::winning_domain_to_bdd: the BDD variables of the state and input space are not in order.");
+  }
+  std::vector<abs_type> snn=ss.get_nn();
+  std::vector<abs_type> inn=is.get_nn();
+  std::vector<abs_type> sgp=ss.get_no_gp_per_dim();
+
+  const BDD one=manager.bddOne();
+  const BDD zero=manager.bddZero();
+  /* minterm bits of the previous pair and the current one */
+  std::vector<int> prev(n,0), bits(n,0);
+  /* els[l]: the finished else child at level l of the previous minterm */
+  std::vector<BDD> els(n,zero);
+  bool first=true;
+  /* finish the levels below p of the previous minterm and return their BDD */
+  auto close = [&](int p) {
+    BDD f=one;
+    for(int l=n-1; l>p; l--) {
+      f = prev[l] ? vars[l].Ite(f,els[l]) : vars[l].Ite(zero,f);
+      els[l]=zero;
+    }
+    return f;
+  };
+  /* add the minterm in bits, which is greater than the previous one */
+  auto add = [&]() {
+    if(first) {
+      prev=bits;
+      first=false;
+      return;
+    }
+    int p=0;
+    while(p<n && bits[p]==prev[p])
+      p++;
+    if(p==n)
+      return;
+    els[p]=close(p);
+    prev=bits;
+  };
+  /* writes the bits of the coordinates c of dimension d on to the minterm */
+  auto set_bits = [&](const std::vector<abs_type>& c, int d0, int l) {
+    for(size_t d=0; d<c.size(); d++) {
+      for(int b=no_bits[d0+d]-1; b>=0; b--)
+        bits[l++]=(c[d]>>b)&1;
+    }
+    return l;
+  };
+
+  /* states in the order of their coordinates, the last dimension changing fastest */
+  std::vector<abs_type> c(sdim,0), u(idim,0);
+  std::vector<std::vector<abs_type>> inputs;
+  for(abs_type k=0; k<ss.size(); k++) {
+    abs_type i=0;
+    for(int d=0; d<sdim; d++)
+      i+=c[d]*snn[d];
+    if(wd.is_winning(i)) {
+      int l=set_bits(c,0,0);
+      /* inputs in the order of their coordinates */
+      inputs.clear();
+      for(abs_type j : wd.get_inputs(i)) {
+        for(int d=idim-1; d>=0; d--) {
+          u[d]=j/inn[d];
+          j=j%inn[d];
+        }
+        inputs.push_back(u);
+      }
+      std::sort(inputs.begin(),inputs.end());
+      for(const auto& v : inputs) {
+        set_bits(v,sdim,l);
+        add();
+      }
+    }
+    for(int d=sdim-1; d>=0; d--) {
+      if(++c[d]<sgp[d])
+        break;
+      c[d]=0;
+    }
+  }
+  if(first)
+    return zero;
+  return close(-1);
+}
+
+} /* close namespace */
+#endif /* EXPLICITTOSYMBOLIC_HH_ */
@@ -15,6 +15,8 @@
 #include <string>
 #include <vector>
 #include <climits>
+#include <limits>
+#include <stdexcept>
 #include <iomanip>
 
 #ifdef SCOTS_BDD
@@ -193,6 +195,35 @@ public:
       manager.AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
     }
 
+    return true;
+  }
+  /* several BDDs in one file, their shared nodes are written once */
+  bool add_BDD_array(const Cudd& manager, const std::vector<BDD>& bdds, char mode='B') {
+    /* disable reordering (if enabled) */
+    const bool is_reordering = manager.ReorderingStatus(nullptr);
+    if(is_reordering){
+      manager.AutodynDisable();
+    }
+    /* open filename */
+    std::string filename = m_filename.append(SCOTS_FH_BDD_EXTENSION);
+    FILE *file = fopen (filename.c_str(),"w");
+    if(!file)
+      return false;
+    std::vector<DdNode*> nodes;
+    for(const auto& bdd : bdds)
+      nodes.push_back(bdd.getNode());
+    int store = Dddmp_cuddBddArrayStore(manager.getManager(),NULL,
+                                        (int)nodes.size(),nodes.data(),NULL,NULL,NULL,
+                                        (int)mode,DDDMP_VARIDS,NULL,file);
+    if(fclose(file))
+      return false;
+    if (store!=DDDMP_SUCCESS)  
+      return false;
+    /* reactivate reordering if it was enabled */
+    if(is_reordering){
+      manager.AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
+    }
+
     return true;
   }
 #endif
@@ -459,20 +490,75 @@ public:
     if(!file)
       return false;
 
+    /* dddmp does not handle failing node allocations, so lift the hard
+     * memory limit of the manager while loading and check it afterwards */
+    size_t max_memory = manager.SetMaxMemory(std::numeric_limits<size_t>::max());
     DdNode *node =
     Dddmp_cuddBddLoad(manager.getManager(),
                       DDDMP_VAR_MATCHIDS,NULL,NULL,
                       NULL,(int)mode,NULL,file);
     fclose(file);
+    manager.SetMaxMemory(max_memory);
     if(!node)
       return false;
-            
+    if(manager.ReadMemoryInUse() > max_memory) {
+      Cudd_RecursiveDeref(manager.getManager(),node);
+      std::ostringstream os;
+      os << "scots::FileReader: Loading " << filename << " needs " << manager.ReadMemoryInUse()
+         << " bytes, which exceeds the memory limit of " << max_memory << " bytes.";
+      throw std::runtime_error(os.str().c_str());
+    }
+
     bdd=BDD(manager,node);
     /* reactivate reordering if it was enabled */
     if(is_reordering){
       manager.AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
     }
 
+    return true;
+  }
+  bool get_BDD_array(const Cudd& manager, std::vector<BDD>& bdds, char mode='B') {
+    /* disable reordering (if enabled) */
+    const bool is_reordering = manager.ReorderingStatus(nullptr);
+    if(is_reordering){
+      manager.AutodynDisable();
+    }
+
+    /* open file1name */
+    std::string filename = m_filename.append(SCOTS_FH_BDD_EXTENSION);
+    FILE *file = fopen(filename.c_str(),"r");
+    if(!file)
+      return false;
+
+    /* see get_BDD for the memory limit */
+    size_t max_memory = manager.SetMaxMemory(std::numeric_limits<size_t>::max());
+    DdNode **roots = nullptr;
+    int no_roots =
+    Dddmp_cuddBddArrayLoad(manager.getManager(),
+                           DDDMP_ROOT_MATCHLIST,NULL,DDDMP_VAR_MATCHIDS,NULL,NULL,
+                           NULL,(int)mode,NULL,file,&roots);
+    fclose(file);
+    manager.SetMaxMemory(max_memory);
+    if(no_roots<=0 || !roots)
+      return false;
+    bdds.clear();
+    for(int i=0; i<no_roots; i++) {
+      bdds.push_back(BDD(manager,roots[i]));
+      Cudd_RecursiveDeref(manager.getManager(),roots[i]);
+    }
+    free(roots);
+    if(manager.ReadMemoryInUse() > max_memory) {
+      bdds.clear();
+      std::ostringstream os;
+      os << "scots::FileReader: Loading " << filename << " needs " << manager.ReadMemoryInUse()
+         << " bytes, which exceeds the memory limit of " << max_memory << " bytes.";
+      throw std::runtime_error(os.str().c_str());
+    }
+    /* reactivate reordering if it was enabled */
+    if(is_reordering){
+      manager.AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
+    }
+
     return true;
   }
 #endif
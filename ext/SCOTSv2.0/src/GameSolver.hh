@@ -17,10 +17,14 @@
 #include <queue>
 #include <memory>
 #include <utility>
+#include <atomic>
+#include <bitset>
+#include <limits>
 
 #include "UniformGrid.hh"
 #include "TransitionFunction.hh"
 #include "WinningDomain.hh"
+#include "Threads.hh"
 
 
 /** @namespace scots **/ 
@@ -29,7 +33,7 @@ namespace scots {
 /** @cond **/
 /* default parameters for the solve_reachability_game */
 namespace params {
-  auto avoid = [](const abs_type&) noexcept {return false;};
+  static auto avoid = [](const abs_type&) noexcept {return false;};
   static std::vector<double> value {};
 }
 /** @endcond **/
@@ -208,5 +212,326 @@ WinningDomain solve_invariance_game(const TransitionFunction& trans_function, F&
   return WinningDomain(N,M,std::move(no_val_in),std::move(valid_inputs),loosing);
 }
 
+/**
+ * @class EdgeIndex
+ *
+ * @brief numbers the state-input pairs (i,j) with at least one post
+ *
+ * The pairs with m_no_post[i*M+j]>0 (the edges) are numbered 0,...,E-1 in
+ * the order of i*M+j. The index keeps one bit per pair and one counter per 64
+ * pairs, so that data of the edges can be stored in arrays of size E instead
+ * of N*M.
+ **/
+class EdgeIndex {
+private:
+  /* bit i*M+j is set iff (i,j) is an edge */
+  std::vector<std::uint64_t> m_bits;
+  /* m_rank[w] = number of edges before the pairs of word w */
+  std::vector<abs_ptr_type> m_rank;
+  /* number of edges E */
+  abs_ptr_type m_no_edges;
+public:
+  /** @brief construct the index of the edges of trans_function **/
+  explicit EdgeIndex(const TransitionFunction& trans_function) : m_no_edges(0) {
+    abs_ptr_type NM=static_cast<abs_ptr_type>(trans_function.m_no_states)*trans_function.m_no_inputs;
+    m_bits.assign((NM+63)/64,0);
+    m_rank.assign(m_bits.size(),0);
+    for(abs_ptr_type p=0; p<NM; p++) {
+      if(trans_function.m_no_post[p])
+        m_bits[p/64]|=std::uint64_t(1)<<(p%64);
+    }
+    for(size_t w=0; w<m_bits.size(); w++) {
+      m_rank[w]=m_no_edges;
+      m_no_edges+=std::bitset<64>(m_bits[w]).count();
+    }
+  }
+  /** @brief number of edges E **/
+  abs_ptr_type size() const {
+    return m_no_edges;
+  }
+  /** @brief true iff the pair p=i*M+j is an edge **/
+  bool is_edge(const abs_ptr_type& p) const {
+    return (m_bits[p/64]>>(p%64))&1;
+  }
+  /** @brief number of the edge p=i*M+j, only meaningful if is_edge(p) **/
+  abs_ptr_type operator()(const abs_ptr_type& p) const {
+    std::uint64_t below=m_bits[p/64]&((std::uint64_t(1)<<(p%64))-1);
+    return m_rank[p/64]+std::bitset<64>(below).count();
+  }
+};
+
+/**
+ * @brief solve reachability game like solve_reachability_game without arrays of size N*M
+ *
+ * Instead of the arrays K and edge_val of size N*M, the number of unprocessed
+ * posts is kept only for the state-input pairs with at least one post (see
+ * EdgeIndex). The states are processed level by level, all states of a level
+ * have the same value, so the value of an edge is known when its last post is
+ * processed and no edge values are stored. 
+ *
+ * Each level is split among no_threads threads. Then avoid is called
+ * concurrently and needs to be thread safe. The value function is the same as
+ * the one of solve_reachability_game. Among the inputs that attain the value
+ * of a state the smallest one is taken, so the result does not depend on the
+ * number of threads (solve_reachability_game takes the first one found).
+ * 
+ * @param[in] trans_function - TransitionFunction of the symbolic model
+ * @param[in] target - lambda expression of the form
+ *                      \verbatim [] (const abs_type &i) -> bool \endverbatim 
+ *                      returns true if state i is in target set and false otherwise
+ *                       
+ * @param[in] avoid  - OPTIONALLY provide lambda expression of the form
+ *                      \verbatim [] (const abs_type &i) -> bool \endverbatim
+ *                      returns true if state i is in avoid set and false otherwise
+ * 
+ * @param[out] value - OPTIONALLY provide std::vector<double> value to obtain the value function 
+ *
+ * @param[in] no_threads - OPTIONALLY provide the number of threads (default = 1)
+ *
+ * @return -  WinningDomain that contains the set of winning states and valid inputs 
+ **/
+template<class F1, class F2=decltype(params::avoid)>
+WinningDomain solve_reachability_game_lean(const TransitionFunction& trans_function,
+                                           F1& target, 
+                                           F2& avoid = params::avoid,
+                                           std::vector<double> & value = params::value,
+                                           int no_threads = 1) {
+  /* size of state alphabet */
+  abs_type N=trans_function.m_no_states;
+  /* size of input alphabet */
+  abs_type M=trans_function.m_no_inputs;
+
+  /* used to encode that a state is not in the winning domain */
+  abs_type loosing = std::numeric_limits<abs_type>::max();
+  if(M > loosing-1) {
+    throw std::runtime_error("scots::solve_reachability_game_lean: Number of inputs exceeds maximum supported value");
+  }
+  no_threads=std::max(1,no_threads);
+  /* the edges (state-input pairs with post) */
+  EdgeIndex edge(trans_function);
+  /* keep track of the number of unprocessed posts of every edge */
+  std::unique_ptr<std::atomic<abs_type>[]> K(new std::atomic<abs_type>[edge.size()]);
+  /* input[i] = j: smallest input j that attains the value of state i */
+  std::unique_ptr<std::atomic<abs_type>[]> input(new std::atomic<abs_type>[N]);
+  /* initialize value */
+  value.assign(N,std::numeric_limits<double>::infinity());
+
+  /* init the counters and the first level, the states in the target */
+  std::vector<abs_type> level;
+  abs_ptr_type e=0;
+  for(abs_type i=0; i<N; i++) {
+    input[i].store(loosing,std::memory_order_relaxed);
+    if(target(i) && !avoid(i)) {
+      /* value is zero */
+      value[i]=0;
+      level.push_back(i);
+    }
+    for(abs_type j=0; j<M; j++) {
+      if(trans_function.m_no_post[static_cast<abs_ptr_type>(i)*M+j])
+        K[e++].store(trans_function.m_no_post[static_cast<abs_ptr_type>(i)*M+j],std::memory_order_relaxed);
+    }
+  }
+
+  /* main loop, the states of level have value d */
+  std::vector<std::vector<abs_type>> next(no_threads);
+  for(double d=0; !level.empty(); d++) {
+    run_threads(no_threads, [&](const int t) {
+      size_t begin=level.size()*t/no_threads, end=level.size()*(t+1)/no_threads;
+      for(size_t l=begin; l<end; l++) {
+        abs_type q=level[l];
+        /* loop over each input */
+        for(abs_type j=0; j<M; j++) {
+          abs_ptr_type qj=static_cast<abs_ptr_type>(q)*M+j;
+          /* loop over pre's associated with this input */
+          for(abs_ptr_type v=0; v<trans_function.m_no_pre[qj]; v++) {
+            abs_type i=trans_function.m_pre[trans_function.m_pre_ptr[qj]+v];
+            /* (i,j,q) is a transition, skip it if i is already winning */
+            if(value[i]<=d || avoid(i))
+              continue;
+            /* update the number of processed posts, continue if some are left */
+            if(K[edge(static_cast<abs_ptr_type>(i)*M+j)].fetch_sub(1,std::memory_order_relaxed)!=1)
+              continue;
+            /* all posts are processed, i is winning with value d+1 under input j */
+            abs_type old=loosing;
+            if(input[i].compare_exchange_strong(old,j,std::memory_order_relaxed)) {
+              next[t].push_back(i);
+              continue;
+            }
+            while(j<old && !input[i].compare_exchange_weak(old,j,std::memory_order_relaxed)) {}
+          }  /* end loop over all pres of state q under input j */
+        }  /* end loop over all input j */
+      }
+    });
+    /* the states that became winning form the next level */
+    level.clear();
+    for(int t=0; t<no_threads; t++) {
+      for(abs_type i : next[t]) {
+        value[i]=d+1;
+        level.push_back(i);
+      }
+      next[t].clear();
+    }
+  }  /* no more states */
+
+  std::vector<abs_type> win_domain(N); 
+  for(abs_type i=0; i<N; i++)
+    win_domain[i]=input[i].load(std::memory_order_relaxed);
+
+  /* if the default value function was used, free the memory of the static object*/
+  if(&value == &scots::params::value){
+      value.clear();
+      value.shrink_to_fit();
+  }
+
+  return WinningDomain(N,M,std::move(win_domain),std::vector<bool>{},loosing);
+}
+
+/** @cond **/
+namespace params {
+  /* number of states per thread of a round of solve_invariance_game_lean */
+  static const std::size_t invariance_round=64;
+}
+/* call f(i*M+j) for the transitions (i,j,k) of the states k in [first,last) */
+template<class F>
+void for_each_pre_pair(const TransitionFunction& trans_function, const abs_type* first, const abs_type* last, F&& f) {
+  abs_type M=trans_function.m_no_inputs;
+  for(; first!=last; first++) {
+    /* loop over all inputs */
+    for(abs_type j=0; j<M; j++) {
+      abs_ptr_type kj=static_cast<abs_ptr_type>(*first)*M+j;
+      /* loop over all pre states of (k,j) */
+      for(abs_ptr_type p=0; p<trans_function.m_no_pre[kj]; p++)
+        f(static_cast<abs_ptr_type>(trans_function.m_pre[trans_function.m_pre_ptr[kj]+p])*M+j);
+    }
+  }
+}
+/** @endcond **/
+
+/**
+ * @brief solve invariance game like solve_invariance_game with less memory, on several threads
+ *
+ * Besides the valid inputs of size N*M of the result, only one 32 bit counter
+ * per state is used. The counter of a state that has no more valid inputs is
+ * free, so the states whose pres are still to be processed form a stack
+ * linked through their counters, instead of a queue and an array of added
+ * states. The counters are released before the winning domain of the result
+ * is counted from the valid inputs, so the memory never exceeds the one of
+ * the result.
+ *
+ * With more than one thread the states are taken from the stack in rounds of
+ * 64 states per thread: the threads walk the pres of their part of the
+ * round and collect the pairs that are still valid, which are then removed
+ * on the calling thread. So the valid inputs are only read concurrently, and
+ * safe is only called on the calling thread. The result is the same as the
+ * one of solve_invariance_game.
+ * 
+ * @param[in] trans_function - TransitionFunction of the symbolic model
+ * @param[in] safe - lambda expression of the form
+ *                    \verbatim [] (const abs_type &i) -> bool \endverbatim 
+ *                   returns true if state i is in safe set and false otherwise
+ * @param[in] no_threads - OPTIONALLY provide the number of threads (default = 1)
+ * @return -  WinningDomain that contains the set of winning states and valid inputs 
+ **/
+template<class F>
+WinningDomain solve_invariance_game_lean(const TransitionFunction& trans_function, F& safe, int no_threads = 1) {
+  /* size of state alphabet */
+  abs_type N=trans_function.m_no_states;
+  /* size of input alphabet */
+  abs_type M=trans_function.m_no_inputs;
+  /* used to encode that a state is not in the winning domain */
+  abs_type loosing = std::numeric_limits<abs_type>::max();
+  /* the same for the counters, and the bottom of the stack */
+  const std::uint32_t lost = std::numeric_limits<std::uint32_t>::max();
+  if(N > lost) {
+    throw std::runtime_error("scots::solve_invariance_game_lean: Number of states exceeds maximum supported value");
+  }
+  no_threads=std::max(1,no_threads);
+  abs_ptr_type NM=static_cast<abs_ptr_type>(N)*M;
+
+  /* valid_inputs[i*M+j]=true iff input j is a valid input at state i */
+  std::vector<bool> valid_inputs(NM,false);
+  /* number of valid inputs, lost if the state is not winning and its pres are
+   * processed, the next state of the stack if they are not */
+  std::vector<std::uint32_t> no_val_in(N,0);
+  std::uint32_t top=lost;
+  auto push = [&](abs_type i) {
+    no_val_in[i]=top;
+    top=static_cast<std::uint32_t>(i);
+  };
+  auto pop = [&]() {
+    abs_type k=top;
+    top=no_val_in[k];
+    no_val_in[k]=lost;
+    return k;
+  };
+
+  /* initialization */
+  for(abs_type i=0; i<N; i++) {
+    std::uint32_t count=0;
+    if(safe(i)) {
+      for(abs_type j=0; j<M; j++) {
+        abs_ptr_type p=static_cast<abs_ptr_type>(i)*M+j;
+        if(trans_function.m_no_post[p]) {
+          valid_inputs[p]=true;
+          count++;
+        }
+      }
+    }
+    if(count)
+      no_val_in[i]=count;
+    else
+      push(i);
+  }
+
+  /* set the pair ij as unsafe pair, push its state if it has no more valid inputs */
+  auto remove_pair = [&](abs_ptr_type ij) {
+    if(!valid_inputs[ij])
+      return;
+    valid_inputs[ij]=false;
+    abs_type i=static_cast<abs_type>(ij/M);
+    if(!--no_val_in[i])
+      push(i);
+  };
+
+  if(no_threads==1) {
+    while(top!=lost) {
+      abs_type k=pop();
+      for_each_pre_pair(trans_function,&k,&k+1,remove_pair);
+    }
+  } else {
+    std::vector<abs_type> round;
+    /* the pairs of each thread that were valid when they were found */
+    std::vector<std::vector<abs_ptr_type>> found(no_threads);
+    while(top!=lost) {
+      round.clear();
+      while(top!=lost && round.size()<params::invariance_round*no_threads)
+        round.push_back(pop());
+      run_threads(no_threads, [&](const int t) {
+        size_t size=round.size();
+        for_each_pre_pair(trans_function,round.data()+size*t/no_threads,round.data()+size*(t+1)/no_threads,[&](abs_ptr_type ij) {
+          if(valid_inputs[ij])
+            found[t].push_back(ij);
+        });
+      });
+      for(int t=0; t<no_threads; t++) {
+        for(abs_ptr_type ij : found[t])
+          remove_pair(ij);
+        found[t].clear();
+      }
+    }
+  }
+
+  /* a state is winning iff it has valid inputs left */
+  std::vector<std::uint32_t>().swap(no_val_in);
+  std::vector<abs_type> win_domain(N);
+  for(abs_type i=0; i<N; i++) {
+    abs_type count=0;
+    for(abs_type j=0; j<M; j++)
+      count+=valid_inputs[static_cast<abs_ptr_type>(i)*M+j];
+    win_domain[i]=count ? count : loosing;
+  }
+  return WinningDomain(N,M,std::move(win_domain),std::move(valid_inputs),loosing);
+}
+
 } /* end of namespace scots */
 #endif /* GAMESOLVER_HH_ */
@@ -276,6 +276,20 @@ bool write_to_file(const Cudd& manager, const SymbolicSet& set, const BDD& bdd,
 
   return true;
 }
+
+/** 
+ * @brief write several BDDs over the variables of a SymbolicSet to a file
+ * The BDDs are stored in filename.bdd with their shared nodes written once\n
+ * The SymbolicSet is stored in filename.scs
+ **/
+inline
+bool write_to_file(const Cudd& manager, const SymbolicSet& set, const std::vector<BDD>& bdds, const std::string& filename, char mode='B') {
+    if(!write_to_file(set,filename)) {
+        return false;
+    }
+    FileWriter writer(filename);
+    return writer.add_BDD_array(manager,bdds,mode);
+}
 #endif
 
 
@@ -468,6 +482,17 @@ bool read_from_file(const Cudd& manager, SymbolicSet& set, BDD& bdd, const std::
     set.clean(manager,bdd);
     return true;
 }
+
+/** 
+ * @brief read the BDDs written by write_to_file with a vector of BDDs
+ **/
+inline
+bool read_from_file(const Cudd& manager, SymbolicSet& set, std::vector<BDD>& bdds, const std::string& filename, char mode = 'B') {
+    if(!read_from_file(manager,set,filename))
+        return false;
+    FileReader reader(filename);
+    return reader.get_BDD_array(manager,bdds,mode);
+}
 #endif
 
 
@@ -57,6 +57,21 @@ public:
                    m_state_grid(state_grid),
                    m_winning_domain(std::move(winning_domain)) { }
 
+  /** @brief get the grid of the state space **/
+  const UniformGrid& get_state_grid() const {
+    return m_state_grid;
+  }
+
+  /** @brief get the grid of the input space **/
+  const UniformGrid& get_input_grid() const {
+    return m_input_grid;
+  }
+
+  /** @brief get the winning domain and the valid inputs **/
+  const WinningDomain& get_winning_domain() const {
+    return m_winning_domain;
+  }
+
   /** @brief get a std::vector containing the valid control inputs at state x \n
     * does throw a runtime error if state x is out of winning domain**/
   template<class state_type, class input_type>
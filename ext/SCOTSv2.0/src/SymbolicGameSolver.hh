@@ -0,0 +1,172 @@
+/*
+ * SymbolicGameSolver.hh
+ *
+ *  created: Oct 2026
+ *   author: Antonio Rueda
+ *
+ */
+
+/** @file **/
+
+#ifndef SYMBOLICGAMESOLVER_HH_
+#define SYMBOLICGAMESOLVER_HH_
+
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "cuddObj.hh"
+
+#include "SymbolicSet.hh"
+#include "EnfPre.hh"
+#include "InputOutput.hh"
+
+/** @namespace scots **/
+namespace scots {
+
+/**
+ * @brief controller and value layers of a symbolic reachability game
+ *
+ * layers[k] holds the states (over the pre variables) that reach the target in
+ * k steps but not in fewer, layers[0] being the target. The controller holds
+ * the state-input pairs of every state at the iteration where it joined. The
+ * target and avoid sets the game was solved for are kept, so that a later
+ * game can be solved incrementally with resolve_reachability_game.
+ **/
+struct SymbolicReachResult {
+  BDD controller;
+  std::vector<BDD> layers;
+  BDD target;
+  BDD avoid;
+  /* number of layers taken from the previous result */
+  size_t reused_layers = 0;
+};
+
+/**
+ * @brief solve a reachability game incrementally from the result of a previous
+ * game with the same transition relation
+ *
+ * Computes the fixed point
+ *
+ *  mu X. ( (pre(X) & !A) | T )
+ *
+ * with the layers of the previous result. Let D be the states where the target
+ * or the avoid set changed. While the winning domain of the previous iteration
+ * matches the previous result, the layer of the next iteration outside D is
+ * the previous one, so only the enforcable predecessor restricted to D is
+ * computed. Once a layer differs, the iterations are computed in full until
+ * the winning domain matches the previous result again. The controller and the
+ * layers are the ones solve_reachability_game gives, where the states of a
+ * previous layer keep their inputs.
+ *
+ * @param manager    - the Cudd manager
+ * @param enf_pre    - the enforcable predecessor of the transition relation
+ * @param cube_input - BDD cube of the input variables
+ * @param previous   - result of a game for the same enf_pre
+ * @param T          - the target set (state variables)
+ * @param A          - the avoid set (state variables)
+ * @param verbose    - print the progress
+ **/
+inline
+SymbolicReachResult resolve_reachability_game(const Cudd& manager,
+                                              const EnfPre& enf_pre,
+                                              const BDD& cube_input,
+                                              const SymbolicReachResult& previous,
+                                              const BDD& T,
+                                              const BDD& A,
+                                              bool verbose=true) {
+  SymbolicReachResult result;
+  result.controller = manager.bddZero();
+  result.target = T;
+  result.avoid = A;
+  /* states where the game changed and the predecessor restricted to them */
+  BDD D = (previous.target ^ T) | (previous.avoid ^ A);
+  EnfPre enf_pre_D(enf_pre,D);
+  /* winning domain of the last iteration and of the previous result */
+  BDD W = manager.bddZero();
+  BDD W_prev = manager.bddZero();
+  bool in_sync = true;
+  for(size_t k=0; ; k++) {
+    BDD L_prev = (k<previous.layers.size()) ? previous.layers[k] : manager.bddZero();
+    W_prev |= L_prev;
+    BDD N;
+    if(in_sync) {
+      /* new (state/input) pairs in D */
+      BDD N_D = ((enf_pre_D(W) & !A) | (T & D)) & !W;
+      if(N_D.ExistAbstract(cube_input) == (L_prev & D)) {
+        N = (previous.controller & L_prev & !D) | N_D;
+        result.reused_layers++;
+      } else {
+        in_sync = false;
+      }
+    }
+    if(!in_sync) {
+      N = ((enf_pre(W) & !A) | T) & !W;
+    }
+    BDD L = N.ExistAbstract(cube_input);
+    if(L == manager.bddZero())
+      break;
+    result.controller |= N;
+    result.layers.push_back(L);
+    W |= L;
+    in_sync = (W == W_prev);
+    if(verbose)
+      print_progress(k+1);
+  }
+  if(verbose) {
+    std::cout << "\nNumber of iterations: " << result.layers.size()+1 << ", "
+              << result.reused_layers << " layers reused" << std::endl;
+  }
+  return result;
+}
+
+/**
+ * @brief solve the reachability game mu X. ( (pre(X) & !A) | T )
+ *
+ * Without avoid set (A = bddZero) this is the fixed point iteration of the
+ * BDD examples.
+ **/
+inline
+SymbolicReachResult solve_reachability_game(const Cudd& manager,
+                                            const EnfPre& enf_pre,
+                                            const BDD& cube_input,
+                                            const BDD& T,
+                                            const BDD& A,
+                                            bool verbose=true) {
+  /* nothing to reuse: every state of T and A is in D */
+  SymbolicReachResult empty;
+  empty.controller = manager.bddZero();
+  empty.target = !T;
+  empty.avoid = A;
+  return resolve_reachability_game(manager,enf_pre,cube_input,empty,T,A,verbose);
+}
+
+/**
+ * @brief write a SymbolicReachResult to a file
+ * The BDDs are stored in filename.bdd in the order controller, target, avoid
+ * and layers\n
+ * The SymbolicSet of the state space is stored in filename.scs
+ **/
+inline
+bool write_to_file(const Cudd& manager, const SymbolicSet& set, const SymbolicReachResult& result, const std::string& filename) {
+  std::vector<BDD> bdds {result.controller,result.target,result.avoid};
+  bdds.insert(bdds.end(),result.layers.begin(),result.layers.end());
+  return write_to_file(manager,set,bdds,filename);
+}
+
+/** @brief read a SymbolicReachResult from a file **/
+inline
+bool read_from_file(const Cudd& manager, SymbolicSet& set, SymbolicReachResult& result, const std::string& filename) {
+  std::vector<BDD> bdds;
+  if(!read_from_file(manager,set,bdds,filename) || bdds.size()<3)
+    return false;
+  result.controller = bdds[0];
+  result.target = bdds[1];
+  result.avoid = bdds[2];
+  result.layers.assign(bdds.begin()+3,bdds.end());
+  result.reused_layers = 0;
+  return true;
+}
+
+} /* close namespace */
+#endif /* SYMBOLICGAMESOLVER_HH_ */
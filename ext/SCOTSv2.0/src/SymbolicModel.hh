@@ -14,6 +14,7 @@
 
 
 #include "SymbolicSet.hh"
+#include "BatchPost.hh"
 
 /** @namespace scots **/ 
 namespace scots {
@@ -40,6 +41,8 @@ private:
   const SymbolicSet m_post;
   /* measurement error bound */
   std::unique_ptr<double[]> m_z;
+  /* the variable groups of the reordering are registered */
+  bool m_grouped=false;
 
   void progress(const abs_type& i, const abs_type& N, abs_type& counter) {
     if(!m_verbose)
@@ -108,6 +111,27 @@ public:
    **/
   template<class F1, class F2, class F3>
   BDD compute_gb(const Cudd& manager, F1& system_post, F2& radius_post, F3&& avoid, size_t& no_trans) {
+    ScalarPost<state_type,input_type,F1,F2> post(system_post,radius_post);
+    return compute_gb_post(manager, post, avoid, no_trans);
+  }
+
+  /** @brief computes the transition function with the posts of LANES pairs at a time (see BatchPost) **/
+  template<int LANES, class F1, class F2>
+  BDD compute_gb(const Cudd& manager, BatchPost<state_type,input_type,LANES,F1,F2> post, size_t& no_trans) {
+    return compute_gb_post(manager, post, [](const abs_type&) noexcept {return false;}, no_trans);
+  }
+  /** @brief computes the transition function with the posts of LANES pairs at a time (see BatchPost) **/
+  template<int LANES, class F1, class F2, class F3>
+  BDD compute_gb(const Cudd& manager, BatchPost<state_type,input_type,LANES,F1,F2> post, F3& avoid, size_t& no_trans) {
+    return compute_gb_post(manager, post, avoid, no_trans);
+  }
+
+private:
+  /* the transition function with the posts of post (ScalarPost or BatchPost), 
+   * the pairs of the cells not in avoid are integrated in groups of post.lanes */
+  template<class P, class F3>
+  BDD compute_gb_post(const Cudd& manager, const P& post, F3&& avoid, size_t& no_trans) {
+    group_bdd_vars(manager);
     /* number of cells */
     abs_type N=m_pre.size(); 
     /* number of inputs */
@@ -121,10 +145,18 @@ public:
     std::vector<abs_type> ub(dim);  /* upper-right corner */
     /* radius of hyper interval containing the attainable set */
     state_type eta;
-    state_type r;
-    /* state and input variables */
-    state_type x;
-    input_type u;
+    /* the pairs (cell, input) waiting for their post, their centers and radii */
+    const int lanes=P::lanes;
+    std::vector<abs_type> cell(lanes), input(lanes);
+    std::vector<state_type> x(lanes), r(lanes);
+    std::vector<input_type> u(lanes);
+    int no_pairs=0;
+    /* the input values, the same for all cells */
+    std::vector<input_type> input_values(M);
+    m_input.itox_batch(0,M,input_values.data());
+    /* the centers of the cells, computed a block of cells at a time */
+    const abs_type block=1024;
+    std::vector<state_type> centers(block);
     /* for out of bounds check */
     state_type lower_left;
     state_type upper_right;
@@ -136,37 +168,30 @@ public:
     }
     /* the BDD to encode the transition function */
     BDD tf = manager.bddZero();
-    /* is post of (i,j) out of domain ? */
-    bool out_of_domain;
-    /* loop over all cells */
-    for(abs_type i=0; i<N; i++) {
-      BDD bdd_i = m_pre.id_to_bdd(i);
-      /* is i an element of the avoid symbols ? */
-      if(avoid(i)) {
-        continue;
-      }
-      /* loop over all inputs */
-      for(abs_type j=0; j<M; j++) {
-        BDD bdd_j = m_input.id_to_bdd(j);
-        /* get center x of cell */
-        m_pre.itox(i,x);
-        /* cell radius (including measurement errors) */
-        for(int k=0; k<dim; k++)
-          r[k]=eta[k]/2.0+m_z[k];
-        /* current input */
-        m_input.itox(j,u);
-        /* integrate system and radius growth bound */
-        /* the result is stored in x and r */
-        radius_post(r,x,u);
-        system_post(x,u);
+    /* the transitions of the cell post_cell, added to tf once all its inputs are done */
+    BDD cell_tf = manager.bddZero();
+    abs_type post_cell=N;
+    auto add_cell = [&]() {
+      if(post_cell<N)
+        tf = tf | (m_pre.id_to_bdd(post_cell) & cell_tf);
+      cell_tf = manager.bddZero();
+    };
+    /* integrate the waiting pairs and add their transitions */
+    auto add_posts = [&]() {
+      /* integrate system and radius growth bound */
+      /* the result is stored in x and r */
+      post(x.data(),r.data(),u.data(),no_pairs);
+      for(int p=0; p<no_pairs; p++) {
+        /* is post of (i,j) out of domain ? */
+        bool out_of_domain=false;
         /* determine the cells which intersect with the attainable set: 
          * discrete hyper interval of cell indices 
          * [lb[0]; ub[0]] x .... x [lb[dim-1]; ub[dim-1]]
          * covers attainable set */
         for(int k=0; k<dim; k++) {
           /* check for out of bounds */
-          double left = x[k]-r[k]-m_z[k];
-          double right = x[k]+r[k]+m_z[k];
+          double left = x[p][k]-r[p][k]-m_z[k];
+          double right = x[p][k]+r[p][k]+m_z[k];
           if(left <= lower_left[k]-eta[k]/2.0  || right >= upper_right[k]+eta[k]/2.0) {
             out_of_domain=true;
             break;
@@ -177,17 +202,58 @@ public:
           ub[k] = static_cast<abs_type>((right-lower_left[k]+eta[k]/2.0)/eta[k]);
         }
         if(out_of_domain) {
-          out_of_domain=false;
           continue;
         }
+        if(cell[p]!=post_cell) {
+          add_cell();
+          post_cell = cell[p];
+        }
+        BDD bdd_j = m_input.id_to_bdd(input[p]);
         /* compute BDD of post */
         BDD bdd_k = m_post.interval_to_bdd(manager,lb,ub);
-        /* add to transition function */
-        tf = tf | (bdd_i & bdd_j & bdd_k);
+        /* add to transitions of the cell */
+        cell_tf = cell_tf | (bdd_j & bdd_k);
+      }
+      no_pairs=0;
+    };
+    /* loop over all cells */
+    for(abs_type i=0; i<N; i++) {
+      if(i%block==0)
+        m_pre.itox_batch(i,std::min(block,N-i),centers.data());
+      /* is i an element of the avoid symbols ? */
+      if(avoid(i)) {
+        continue;
+      }
+      /* loop over all inputs */
+      for(abs_type j=0; j<M; j++) {
+        cell[no_pairs]=i;
+        input[no_pairs]=j;
+        /* get center x of cell */
+        x[no_pairs]=centers[i%block];
+        /* cell radius (including measurement errors) */
+        for(int k=0; k<dim; k++)
+          r[no_pairs][k]=eta[k]/2.0+m_z[k];
+        /* current input */
+        u[no_pairs]=input_values[j];
+        if(++no_pairs==lanes)
+          add_posts();
       }
       /* print progress */
       progress(i,N,counter);
     }
+    if(no_pairs)
+      add_posts();
+    add_cell();
+    if(m_verbose) {
+      std::cout << "Input alphabet ";
+      m_input.print_cache_stats();
+      std::cout << "Post state alphabet ";
+      m_post.print_cache_stats();
+    }
+    /* the cached BDDs would only slow down the reordering during the synthesis */
+    m_pre.clear_caches();
+    m_input.clear_caches();
+    m_post.clear_caches();
 
     /* count number of transitions */
     size_t nvars = m_pre.get_no_bdd_vars() +
@@ -196,6 +262,8 @@ public:
     no_trans=tf.CountMinterm(nvars);
     return tf;
   }
+
+public:
   
   /** @brief set the measurement error bound **/
   void set_measurement_error_bound(const state_type& error_bound) {
@@ -204,6 +272,22 @@ public:
     }
   }
 
+  /**
+   * @brief register the variable groups of the dynamic reordering (see
+   * SymbolicSet::group_bdd_vars), done once at the beginning of compute_gb
+   *
+   * The variables of pre and post of each dimension form one group if they are
+   * interleaved (see SymbolicSet::interleaved), else a group each. The
+   * variables of each input dimension form a group.
+   **/
+  void group_bdd_vars(const Cudd& manager) {
+    if(m_grouped)
+      return;
+    SymbolicSet::group_bdd_vars(manager,{&m_pre,&m_post});
+    m_input.group_bdd_vars(manager);
+    m_grouped=true;
+  }
+
   /** @brief activate console output **/
   void verbose_on() {
     m_verbose=true;
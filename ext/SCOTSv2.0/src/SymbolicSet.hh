@@ -19,10 +19,17 @@
 
 #include "UniformGrid.hh"
 #include "IntegerInterval.hh"
+#include "CubeRange.hh"
 
 /* cudd library */
 #include "cuddObj.hh"
 
+/* the variable group tree is declared in mtr.h, which is not installed with cudd */
+#ifndef MTR_H_
+typedef struct MtrNode_ MtrNode;
+extern "C" MtrNode * Cudd_MakeTreeNode(DdManager *dd, unsigned int low, unsigned int size, unsigned int type);
+#endif
+
 namespace scots {
 
 /** 
@@ -38,6 +45,39 @@ private:
   std::vector<IntegerInterval<abs_type>> m_bdd_interval;
   /* a vector containing the slugs variable names */
   std::vector<std::string> m_slugs_var_names;
+  /* entry of the caches of id_to_bdd and interval_to_bdd */
+  struct cache_entry {
+    abs_type lb=0;
+    abs_type ub=0;
+    BDD bdd{};
+    bool valid=false;
+  };
+  /* number of entries of each cache, a power of two */
+  static constexpr size_t m_cache_size=size_t{1}<<12;
+  /* direct mapped caches of the grid point BDDs and of the interval BDDs of
+   * each dimension, the minterms of each dimension are the tables of the
+   * IntegerIntervals; allocated on first use */
+  mutable std::vector<cache_entry> m_id_cache{};
+  mutable std::vector<std::vector<cache_entry>> m_interval_cache{};
+  mutable size_t m_id_hits=0, m_id_misses=0;
+  mutable size_t m_interval_hits=0, m_interval_misses=0;
+
+  /* register the variables id as group of the reordering if they are
+   * contiguous in the current order */
+  static bool make_group(const Cudd& manager, const std::vector<unsigned int>& id) {
+    if(id.size()<2)
+      return false;
+    int low = manager.ReadPerm(id[0]);
+    int high = low;
+    for(const auto& i : id) {
+      low = std::min(low,manager.ReadPerm(i));
+      high = std::max(high,manager.ReadPerm(i));
+    }
+    if(static_cast<size_t>(high-low+1)!=id.size())
+      return false;
+    /* MTR_DEFAULT: the variables in the group may be reordered */
+    return Cudd_MakeTreeNode(manager.getManager(),manager.ReadInvPerm(low),id.size(),0)!=nullptr;
+  }
 public:
   /** @brief construct SymbolicSet with a Cudd manager **/
   SymbolicSet() : UniformGrid(), m_bdd_interval{}, m_slugs_var_names{} { }
@@ -206,6 +246,16 @@ public:
                      
   /** @brief function to obtain a BDD representation of the grid point id **/
   BDD id_to_bdd(abs_type id) const {
+    if(m_id_cache.empty())
+      m_id_cache.resize(m_cache_size);
+    cache_entry& entry=m_id_cache[id&(m_cache_size-1)];
+    if(entry.valid && entry.lb==id) {
+      m_id_hits++;
+      return entry.bdd;
+    }
+    m_id_misses++;
+    entry.lb=id;
+    entry.valid=true;
     abs_type num;
     int k=m_dim-1;
     /* k= m_dim -1 */
@@ -217,6 +267,7 @@ public:
       id=id%m_NN[k];
       bdd = bdd & m_bdd_interval[k].int_to_bdd(num);
     }
+    entry.bdd=bdd;
     return bdd;
   }
 
@@ -225,12 +276,55 @@ public:
   BDD interval_to_bdd(const Cudd& manager,
                       const std::vector<abs_type>& lb,   
                       const std::vector<abs_type>& ub) const {
-    BDD bdd = m_bdd_interval[0].interval_to_bdd(manager,lb[0],ub[0]);
+    BDD bdd = dim_interval_to_bdd(manager,0,lb[0],ub[0]);
     for(int i=1; i<m_dim; i++) 
-      bdd = bdd & m_bdd_interval[i].interval_to_bdd(manager,lb[i],ub[i]);
+      bdd = bdd & dim_interval_to_bdd(manager,i,lb[i],ub[i]);
     return bdd;
   }
 
+  /** @brief BDD of the grid point coordinates [lb; ub] in dimension dim, cached **/
+  BDD dim_interval_to_bdd(const Cudd& manager, int dim, abs_type lb, abs_type ub) const {
+    if(m_interval_cache.empty())
+      m_interval_cache.resize(m_dim);
+    std::vector<cache_entry>& cache=m_interval_cache[dim];
+    if(cache.empty())
+      cache.resize(m_cache_size);
+    cache_entry& entry=cache[(static_cast<size_t>(lb)*2654435761u+ub)&(m_cache_size-1)];
+    if(entry.valid && entry.lb==lb && entry.ub==ub) {
+      m_interval_hits++;
+      return entry.bdd;
+    }
+    m_interval_misses++;
+    entry.lb=lb;
+    entry.ub=ub;
+    entry.bdd=m_bdd_interval[dim].interval_to_bdd(manager,lb,ub);
+    entry.valid=true;
+    return entry.bdd;
+  }
+
+  /** @brief print the hits and misses of the caches of id_to_bdd and interval_to_bdd **/
+  void print_cache_stats() const {
+    auto rate = [](size_t hits, size_t misses) {
+      return (hits+misses) ? 100.0*hits/(hits+misses) : 0.0;
+    };
+    std::cout << "id_to_bdd cache: " << m_id_hits << " hits, " << m_id_misses << " misses ("
+              << rate(m_id_hits,m_id_misses) << "%), interval_to_bdd cache: " << m_interval_hits
+              << " hits, " << m_interval_misses << " misses (" << rate(m_interval_hits,m_interval_misses)
+              << "%)\n";
+  }
+
+  /**
+   * @brief release the BDDs cached by id_to_bdd and interval_to_bdd
+   *
+   * The cached BDDs keep their nodes alive, which makes reordering the
+   * manager more expensive. Call it once the caches are not needed any more,
+   * e.g. after SymbolicModel::compute_gb, and before the manager is reordered.
+   **/
+  void clear_caches() const {
+    std::vector<cache_entry>().swap(m_id_cache);
+    std::vector<std::vector<cache_entry>>().swap(m_interval_cache);
+  }
+
   /**
    * @brief obtain a BDD representation of the grid points whose grid point IDs
    * evaluate to true in the lambda expression
@@ -253,72 +347,17 @@ public:
    *  entries of the return vector represent the first grid point.
    **/
   abs_type * bdd_to_grid_point_ids(const Cudd& manager, BDD bdd, abs_type & no_gp) const {
+    no_gp=0;
     if((!get_no_bdd_vars()) || bdd==manager.bddZero())
       return {};
-    /* disable reordering (if enabled) */
-    const bool is_reordering = manager.ReorderingStatus(nullptr);
-    if(is_reordering){
-       manager.AutodynDisable();
-    }
-    /* get variable ids */
-    auto var_id = get_bdd_var_ids();
-    /* find the variables in the support of the BDD but outside the SymbolicSet */
-    auto support_id = bdd.SupportIndices();
-    std::vector<BDD> out{};
-    for(const auto& id : support_id) {
-        if(std::find(std::begin(var_id), std::end(var_id), id)==std::end(var_id))
-          out.emplace_back(manager.bddVar(id));
-    }
-    /* remove those variables from the bdd */
-    if(out.size())
-      bdd = bdd.ExistAbstract(manager.computeCube(out));
-    /* limit the grid points in the grid */
-    for(const auto& interval : m_bdd_interval)
-      bdd = bdd & interval.get_all_elements();
+    clean(manager,bdd);
     /* init the vector of grid points to be returned */
-    no_gp = get_size(manager,bdd);
-    abs_type* gp = new abs_type[no_gp*m_dim];
-    for(abs_type i=0; i<no_gp; i++) {
-      for(int j=0; j<m_dim; j++)
-        gp[i*m_dim+j]=0;
-    }
-    /* set up iteration to iterate over BDD cubes */
-    DdManager* dd = manager.getManager();
-    int *cube;
-    CUDD_VALUE_TYPE value;
-    DdGen *gen;
-    abs_type counter=0;
-    /* iterate over BDD cubes */
-    Cudd_ForeachCube(dd,bdd.getNode(),gen,cube,value) {
-      abs_type offset=1;
-      for(int i=0; i<m_dim; i++) {
-        unsigned int no_vars = m_bdd_interval[i].get_no_bdd_vars();
-        for (unsigned int j=0; j<no_vars; j++) {
-          unsigned int id = m_bdd_interval[i].get_bdd_var_ids()[j];
-          if(cube[id]==1) {
-            for(abs_type k=0; k<offset; k++) {
-              gp[(counter+k)*m_dim+i]+=(abs_type{1}<<(no_vars-1-j));
-            }
-          }
-          /* take care of don't care */
-          if(cube[id]==2) {
-            for(abs_type k=0; k<offset; k++) {
-              for(int l=0; l<=i; l++) {
-                gp[(counter+k+offset)*m_dim+l]=gp[(counter+k)*m_dim+l];
-              }
-            }
-            for(abs_type k=0; k<offset; k++) {
-              gp[(counter+k+offset)*m_dim+i]+=(abs_type{1}<<(no_vars-1-j));
-            }
-            offset=(offset<<1);
-          }
-        }
-      }
-      counter+=offset;
-    }
-    /* reactivate reordering if it was enabled */
-    if(is_reordering){
-      manager.AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
+    abs_type* gp = new abs_type[static_cast<size_t>(get_size(manager,bdd))*m_dim];
+    for(const auto& c : cubes(manager,bdd,false)) {
+      c.for_each_coordinates([&](const std::vector<abs_type>& x) {
+        std::copy(x.begin(),x.end(),gp+static_cast<size_t>(no_gp)*m_dim);
+        no_gp++;
+      });
     }
     return gp;
   }
@@ -333,74 +372,11 @@ public:
     gp.clear();
     if((!get_no_bdd_vars()) || bdd==manager.bddZero())
       return;
-    /* disable reordering (if enabled) */
-    const bool is_reordering = manager.ReorderingStatus(nullptr);
-    if(is_reordering){
-       manager.AutodynDisable();
-    }
-    /* get variable ids */
-    auto var_id = get_bdd_var_ids();
-    /* find the variables in the support of the BDD but outside the SymbolicSet */
-    auto support_id = bdd.SupportIndices();
-    std::vector<BDD> out{}; 
-    for(const auto& id : support_id) {
-        if(std::find(std::begin(var_id), std::end(var_id), id)==std::end(var_id))
-          out.emplace_back(manager.bddVar(id));
-    }
-    /* remove those variables from the bdd */
-    if(out.size()) 
-      bdd = bdd.ExistAbstract(manager.computeCube(out));
-    /* limit the grid points in the grid */
-    for(const auto& interval : m_bdd_interval) 
-      bdd = bdd & interval.get_all_elements();
-    /* init the vector of grid points to be returned */
-    abs_type no_gp = get_size(manager,bdd);
-    //std::vector<double> gp(no_gp*m_dim);
-    gp.resize(no_gp*m_dim);
-    for(abs_type i=0; i<no_gp; i++) {
-      for(int j=0; j<m_dim; j++) {
-          gp[i*m_dim+j]=m_first[j];
-      }
-    }
-    /* set up iteration to iterate over BDD cubes */
-    DdManager* dd = manager.getManager();
-    int *cube;
-    CUDD_VALUE_TYPE value;
-    DdGen *gen;
-    abs_type counter=0;
-    /* iterate over BDD cubes */
-    Cudd_ForeachCube(dd,bdd.getNode(),gen,cube,value) {
-      abs_type offset=1;
-      for(int i=0; i<m_dim; i++) {
-        unsigned int no_vars = m_bdd_interval[i].get_no_bdd_vars();
-        for (unsigned int j=0; j<no_vars; j++) {
-          unsigned int id = m_bdd_interval[i].get_bdd_var_ids()[j];
-          if(cube[id]==1) {
-            for(abs_type k=0; k<offset; k++) {
-              gp[(counter+k)*m_dim+i]+=(abs_type{1}<<(no_vars-1-j))*m_eta[i];
-            }
-          }
-          /* take care of don't care */
-          if(cube[id]==2) {
-            for(abs_type k=0; k<offset; k++) {
-              for(int l=0; l<=i; l++) {
-                gp[(counter+k+offset)*m_dim+l]=gp[(counter+k)*m_dim+l];
-              }
-            }
-            for(abs_type k=0; k<offset; k++) {
-              gp[(counter+k+offset)*m_dim+i]+=(abs_type{1}<<(no_vars-1-j))*m_eta[i];
-            }
-            offset=(offset<<1);
-          }
-        }
-      }
-      counter+=offset;
-    }
-    /* reactivate reordering if it was enabled */
-    if(is_reordering){
-      manager.AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
-    }
-    //return gp;
+    clean(manager,bdd);
+    gp.reserve(static_cast<size_t>(get_size(manager,bdd))*m_dim);
+    for_each_grid_point(manager,bdd,[&gp](const std::vector<double>& x) {
+      gp.insert(gp.end(),x.begin(),x.end());
+    },false);
   }
   
   inline std::vector<double> bdd_to_grid_points(const Cudd& manager, BDD bdd) const {
@@ -521,73 +497,63 @@ template<class grid_point_t>
   }
 
   /** @brief get a vector of IDs that corresponding to the grid points encoded by the BDD **/
-  std::vector<abs_type> bdd_to_id(const Cudd& manager, BDD bdd) {
+  std::vector<abs_type> bdd_to_id(const Cudd& manager, BDD bdd) const {
     if((!get_no_bdd_vars()) || bdd==manager.bddZero())
       return {};
-    /* disable reordering (if enabled) */
-    const bool is_reordering = manager.ReorderingStatus(nullptr);
-    if(is_reordering){
-      manager.AutodynDisable();
-    }
-    /* get variable ids */
-    auto var_id = get_bdd_var_ids();
-    /* find the variables in the support of the BDD but outside the SymbolicSet */
-    auto support_id = bdd.SupportIndices();
-    std::vector<BDD> out{}; 
-    for(const auto& id : support_id) {
-      if(std::find(std::begin(var_id), std::end(var_id), id)==std::end(var_id))
-        out.emplace_back(manager.bddVar(id));
-    }
-    /* remove those variables from the bdd */
-    if(out.size()) 
-      bdd = bdd.ExistAbstract(manager.computeCube(out));
-    /* limit the grid points in the grid */
-    for(const auto& interval : m_bdd_interval) 
-      bdd = bdd & interval.get_all_elements();
-    /* init the vector of grid points to be returned */
-    abs_type no_id = get_size(manager,bdd);
-    std::vector<abs_type> IDs(no_id,0);
-
-    /* set up iteration to iterate over BDD cubes */
-    DdManager* dd = manager.getManager();
-    int *cube;
-    CUDD_VALUE_TYPE value;
-    DdGen *gen;
-    abs_type counter=0;
-    /* iterate over BDD cubes */
-    Cudd_ForeachCube(dd,bdd.getNode(),gen,cube,value) {
-      abs_type offset=1;
-      for(int i=0; i<m_dim; i++) {
-        unsigned int no_vars = m_bdd_interval[i].get_no_bdd_vars();
-        for (unsigned int j=0; j<no_vars; j++) {
-          unsigned int id = m_bdd_interval[i].get_bdd_var_ids()[j];
-          if(cube[id]==1) {
-            for(abs_type k=0; k<offset; k++) {
-              IDs[counter+k]+=(abs_type{1}<<(no_vars-1-j))*m_NN[i];
-            }
-          }
-          /* take care of don't care */
-          if(cube[id]==2) {
-            for(abs_type k=0; k<offset; k++) {
-              for(int l=0; l<=i; l++) {
-                IDs[counter+k+offset]=IDs[counter+k];
-              }
-            }
-            for(abs_type k=0; k<offset; k++) {
-              IDs[counter+k+offset]+=(abs_type{1}<<(no_vars-1-j))*m_NN[i];
-            }
-            offset=(offset<<1);
+    clean(manager,bdd);
+    std::vector<abs_type> IDs;
+    IDs.reserve(get_size(manager,bdd));
+    for_each_id(manager,bdd,[&IDs](abs_type id) { IDs.push_back(id); },false);
+    return IDs;
+  }
+
+  /**
+   * @brief the cubes of the BDD as a single pass range of GridCube
+   *
+   * Unlike bdd_to_grid_points and bdd_to_id nothing is materialized, each cube
+   * is handed out with its don't care bits (see GridCube).
+   *
+   * @param manager  - the Cudd manager
+   * @param bdd      - the BDD
+   * @param do_clean - limit the bdd to the grid points of the SymbolicSet first,
+   *                   false if the bdd is already clean
+   **/
+  CubeRange cubes(const Cudd& manager, BDD bdd, bool do_clean=true) const {
+    if(!get_no_bdd_vars())
+      return CubeRange();
+    if(do_clean)
+      clean(manager,bdd);
+    std::vector<std::vector<unsigned int>> var_ids;
+    for(const auto& interval : m_bdd_interval)
+      var_ids.push_back(interval.get_bdd_var_ids());
+    return CubeRange(manager,bdd,std::move(var_ids),
+                     std::vector<abs_type>(m_NN.get(),m_NN.get()+m_dim));
+  }
+
+  /** @brief call f(abs_type id) for the IDs of the grid points encoded by the BDD, in the order of bdd_to_id **/
+  template<class F>
+  void for_each_id(const Cudd& manager, const BDD& bdd, F&& f, bool do_clean=true) const {
+    for(const auto& c : cubes(manager,bdd,do_clean))
+      c.for_each_id(f);
+  }
+
+  /** @brief call f(const std::vector<double>& x) for the grid points encoded by the BDD, in the order of bdd_to_grid_points **/
+  template<class F>
+  void for_each_grid_point(const Cudd& manager, const BDD& bdd, F&& f, bool do_clean=true) const {
+    std::vector<double> x(m_dim);
+    for(const auto& c : cubes(manager,bdd,do_clean)) {
+      c.for_each_coordinates([&](const std::vector<abs_type>& a) {
+        /* add up the bits as bdd_to_grid_points always did, for identical doubles */
+        for(int i=0; i<m_dim; i++) {
+          x[i]=m_first[i];
+          for(int k=m_bdd_interval[i].get_no_bdd_vars()-1; k>=0; k--) {
+            if((a[i]>>k)&1)
+              x[i]+=(abs_type{1}<<k)*m_eta[i];
           }
         }
-      }
-      counter+=offset;
+        f(x);
+      });
     }
-
-    /* reactivate reordering if it was enabled */
-    if(is_reordering){
-      manager.AutodynEnable(Cudd_ReorderingType::CUDD_REORDER_SAME);
-    }
-    return IDs;
   }
 
 
@@ -628,6 +594,106 @@ template<class grid_point_t>
       bdd = bdd & interval.get_all_elements();
   } 
 
+  /**
+   * @brief SymbolicSet on the grid of pre with new BDD variables, each placed
+   * right below the variable of pre for the same bit (interleaved pre/post)
+   *
+   * Relations between pre and post like the transition function are much
+   * smaller with the two variables of a bit next to each other.
+   **/
+  static SymbolicSet interleaved(const Cudd& manager, const SymbolicSet& pre) {
+    std::vector<IntegerInterval<abs_type>> intervals;
+    for(int i=0; i<pre.m_dim; i++) {
+      std::vector<unsigned int> var_id;
+      for(const auto& id : pre.m_bdd_interval[i].get_bdd_var_ids()) {
+        BDD var = manager.bddNewVarAtLevel(manager.ReadPerm(id)+1);
+        var_id.push_back(var.NodeReadIndex());
+      }
+      intervals.emplace_back(manager,abs_type{0},pre.m_no_grid_points[i]-1,var_id);
+    }
+    return SymbolicSet(static_cast<const UniformGrid&>(pre),intervals);
+  }
+
+  /**
+   * @brief move the BDD variables of post right below the variables of pre for
+   * the same bit, e.g., if the sets were read from files
+   *
+   * The other variables keep their order. Call it before variable groups are
+   * registered and while few BDDs exist, as all BDDs are rebuilt.
+   **/
+  static void interleave(const Cudd& manager, const SymbolicSet& pre, const SymbolicSet& post) {
+    if(pre.m_dim!=post.m_dim)
+      throw std::runtime_error("\nscots::SymbolicSet: pre and post differ in their dimension!");
+    std::vector<unsigned int> pre_id = pre.get_bdd_var_ids();
+    std::vector<unsigned int> post_id = post.get_bdd_var_ids();
+    for(int i=0; i<pre.m_dim; i++) {
+      if(pre.m_bdd_interval[i].get_no_bdd_vars()!=post.m_bdd_interval[i].get_no_bdd_vars())
+        throw std::runtime_error("\nscots::SymbolicSet: pre and post differ in their BDD variables!");
+    }
+    const int size = manager.ReadSize();
+    /* the post variable to place below each pre variable */
+    std::vector<int> below(size,-1);
+    std::vector<bool> is_post(size,false);
+    for(size_t k=0; k<pre_id.size(); k++) {
+      below[pre_id[k]] = post_id[k];
+      is_post[post_id[k]] = true;
+    }
+    std::vector<int> order;
+    for(int level=0; level<size; level++) {
+      int id = manager.ReadInvPerm(level);
+      if(is_post[id])
+        continue;
+      order.push_back(id);
+      if(below[id]>=0)
+        order.push_back(below[id]);
+    }
+    pre.clear_caches();
+    post.clear_caches();
+    manager.ShuffleHeap(order.data());
+  }
+
+  /**
+   * @brief register a group of the BDD variables of each dimension for the
+   * dynamic reordering
+   *
+   * If the variables of dimension i of all the sets are contiguous in the
+   * current order, e.g., interleaved pre and post, they form one group and the
+   * variables of each bit form a group inside it. Otherwise the variables of
+   * dimension i of each set form a group. Sifting then moves the groups as a
+   * whole. Variables that are not contiguous are not grouped.
+   **/
+  static void group_bdd_vars(const Cudd& manager, const std::vector<const SymbolicSet*>& sets) {
+    if(sets.empty())
+      return;
+    for(int i=0; i<sets[0]->m_dim; i++) {
+      std::vector<unsigned int> all;
+      bool same_bits = true;
+      for(const auto& set : sets) {
+        const std::vector<unsigned int>& id = set->m_bdd_interval[i].get_bdd_var_ids();
+        all.insert(all.end(),id.begin(),id.end());
+        same_bits &= (id.size()==sets[0]->m_bdd_interval[i].get_no_bdd_vars());
+      }
+      if(sets.size()>1 && make_group(manager,all)) {
+        if(!same_bits)
+          continue;
+        for(size_t j=0; j<sets[0]->m_bdd_interval[i].get_no_bdd_vars(); j++) {
+          std::vector<unsigned int> bit;
+          for(const auto& set : sets)
+            bit.push_back(set->m_bdd_interval[i].get_bdd_var_ids()[j]);
+          make_group(manager,bit);
+        }
+      } else {
+        for(const auto& set : sets)
+          make_group(manager,set->m_bdd_interval[i].get_bdd_var_ids());
+      }
+    }
+  }
+
+  /** @brief register a group of the BDD variables of each dimension for the dynamic reordering **/
+  void group_bdd_vars(const Cudd& manager) const {
+    group_bdd_vars(manager,{this});
+  }
+
   /** @brief get IntegerInterval  **/
   std::vector<IntegerInterval<abs_type>> get_bdd_intervals() const {
     return m_bdd_interval;
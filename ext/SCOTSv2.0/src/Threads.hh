@@ -0,0 +1,45 @@
+/*
+ * Threads.hh
+ *
+ *  created: Oct 2026
+ *   author: Antonio Rueda
+ *
+ */
+
+/** @file **/
+
+#ifndef THREADS_HH_
+#define THREADS_HH_
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+/** @namespace scots **/ 
+namespace scots {
+
+/** @brief default number of threads: the number of hardware threads, at least one **/
+inline int default_no_threads() {
+  return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+/**
+ * @brief runs f(t) for t=0,...,no_threads-1, each call on its own thread
+ *
+ * A single thread runs f(0) on the calling thread. f must not throw.
+ **/
+template<class F>
+void run_threads(const int no_threads, F&& f) {
+  if(no_threads<=1) {
+    f(0);
+    return;
+  }
+  std::vector<std::thread> threads;
+  for(int t=0; t<no_threads; t++)
+    threads.emplace_back(f,t);
+  for(auto& thread : threads)
+    thread.join();
+}
+
+} /* close namespace */
+#endif /* THREADS_HH_ */
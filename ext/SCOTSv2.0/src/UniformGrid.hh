@@ -16,8 +16,11 @@
 #include <vector>
 #include <cmath>
 #include <exception>
+#include <stdexcept>
 #include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <limits>
 #include <memory>
 
 /** @namespace scots **/ 
@@ -327,6 +330,35 @@ public:
     x[0]=m_first[0]+num*m_eta[0];
   }
 
+  /**
+   * @brief compute the grid points of the n consecutive indices first,...,first+n-1
+   *
+   * Only the first index is split into its integer coordinates, the ones of
+   * the next indices are counted up from it, the coordinate of dimension 0
+   * fastest. The points are the same as the ones of itox.
+   *
+   * @param first - the first index
+   * @param n     - number of indices
+   * @param x     - array of n grid points with m_dim entries each
+   **/
+  template<class grid_point_t>
+  void itox_batch(abs_type first, const abs_type n, grid_point_t* x) const {
+    std::vector<abs_type> dof(m_dim);
+    for(int k = m_dim-1; k > 0; --k) {
+      dof[k]=first/m_NN[k];
+      first=first%m_NN[k];
+    }
+    dof[0]=first;
+    for(abs_type i=0; i<n; ++i) {
+      for(int k = 0; k < m_dim; ++k) {
+        x[i][k]=m_first[k]+dof[k]*m_eta[k];
+      }
+      for(int k = 0; k < m_dim && ++dof[k]==m_no_grid_points[k]; ++k) {
+        dof[k]=0;
+      }
+    }
+  }
+
   /** @brief do a index to state conversion for vectors **/
   template<class grid_point_t>
   std::vector<grid_point_t> ItoX(std::vector<abs_type>& Ivector) const{
@@ -12,6 +12,7 @@
 
 #include "TransitionFunction.hh"
 #include "UniformGrid.hh"
+#include "Threads.hh"
 #include "Abstraction.hh"
 #include "GameSolver.hh"
 #include "WinningDomain.hh"
@@ -27,6 +28,8 @@
 #include "SymbolicSet.hh"
 #include "SymbolicModel.hh"
 #include "EnfPre.hh"
+#include "SymbolicGameSolver.hh"
+#include "ExplicitToSymbolic.hh"
 #endif
 
 #endif /* SCOTS_HH_ */
@@ -53,6 +53,56 @@ void runge_kutta_fixed4(RHS rhs, state_type &x, input_type &u, const int dim, co
   }
 }
 
+/**
+ *
+ * @brief runge_kutta_fixed4 for several initial states and inputs at once
+ *
+ * The states and inputs are given as structure of arrays, x[i][l] being
+ * coordinate i of lane l (see point_batch in BatchPost.hh), and rhs works on
+ * all lanes:
+ *              \verbatim [] (state_batch& xx,  const state_batch &x, const input_batch &u) ->  void \endverbatim
+ * The inner loops run over the lanes of a coordinate, which the compiler can
+ * vectorize, and every lane does the same arithmetic as runge_kutta_fixed4.
+ *
+ * @param rhs - lambda expression implementing the rhs of the ode on all lanes
+ * @param x - state_batch initial states
+ * @param u - input_batch constant inputs
+ * @param dim - state space dimension
+ * @param tau - sampling time
+ * @param nint - number of intermediate steps (default = 10)
+ * @return the solutions of the IVPs at time tau stored in x
+ **/
+template<class RHS, class state_batch, class input_batch>
+void runge_kutta_fixed4_batch(RHS rhs, state_batch &x, const input_batch &u, const int dim, const double tau, const int nint=10) noexcept {
+  const int lanes=x[0].size();
+  state_batch k[4];
+  state_batch tmp;
+
+  double h=tau/(double)nint;
+
+  for(int t=0; t<nint; t++) {
+    rhs(k[0],x,u);
+    for(int i=0;i<dim;i++)
+      for(int l=0;l<lanes;l++)
+        tmp[i][l]=x[i][l]+h/2*k[0][i][l];
+
+    rhs(k[1],tmp, u);
+    for(int i=0;i<dim;i++)
+      for(int l=0;l<lanes;l++)
+        tmp[i][l]=x[i][l]+h/2*k[1][i][l];
+
+    rhs(k[2],tmp, u);
+    for(int i=0;i<dim;i++)
+      for(int l=0;l<lanes;l++)
+        tmp[i][l]=x[i][l]+h*k[2][i][l];
+
+    rhs(k[3],tmp, u);
+    for(int i=0; i<dim; i++)
+      for(int l=0;l<lanes;l++)
+        x[i][l] = x[i][l] + (h/6)*(k[0][i][l] + 2*k[1][i][l] + 2*k[2][i][l] + k[3][i][l]);
+  }
+}
+
 } /* close namespace */
 
 #endif /* RUNGEKUTTA4_HH_ */
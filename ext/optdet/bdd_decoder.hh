@@ -31,6 +31,9 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
 
 #include "scots.hh"
 
@@ -61,6 +64,11 @@ namespace tud {
                 template<bool IS_OWNS_SET>
                 class bdd_decoder {
                 public:
+                    
+                    //The number of id bits permuted by one lookup table
+                    static constexpr size_t LUT_BITS = 8;
+                    //The number of entries in one lookup table
+                    static constexpr size_t LUT_SIZE = 1 << LUT_BITS;
                 
                     /*Data type for the state space and input values*/
                     using raw_data = std::vector<double>;
@@ -78,6 +86,9 @@ namespace tud {
                     m_bit_masks(NULL),
                     m_num_bits(0),
                     m_obidx_to_rbidx(),
+                    m_itob_luts(), m_btoi_luts(),
+                    m_itob_groups(), m_btoi_groups(),
+                    m_is_pext(false),
                     m_NN(m_symb_set.get_nn()),
                     m_dof_num_bits(),
                     m_ll(m_symb_set.get_lower_left()),
@@ -183,6 +194,10 @@ namespace tud {
                         //Iterate the mapping vector, set the from bit ids, create
                         //from-bit masks, make the vector of reordered variable ids
                         m_num_bits = m_obidx_to_rbidx.size();
+                        ASSERT_CONDITION_THROW((m_num_bits > 8 * sizeof(abs_type)),
+                                               string("The number of BDD variables: ") +
+                                               to_string(m_num_bits) + string(" exceeds the id bits: ") +
+                                               to_string(8 * sizeof(abs_type)));
                         size_t bit_idx = m_num_bits;
                         m_bit_masks = new abs_type[bit_idx];
                         vector<abs_type> reo_var_ids;
@@ -190,7 +205,7 @@ namespace tud {
                             //Give out the bit id
                             pair.first = --bit_idx;
                             //Initialize the bit mask for the given bit
-                            m_bit_masks[bit_idx] = 1<<bit_idx;
+                            m_bit_masks[bit_idx] = ((abs_type) 1) << bit_idx;
                             //Store the reordred variable ids
                             reo_var_ids.push_back(pair.second);
                         }
@@ -214,6 +229,9 @@ namespace tud {
                             }
                         }
                         
+                        //Pre-compile the bit permutations for converting ids
+                        compile_permutations();
+                        
                         //Get the end stats and log them
                         REPORT_STATS(string("Reading bdd reorderings"));
                     }
@@ -280,26 +298,13 @@ namespace tud {
                     inline bool btoi(abs_type bdd_id,  abs_type & sco_id) const {
                         //The success flag
                         bool is_ok = false;
-                        //Itinialize the resulting id with zero
-                        abs_type ext_id = 0;
+                        //Declare the resulting id
+                        abs_type ext_id;
                         
                         LOG_DEBUG1 << "Converting id: " << bdd_id << END_LOG;
                         
                         //Reorder bits back, i.e. as if there is no variable reordering
-                        for(auto & pair : m_obidx_to_rbidx) {
-                            //Get the from and to bit masks
-                            const abs_type & mask_from = m_bit_masks[pair.second];
-                            const abs_type & mask_to = m_bit_masks[pair.first];
-                            
-                            LOG_DEBUG2 << "bits (" << pair.first << ", " << pair.second
-                            << ") masks -> (" << mask_from << ", " << mask_to
-                            << ")" << END_LOG;
-                            
-                            //Make the conversion
-                            if(bdd_id & mask_from) {
-                                ext_id |= mask_to;
-                            }
-                        }
+                        ext_id = bdd_to_ext_bits(bdd_id);
                         
                         //Now we have an id in the original variable ordering but this is
                         //an extended grid id, so if we do not use the extended grid then
@@ -330,8 +335,8 @@ namespace tud {
                      *         variable ordering
                      */
                     inline abs_type itob(abs_type sco_id) const {
-                        //Itinialize the resulting id with zero
-                        abs_type bdd_id = 0, ext_id;
+                        //Declare the extended grid id
+                        abs_type ext_id;
                         
                         //In case this is not an extended grid case then we need to convert
                         //the scots id into the extended scots id, for matching bits.
@@ -344,26 +349,62 @@ namespace tud {
                         
                         LOG_DEBUG2 << "Converting extended grid scots id: " << ext_id << " into bdd id" << END_LOG;
                         
-                        //Convert the id bit by bit
-                        for(auto & pair : m_obidx_to_rbidx) {
-                            //Get the from and to bit masks
-                            const abs_type & mask_from = m_bit_masks[pair.first];
-                            const abs_type & mask_to = m_bit_masks[pair.second];
-                            
-                            LOG_DEBUG3 << "bits (" << pair.first << ", " << pair.second
-                            << ") masks -> (" << mask_from << ", " << mask_to
-                            << ")" << END_LOG;
-                            
-                            //Make the conversion
-                            if(ext_id & mask_from) {
-                                bdd_id |= mask_to;
-                            }
-                        }
+                        //Permute the bits into the current variable ordering
+                        const abs_type bdd_id = ext_to_bdd_bits(ext_id);
                         
                         LOG_DEBUG2 << "Resulting id: " << bdd_id << END_LOG;
                         
                         return bdd_id;
                     }
+                    
+                    /**
+                     * Allows to convert abstract symbolic set state ids into ids
+                     * in the current bdd varibale ordering, as itob does for one id.
+                     * @param sco_ids the abstract symbolic set ids
+                     * @param bdd_ids the bdd ids to be filled in, one per scots id
+                     */
+                    inline void itob(const vector<abs_type> & sco_ids, vector<abs_type> & bdd_ids) const {
+                        bdd_ids.resize(sco_ids.size());
+                        if(!m_is_ext_grid) {
+                            for(size_t idx = 0; idx < sco_ids.size(); ++idx) {
+                                bdd_ids[idx] = ext_to_bdd_bits(sco_id_to_ext_id(sco_ids[idx]));
+                            }
+                        } else {
+                            for(size_t idx = 0; idx < sco_ids.size(); ++idx) {
+                                bdd_ids[idx] = ext_to_bdd_bits(sco_ids[idx]);
+                            }
+                        }
+                    }
+                    
+                    /**
+                     * Allows to convert bdd state ids into the abstract
+                     * symbolic set ids, as btoi does for one id.
+                     * @param bdd_ids the bdd state ids
+                     * @param sco_ids the scots ids to be filled in, one per bdd id
+                     * @param is_ok the flags to be filled in, true if the state is on the grid
+                     * @return the number of bdd ids that are on the grid
+                     */
+                    inline size_t btoi(const vector<abs_type> & bdd_ids, vector<abs_type> & sco_ids,
+                                       vector<bool> & is_ok) const {
+                        sco_ids.resize(bdd_ids.size());
+                        is_ok.resize(bdd_ids.size());
+                        size_t num_ok = 0;
+                        abs_type dof_ids[m_symb_set.get_dim()];
+                        for(size_t idx = 0; idx < bdd_ids.size(); ++idx) {
+                            const abs_type ext_id = bdd_to_ext_bits(bdd_ids[idx]);
+                            ext_id_to_ids(ext_id, dof_ids);
+                            if(!m_is_ext_grid) {
+                                abs_type sco_id = 0;
+                                is_ok[idx] = m_symb_set.istoi(dof_ids, sco_id);
+                                sco_ids[idx] = sco_id;
+                            } else {
+                                is_ok[idx] = m_symb_set.is_on_grid(dof_ids);
+                                sco_ids[idx] = ext_id;
+                            }
+                            num_ok += is_ok[idx];
+                        }
+                        return num_ok;
+                    }
                  
                     /**
                      * Allows to get the enclosed symbolic set
@@ -384,6 +425,145 @@ namespace tud {
 
                 protected:
                     
+                    /**
+                     * Compiles the bit mapping into one lookup table per LUT_BITS bits of an id,
+                     * for each direction. When the code is built for BMI2 and the mapping splits
+                     * into fewer groups of order preserving bits than there are lookup tables,
+                     * PEXT/PDEP on the groups is used instead.
+                     */
+                    inline void compile_permutations() {
+                        const size_t num_luts = (m_num_bits + LUT_BITS - 1) / LUT_BITS;
+                        m_itob_luts.assign(num_luts * LUT_SIZE, 0);
+                        m_btoi_luts.assign(num_luts * LUT_SIZE, 0);
+                        vector<pair<uint32_t, uint32_t>> rbidx_to_obidx;
+                        for(auto & pair : m_obidx_to_rbidx) {
+                            add_bit_to_luts(pair.first, m_bit_masks[pair.second], m_itob_luts);
+                            add_bit_to_luts(pair.second, m_bit_masks[pair.first], m_btoi_luts);
+                            rbidx_to_obidx.emplace_back(pair.second, pair.first);
+                        }
+                        
+                        //Split the mappings into order preserving bit groups
+                        m_itob_groups.clear();
+                        m_btoi_groups.clear();
+                        compile_bit_groups(m_obidx_to_rbidx, m_itob_groups);
+                        compile_bit_groups(rbidx_to_obidx, m_btoi_groups);
+#ifdef __BMI2__
+                        m_is_pext = (max(m_itob_groups.size(), m_btoi_groups.size()) <= num_luts);
+#endif
+                        
+                        LOG_DEBUG << "Bit permutation: " << num_luts << " lookup tables, "
+                        << m_itob_groups.size() << "/" << m_btoi_groups.size()
+                        << " order preserving bit groups, using "
+                        << (m_is_pext ? "PEXT/PDEP" : "lookup tables") << END_LOG;
+                    }
+                    
+                    /**
+                     * Adds the mapping of one bit into the lookup tables
+                     * @param bit_from the index of the source bit
+                     * @param mask_to the mask of the target bit
+                     * @param luts the lookup tables to be extended
+                     */
+                    static inline void add_bit_to_luts(const uint32_t bit_from, const abs_type mask_to,
+                                                       vector<abs_type> & luts) {
+                        const size_t offset = (bit_from / LUT_BITS) * LUT_SIZE;
+                        const size_t mask_from = ((size_t) 1) << (bit_from % LUT_BITS);
+                        for(size_t value = 0; value < LUT_SIZE; ++value) {
+                            if(value & mask_from) {
+                                luts[offset + value] |= mask_to;
+                            }
+                        }
+                    }
+                    
+                    /**
+                     * Splits the bit mapping into the least number of groups in which
+                     * the target bits are in the same order as the source bits.
+                     * @param bit_map the source to target bit index mapping
+                     * @param groups the source and target bit masks of the groups to be filled in
+                     */
+                    static inline void compile_bit_groups(vector<pair<uint32_t, uint32_t>> bit_map,
+                                                          vector<pair<abs_type, abs_type>> & groups) {
+                        sort(bit_map.begin(), bit_map.end());
+                        vector<uint32_t> last_to;
+                        for(auto & pair : bit_map) {
+                            //Take the first group that the target bit can follow
+                            size_t grp = 0;
+                            while((grp < groups.size()) && (last_to[grp] > pair.second)) {
+                                ++grp;
+                            }
+                            if(grp == groups.size()) {
+                                groups.emplace_back(0, 0);
+                                last_to.push_back(0);
+                            }
+                            groups[grp].first |= ((abs_type) 1) << pair.first;
+                            groups[grp].second |= ((abs_type) 1) << pair.second;
+                            last_to[grp] = pair.second;
+                        }
+                    }
+                    
+                    /**
+                     * Permutes the id bits with the lookup tables
+                     * @param id the id to permute
+                     * @param luts the lookup tables
+                     * @return the permuted id
+                     */
+                    static inline abs_type permute_luts(abs_type id, const vector<abs_type> & luts) {
+                        abs_type result = 0;
+                        for(size_t offset = 0; offset < luts.size(); offset += LUT_SIZE) {
+                            result |= luts[offset + (id & (LUT_SIZE - 1))];
+                            id >>= LUT_BITS;
+                        }
+                        return result;
+                    }
+                    
+#ifdef __BMI2__
+                    /**
+                     * Permutes the id bits with PEXT/PDEP on the order preserving bit groups
+                     * @param id the id to permute
+                     * @param groups the source and target bit masks of the groups
+                     * @return the permuted id
+                     */
+                    static inline abs_type permute_groups(const abs_type id,
+                                                          const vector<pair<abs_type, abs_type>> & groups) {
+                        abs_type result = 0;
+                        for(auto & group : groups) {
+                            if(sizeof(abs_type) > sizeof(uint32_t)) {
+                                result |= _pdep_u64(_pext_u64(id, group.first), group.second);
+                            } else {
+                                result |= _pdep_u32(_pext_u32(id, group.first), group.second);
+                            }
+                        }
+                        return result;
+                    }
+#endif
+                    
+                    /**
+                     * Permutes the bits of an extended grid id into a bdd id
+                     * @param ext_id the extended grid id
+                     * @return the bdd id
+                     */
+                    inline abs_type ext_to_bdd_bits(const abs_type ext_id) const {
+#ifdef __BMI2__
+                        if(m_is_pext) {
+                            return permute_groups(ext_id, m_itob_groups);
+                        }
+#endif
+                        return permute_luts(ext_id, m_itob_luts);
+                    }
+                    
+                    /**
+                     * Permutes the bits of a bdd id into an extended grid id
+                     * @param bdd_id the bdd id
+                     * @return the extended grid id
+                     */
+                    inline abs_type bdd_to_ext_bits(const abs_type bdd_id) const {
+#ifdef __BMI2__
+                        if(m_is_pext) {
+                            return permute_groups(bdd_id, m_btoi_groups);
+                        }
+#endif
+                        return permute_luts(bdd_id, m_btoi_luts);
+                    }
+                    
                     /**
                      * Alloes to get the free permutation ids based on the permutations map
                      * @param perms the available permutations map
@@ -519,7 +699,7 @@ namespace tud {
                             offset = num_bits;
                             
                             //Check if the given grid is an extended dof grid
-                            if(num_points != pow(2, num_bits)) {
+                            if(num_points != (((abs_type) 1) << num_bits)) {
                                 result = false;
                             }
                         }
@@ -539,6 +719,16 @@ namespace tud {
                     uint32_t m_num_bits;
                     //Store the bit mapings stores the original to reordered bdd bit (variable) index mappings
                     vector<pair<uint32_t, uint32_t>> m_obidx_to_rbidx;
+                    //Stores the lookup tables of the original to reordered bit permutation
+                    vector<abs_type> m_itob_luts;
+                    //Stores the lookup tables of the reordered to original bit permutation
+                    vector<abs_type> m_btoi_luts;
+                    //Stores the order preserving bit groups of the original to reordered bit permutation
+                    vector<pair<abs_type, abs_type>> m_itob_groups;
+                    //Stores the order preserving bit groups of the reordered to original bit permutation
+                    vector<pair<abs_type, abs_type>> m_btoi_groups;
+                    //Stores the flag indicating whether the bit groups are permuted with PEXT/PDEP
+                    bool m_is_pext;
                     //Stores the reference to the Symbolic set NN array
                     const vector<abs_type> m_NN;
                     //Stores the number of bits needed per dof in dof-ascending order
@@ -0,0 +1,227 @@
+/*
+ * File:   cudd_mgr.hh
+ * Author: Antonio Rueda
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CUDD_MGR_HPP
+#define CUDD_MGR_HPP
+
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <algorithm>
+
+#include "cuddObj.hh"
+
+#include "exceptions.hh"
+#include "logger.hh"
+
+using namespace std;
+
+using namespace tud::utils::exceptions;
+using namespace tud::utils::logging;
+
+namespace tud {
+    namespace ctrl {
+        namespace scots {
+            namespace optimal {
+
+                //The minimum number of computed table slots we ever allocate
+#define MIN_CUDD_CACHE_SLOTS (1u << 12)
+                //The maximum number of computed table slots we size up to, initially
+#define MAX_CUDD_CACHE_SLOTS (1u << 22)
+                //The approximate size of a DdNode and of a computed table entry in bytes
+#define CUDD_ENTRY_BYTES 32u
+                //The number of bytes in a mega byte
+#define BYTES_IN_MB (1024u * 1024u)
+                //The maximum number of lines to look through in search for the header
+#define MAX_BDD_HEADER_LINES 32
+
+                /**
+                 * Stores the BDD size information read from the DDDMP file header
+                 */
+                struct bdd_header_info {
+                    //The number of BDD nodes stored in the file
+                    uint32_t m_num_nodes;
+                    //The number of BDD variables in the file
+                    uint32_t m_num_vars;
+                };
+
+                /**
+                 * Stores the CUDD manager sizing parameters
+                 */
+                struct cudd_mgr_sizes {
+                    //The initial number of unique sub-table slots per variable
+                    uint32_t m_unique_slots;
+                    //The initial number of the computed table slots
+                    uint32_t m_cache_slots;
+                    //The hard limit on the number of the computed table slots, 0 for none
+                    uint32_t m_max_cache_hard;
+                    //The memory budget in bytes, 0 for none
+                    size_t m_max_memory;
+                };
+
+                /**
+                 * Allows to compute the smallest power of two not smaller than the given value
+                 * @param value the value to round up
+                 * @return the resulting power of two
+                 */
+                static inline uint32_t ceil_pow_2(const uint64_t value) {
+                    uint64_t result = 1;
+                    while((result < value) && (result < (1u << 31))) {
+                        result <<= 1;
+                    }
+                    return static_cast<uint32_t>(result);
+                }
+
+                /**
+                 * Allows to compute the largest power of two not larger than the given value
+                 * @param value the value to round down, must be > 0
+                 * @return the resulting power of two
+                 */
+                static inline uint32_t floor_pow_2(const uint64_t value) {
+                    const uint32_t result = ceil_pow_2(value);
+                    return (result > value) ? (result >> 1) : result;
+                }
+
+                /**
+                 * Allows to read the number of nodes and variables from the BDD file header.
+                 * Only the textual DDDMP header is read, the BDD body is never touched.
+                 * @param source_file the controller file name without (.scs/.bdd)
+                 * @param info the structure to store the header data into, set to zeroes if not found
+                 */
+                static inline void read_bdd_header_info(const string & source_file, bdd_header_info & info) {
+                    info = {};
+                    ifstream bdd_file(source_file + string(".bdd"));
+                    if(bdd_file.is_open()) {
+                        string line;
+                        for(int idx = 0; (idx < MAX_BDD_HEADER_LINES) && getline(bdd_file, line); ++idx) {
+                            if(line.compare(0, 8, ".nnodes ") == 0) {
+                                info.m_num_nodes = stoul(line.substr(8));
+                            } else {
+                                if(line.compare(0, 7, ".nvars ") == 0) {
+                                    info.m_num_vars = stoul(line.substr(7));
+                                }
+                            }
+                            //The nodes section starts here, nothing to read any more
+                            if(line.compare(0, 6, ".nodes") == 0) {
+                                break;
+                            }
+                        }
+                        bdd_file.close();
+                    } else {
+                        LOG_WARNING << "Could not open '" << source_file
+                        << ".bdd' for reading, using the default CUDD sizes!" << END_LOG;
+                    }
+                }
+
+                /**
+                 * Allows to compute the CUDD manager sizes for the given BDD
+                 * size and the memory budget. The unique sub-tables and the
+                 * computed table are scaled with the number of BDD nodes so
+                 * that small controllers do not over-allocate and large ones
+                 * do not start with a thrashing cache. If the memory budget
+                 * is given then the computed table is kept within a quarter of it.
+                 * @param info the BDD header info, the number of nodes can be zero
+                 * @param mem_budget_mb the memory budget in MB, 0 for unlimited
+                 * @param sizes the structure to store the computed sizes into
+                 */
+                static inline void compute_cudd_mgr_sizes(const bdd_header_info & info,
+                                                          const uint32_t mem_budget_mb,
+                                                          cudd_mgr_sizes & sizes) {
+                    sizes = {CUDD_UNIQUE_SLOTS, CUDD_CACHE_SLOTS, 0, 0};
+
+                    //Scale the tables with the number of nodes, if known
+                    if(info.m_num_nodes > 0) {
+                        //About two slots per node spread over the variables
+                        const uint64_t per_var = (2ull * info.m_num_nodes) / max(info.m_num_vars, 1u);
+                        sizes.m_unique_slots = max<uint32_t>(CUDD_UNIQUE_SLOTS, ceil_pow_2(per_var));
+                        //The operations produce intermediate nodes, allow for that
+                        sizes.m_cache_slots = min(max(ceil_pow_2(8ull * info.m_num_nodes),
+                                                      MIN_CUDD_CACHE_SLOTS), MAX_CUDD_CACHE_SLOTS);
+                    }
+
+                    //Fit into the memory budget, if given
+                    if(mem_budget_mb > 0) {
+                        sizes.m_max_memory = static_cast<size_t>(mem_budget_mb) * BYTES_IN_MB;
+                        sizes.m_max_cache_hard = max(floor_pow_2(sizes.m_max_memory / 4 / CUDD_ENTRY_BYTES),
+                                                     MIN_CUDD_CACHE_SLOTS);
+                        sizes.m_cache_slots = min(sizes.m_cache_slots, sizes.m_max_cache_hard);
+                    }
+                }
+
+                /**
+                 * Allows to create a CUDD manager sized for the given
+                 * controller and the memory budget. In case of the budget
+                 * the manager has a hard memory limit, exceeding it results
+                 * in an exception instead of exhausting the machine's RAM.
+                 * @param source_file the controller file name without (.scs/.bdd)
+                 * @param mem_budget_mb the memory budget in MB, 0 for unlimited
+                 * @return the newly created CUDD manager
+                 */
+                static inline Cudd create_cudd_mgr(const string & source_file, const uint32_t mem_budget_mb) {
+                    //Get the BDD size from the file header
+                    bdd_header_info info = {};
+                    read_bdd_header_info(source_file, info);
+
+                    //Compute the manager sizes
+                    cudd_mgr_sizes sizes = {};
+                    compute_cudd_mgr_sizes(info, mem_budget_mb, sizes);
+
+                    LOG_INFO << "The BDD of '" << source_file << "' has " << info.m_num_nodes
+                    << " nodes over " << info.m_num_vars << " variables" << END_LOG;
+                    LOG_INFO << "CUDD unique slots: " << sizes.m_unique_slots << ", cache slots: "
+                    << sizes.m_cache_slots << ", memory budget: " << mem_budget_mb << " Mb" << END_LOG;
+
+                    //Create the manager, the max memory is the soft limit used for the initial set up
+                    Cudd cudd_mgr(0, 0, sizes.m_unique_slots, sizes.m_cache_slots, sizes.m_max_memory);
+
+                    if(mem_budget_mb > 0) {
+                        //Set the hard memory limit, the manager fails when exceeded
+                        cudd_mgr.SetMaxMemory(sizes.m_max_memory);
+                        //Do not let the computed table outgrow its share of the budget
+                        cudd_mgr.SetMaxCacheHard(sizes.m_max_cache_hard);
+                        //Grow the unique table loosely up to a fifth of the budget, then collect garbage
+                        cudd_mgr.SetLooseUpTo(static_cast<unsigned int>(sizes.m_max_memory / CUDD_ENTRY_BYTES / 5));
+                        //Only grow the cache when it really pays off, default is 30%
+                        cudd_mgr.SetMinHit(50);
+                    }
+
+                    return cudd_mgr;
+                }
+
+                /**
+                 * Allows to report the CUDD manager statistics, the
+                 * computed table hits/misses, garbage collections and memory
+                 * @param cudd_mgr the CUDD manager to report on
+                 */
+                static inline void report_cudd_mgr_stats(const Cudd & cudd_mgr) {
+                    const double look_ups = cudd_mgr.ReadCacheLookUps();
+                    const double hits = cudd_mgr.ReadCacheHits();
+                    LOG_USAGE << "CUDD cache look-ups: " << look_ups << ", hits: " << hits
+                    << ", misses: " << (look_ups - hits) << ", hit ratio: "
+                    << (look_ups > 0 ? (100.0 * hits / look_ups) : 0.0) << "%" << END_LOG;
+                    LOG_USAGE << "CUDD cache slots: " << cudd_mgr.ReadCacheSlots()
+                    << ", garbage collections: " << cudd_mgr.ReadGarbageCollections()
+                    << ", peak nodes: " << cudd_mgr.ReadPeakNodeCount()
+                    << ", memory in use: " << (cudd_mgr.ReadMemoryInUse() / BYTES_IN_MB) << " Mb" << END_LOG;
+                }
+            }
+        }
+    }
+}
+
+#endif /* CUDD_MGR_HPP */
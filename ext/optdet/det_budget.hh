@@ -0,0 +1,198 @@
+/*
+ * File:   det_budget.hh
+ * Author: Antonio Rueda
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DET_BUDGET_HPP
+#define DET_BUDGET_HPP
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+#include "cuddObj.hh"
+
+#include "exceptions.hh"
+#include "logger.hh"
+#include "monitor.hh"
+
+using namespace std;
+
+using namespace tud::utils::exceptions;
+using namespace tud::utils::logging;
+using namespace tud::utils::monitor;
+
+namespace tud {
+    namespace ctrl {
+        namespace scots {
+            namespace optimal {
+
+                /**
+                 * This exception is thrown by det_budget::check once the
+                 * budget is used up, the determinizers catch it and keep
+                 * the part of the work that is done.
+                 */
+                class budget_exceeded : public tud_exception {
+                public:
+                    explicit budget_exceeded(const string &message) : tud_exception(message) {
+                    }
+                };
+
+                /**
+                 * This class stores the wall time and memory budget of a
+                 * determinization. The determinizers poll it in their loops
+                 * and stop improving the controller once it is used up.
+                 */
+                class det_budget {
+                public:
+
+                    /**
+                     * The basic constructor, the time is counted from here
+                     * @param seconds the wall time budget in seconds, 0 for unlimited
+                     * @param mem_mb the resident memory budget in Mb, 0 for unlimited
+                     */
+                    det_budget(const double seconds = 0, const uint32_t mem_mb = 0)
+                    : m_seconds(seconds), m_mem_mb(mem_mb), m_reserve(0),
+                    m_start(chrono::steady_clock::now()),
+                    m_num_checks(0), m_is_exceeded(false),
+                    m_last_publish(0), m_publish_time(0) {
+                    }
+
+                    /**
+                     * Allows to check if there is a budget at all
+                     * @return true if the time or the memory is limited
+                     */
+                    bool is_limited() const {
+                        return (m_seconds > 0) || (m_mem_mb > 0);
+                    }
+
+                    /**
+                     * Allows to get the wall time since the budget was created
+                     * @return the elapsed time in seconds
+                     */
+                    double get_elapsed() const {
+                        return chrono::duration<double>(chrono::steady_clock::now() - m_start).count();
+                    }
+
+                    /**
+                     * Allows to keep some of the time budget for the work that follows
+                     * the search, i.e. converting and completing its result
+                     * @param seconds the time the search leaves unused
+                     */
+                    void set_reserve(const double seconds) {
+                        m_reserve = seconds;
+                    }
+
+                    /**
+                     * Checks if the budget is used up, the memory is only read
+                     * from the system every MEM_CHECK_PERIOD calls. Once used
+                     * up the budget stays used up.
+                     * @return true if the time or the memory budget is used up
+                     */
+                    bool is_exceeded() {
+                        if(!m_is_exceeded && is_limited()) {
+                            if((m_seconds > 0) && (get_elapsed() + m_reserve >= m_seconds)) {
+                                m_is_exceeded = true;
+                                LOG_USAGE << "The time budget of " << m_seconds << " seconds is used up, "
+                                          << m_reserve << " of them are kept to finish" << END_LOG;
+                            }
+                            if(!m_is_exceeded && (m_mem_mb > 0) && ((m_num_checks++ % MEM_CHECK_PERIOD) == 0)) {
+                                TMemotyUsage mem_stat = {};
+                                stat_monitor::get_mem_stat(mem_stat);
+                                if(mem_stat.vmrss >= static_cast<int64_t>(m_mem_mb) * 1024) {
+                                    m_is_exceeded = true;
+                                    LOG_USAGE << "The memory budget of " << m_mem_mb << " Mb is used up" << END_LOG;
+                                }
+                            }
+                        }
+                        return m_is_exceeded;
+                    }
+
+                    /**
+                     * Throws budget_exceeded if the budget is used up
+                     */
+                    void check() {
+                        if(is_exceeded()) {
+                            throw budget_exceeded("The determinization budget is used up");
+                        }
+                    }
+
+                    /**
+                     * Allows to set the function that keeps the intermediate
+                     * controllers published by the determinizers
+                     * @param publisher the function called with a partial controller
+                     */
+                    void set_publisher(const function<void(const BDD &)> & publisher) {
+                        m_publisher = publisher;
+                    }
+
+                    /**
+                     * Publishes the partial controller of a determinizer at the end
+                     * of one of its stages or rounds. It is skipped if there is no
+                     * publisher, if the budget is used up or would be by publishing,
+                     * and if the last publication was less than MIN_PUBLISH_PERIOD
+                     * seconds or PUBLISH_RATIO times its duration ago.
+                     * @param get_partial returns the partial controller, it is only
+                     * called if the controller is published
+                     */
+                    template<typename get_partial_func>
+                    void publish_if_due(get_partial_func get_partial) {
+                        if(m_publisher && is_limited() && !is_exceeded()) {
+                            const double start = get_elapsed();
+                            if((start - m_last_publish >= max(MIN_PUBLISH_PERIOD, PUBLISH_RATIO * m_publish_time)) &&
+                                    ((m_seconds <= 0) || (start + m_publish_time + m_reserve < m_seconds))) {
+                                m_publisher(get_partial());
+                                m_last_publish = get_elapsed();
+                                m_publish_time = m_last_publish - start;
+                            }
+                        }
+                    }
+
+                private:
+                    //The number of calls of is_exceeded between two reads of the memory usage
+                    static constexpr uint32_t MEM_CHECK_PERIOD = 256;
+                    //The minimum time between two publications in seconds
+                    static constexpr double MIN_PUBLISH_PERIOD = 1.0;
+                    //The minimum ratio of the time between two publications to their duration
+                    static constexpr double PUBLISH_RATIO = 4.0;
+                    //Stores the wall time budget in seconds, 0 for unlimited
+                    const double m_seconds;
+                    //Stores the resident memory budget in Mb, 0 for unlimited
+                    const uint32_t m_mem_mb;
+                    //Stores the time kept for the work after the search in seconds
+                    double m_reserve;
+                    //Stores the time the budget was created
+                    const chrono::steady_clock::time_point m_start;
+                    //Stores the number of memory checks
+                    uint64_t m_num_checks;
+                    //Stores whether the budget is used up
+                    bool m_is_exceeded;
+                    //Stores the function keeping the published controllers
+                    function<void(const BDD &)> m_publisher;
+                    //Stores the elapsed time at the end of the last publication
+                    double m_last_publish;
+                    //Stores the duration of the last publication in seconds
+                    double m_publish_time;
+                };
+
+            }
+        }
+    }
+}
+
+#endif /* DET_BUDGET_HPP */
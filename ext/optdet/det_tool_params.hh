@@ -48,6 +48,17 @@ namespace tud {
                     det_alg_size = bdd_mixed + 1
                 };
 
+                /**
+                 * The enumeration storing the ways to choose the order in
+                 * which the determinization tree splits the dimensions
+                 */
+                enum split_order_enum {
+                    round_robin      = 0,
+                    greedy           = round_robin + 1,
+                    search           = greedy + 1,
+                    split_order_size = search + 1
+                };
+
                 /**
                  * This structure stores the tool's input parameters
                  */
@@ -78,6 +89,14 @@ namespace tud {
                     bool m_is_bdd_lin;
                     //Defines the determinization algorithm to be used
                     det_alg_enum m_det_alg_type;
+                    //The CUDD manager memory budget in Mb, 0 for unlimited
+                    uint32_t m_mem_budget;
+                    //Defines how the determinization tree split order is chosen
+                    split_order_enum m_split_order;
+                    //The wall time budget of the determinization in seconds, 0 for unlimited
+                    double m_budget_seconds;
+                    //The resident memory budget of the determinization in Mb, 0 for unlimited
+                    uint32_t m_budget_mb;
 
                     /**
                      * Allows to set the determinization algorithm type
@@ -107,6 +126,34 @@ namespace tud {
                         }
                     }
 
+                    /**
+                     * Allows to set the way the determinization tree split order is chosen
+                     * @param split_order the string defining the split order
+                     */
+                    void set_split_order(const string split_order) {
+                        if(split_order == "round-robin") {
+                            m_split_order = split_order_enum::round_robin;
+                        } else {
+                            if(split_order == "greedy") {
+                                m_split_order = split_order_enum::greedy;
+                            } else {
+                                if(split_order == "search") {
+                                    m_split_order = split_order_enum::search;
+                                } else {
+                                    THROW_EXCEPTION(string("Unknown split order: '") + split_order + string("'!"));
+                                }
+                            }
+                        }
+                    }
+
+                    /**
+                     * Allows to get the possible values for the split order
+                     */
+                    static inline vector<string> & get_split_orders() {
+                        static vector<string> split_orders = {"round-robin", "greedy", "search"};
+                        return split_orders;
+                    }
+
                     /**
                      * Allows to get the possible values for the determiniation algorithms
                      */
@@ -40,6 +40,7 @@
 #include "logger.hh"
 #include "string_utils.hh"
 #include "monitor.hh"
+#include "det_budget.hh"
 
 using namespace std;
 using namespace scots;
@@ -82,7 +83,7 @@ namespace tud {
                      * method. The process is to be finalized by calling on points_finished.
                      */
                     greedy_estimator()
-                    : m_p_inp_sets(NULL), m_inp_to_st() {
+                    : m_p_inp_sets(NULL), m_inp_to_st(), m_st_to_cnt() {
                         LOG_DEBUG3 << "Creating greedy estimator: " << this << END_LOG;
                     }
 
@@ -125,9 +126,6 @@ namespace tud {
                         
                         LOG_INFO << "The number of distinct set-cover state ids: " << inp_sets.size() << END_LOG;
                         
-                        //Get access to static variable storing the internal state id to actual states count
-                        map_id_to_cnt & st_to_cnt = get_st_to_cnt();
-                        
                         //Iterate over distinct sets of inputs and create abstract states to work with
                         //The number of the abstract states will be much less than those of the original
                         //Each abstract state represents a set of states that fall under different inputs
@@ -152,7 +150,7 @@ namespace tud {
                             }
                             
                             //Store the number of actual states corresponding to the internal state
-                            st_to_cnt[state_id] = elems.second;
+                            m_st_to_cnt[state_id] = elems.second;
                             //Get the next state id
                             state_id++;
                         }
@@ -177,9 +175,15 @@ namespace tud {
                     
                     /**
                      * Allows to compute the greedy estimate for the determinization sequence.
+                     * If the budget is used up the rounds stop, the sequence then only
+                     * determinizes the states covered so far.
                      * @param det_seq the greedy estimate of the determinization sequence
+                     * @param p_budget the determinization budget, NULL for unlimited
+                     * @param on_round if set, called at the end of every round
+                     * @return true if all states are covered, false if the budget was used up
                      */
-                    inline void compute_greedy_estimate(vector<abs_type> & det_seq) {
+                    inline bool compute_greedy_estimate(vector<abs_type> & det_seq, det_budget * p_budget = NULL,
+                                                        const function<void()> & on_round = function<void()>()) {
                         LOG_DEBUG1 << "Start computing the minimum set cover..." << END_LOG;
                         
                         //Create the set of abstract states that are to be covered
@@ -205,6 +209,13 @@ namespace tud {
                         set<abs_type> covered_states;
                         //Define the end number of inputs
                         while(covered_states != all_states) {
+                            //Stop with the rounds done so far if the budget is used up
+                            if((p_budget != NULL) && p_budget->is_exceeded()) {
+                                LOG_USAGE << "Stopped the greedy rounds after " << det_seq.size()
+                                          << " inputs" << END_LOG;
+                                return false;
+                            }
+                            
                             //Declare the variable to store the maximum set's input id
                             abs_type input_id = 0;
                             
@@ -241,7 +252,13 @@ namespace tud {
                             
                             //Erase the chosen element from the set
                             m_inp_to_st.erase(input_id);
+                            
+                            //Notify about the end of the round
+                            if(on_round) {
+                                on_round();
+                            }
                         }
+                        return true;
                     }
                     
                 protected:                    
@@ -255,16 +272,8 @@ namespace tud {
                     //and the input sets that overlap with some other ones.
                     map_id_to_ids m_inp_to_st;
                     
-                    /**
-                     * Allows to get access to static function container variable
-                     * @return the reference to a static function variable
-                     */
-                    static map_id_to_cnt & get_st_to_cnt() {
-                        //Stores the intarnal state to number of actual states mapping
-                        static map_id_to_cnt st_to_cnt;
-                        
-                        return st_to_cnt;
-                    }
+                    //Stores the internal state to number of actual states mapping
+                    map_id_to_cnt m_st_to_cnt;
                     
                     /**
                      * Seaches for the input with the largest set of states
@@ -321,17 +330,14 @@ namespace tud {
                      * @return the number of actual states corresponding to the internal states
                      */
                     inline size_t count_act_states(const set<abs_type> & states) {
-                        //Access the variable storing the internal to actual states counts
-                        map_id_to_cnt & st_to_cnt = get_st_to_cnt();
-                        
                         //Couns actual states
                         size_t set_size = 0;
                         for(auto state_id : states) {
-                            ASSERT_SANITY_THROW((st_to_cnt.find(state_id) == st_to_cnt.end()),
+                            ASSERT_SANITY_THROW((m_st_to_cnt.find(state_id) == m_st_to_cnt.end()),
                                                 string("Unable to find count for state: ")
                                                 + to_string(state_id));
                             
-                            set_size += st_to_cnt.at(state_id);
+                            set_size += m_st_to_cnt.at(state_id);
                         }
                         return set_size;
                     }
@@ -29,6 +29,7 @@
 #include <string>
 #include <set>
 #include <vector>
+#include <functional>
 
 #include "scots.hh"
 
@@ -40,6 +41,7 @@
 #include "inputs_mgr.hh"
 #include "states_mgr.hh"
 #include "greedy_estimator.hh"
+#include "det_budget.hh"
 
 using namespace std;
 using namespace scots;
@@ -67,8 +69,10 @@ namespace tud {
                      * The basic constructor
                      * @param cudd_mgr the cudd manager to be used
                      * @param input_ctrl the controller's data
+                     * @param p_budget the determinization budget, NULL for unlimited
                      */
-                    greedy_optimizer(const Cudd & cudd_mgr, const ctrl_data & input_ctrl)
+                    greedy_optimizer(const Cudd & cudd_mgr, const ctrl_data & input_ctrl,
+                                     det_budget * p_budget = NULL)
                     : m_cudd_mgr(cudd_mgr),
                     m_ctrl_bdd(input_ctrl.m_ctrl_bdd),
                     m_ctrl_set(input_ctrl.m_ctrl_set),
@@ -76,7 +80,7 @@ namespace tud {
                     m_ss_mgr(input_ctrl.m_ctrl_set, input_ctrl.m_ss_dim,
                              input_ctrl.m_ctrl_bdd, m_cudd_mgr,
                              m_is_mgr.get_inputs_set()),
-                    m_det_est() {
+                    m_det_est(), m_p_budget(p_budget), m_is_complete(true) {
                         //Declare the statistics data
                         DECLARE_MONITOR_STATS;
                         
@@ -84,18 +88,11 @@ namespace tud {
                         
                         //Get the beginning statistics data
                         INITIALIZE_STATS;
-                        //Make local constants for dimensions
-                        const int ss_dim = m_ss_mgr.get_dim();
-                        
                         //Get the number the states with inputs
-                        raw_data all_states = m_ss_mgr.get_points();
-                        
-                        //Get the number of states
-                        const int num_states = all_states.size() / ss_dim;
+                        const size_t num_states = m_ss_mgr.get_size();
                         LOG_INFO << "The number of states with inputs is: " << num_states << END_LOG;
                         
                         //Pre-declare containers
-                        raw_data state(ss_dim);
                         set<abs_type> input_ids;
                         
                         //Start the initial estimator creation
@@ -103,24 +100,28 @@ namespace tud {
                         
                         //Iterate orver the states, get the corresponding
                         //inputs and add them to the estimator set by ids
-                        auto state_begin = all_states.begin();
-                        for(int i = 0; i < num_states; ++i) {
-                            //Get a new state vector
-                            state.assign(state_begin, state_begin + ss_dim);
-                            //Get the state id
-                            abs_type state_id = m_ss_mgr.xtoi(state);
-                            
-                            //Get the list of inputs
-                            raw_data state_inputs = m_ctrl_set.restriction(m_cudd_mgr, m_ctrl_bdd, state);
-                            
-                            //Convert inputs to input ids
-                            m_is_mgr.get_input_ids(state_inputs, input_ids);
-                            
-                            //Add the state with its inputs into the estimator
-                            m_det_est.add_point(state_id, input_ids);
-                            
-                            //Move forward in the list of states
-                            state_begin += ss_dim;
+                        try {
+                            m_ss_mgr.for_each_point([&](const raw_data & state) {
+                                //Stop adding states if the budget is used up
+                                if(m_p_budget != NULL) {
+                                    m_p_budget->check();
+                                }
+                                
+                                //Get the state id
+                                abs_type state_id = m_ss_mgr.xtoi(state);
+                                
+                                //Get the list of inputs
+                                raw_data state_inputs = m_ctrl_set.restriction(m_cudd_mgr, m_ctrl_bdd, state);
+                                
+                                //Convert inputs to input ids
+                                m_is_mgr.get_input_ids(state_inputs, input_ids);
+                                
+                                //Add the state with its inputs into the estimator
+                                m_det_est.add_point(state_id, input_ids);
+                            });
+                        } catch (const budget_exceeded &) {
+                            LOG_USAGE << "Stopped adding states to the determinizer" << END_LOG;
+                            m_is_complete = false;
                         }
                         
                         //Finalize the initial estimator creation
@@ -136,6 +137,15 @@ namespace tud {
                     virtual ~greedy_optimizer() {
                     }
                     
+                    /**
+                     * Allows to check if the resulting controller is deterministic, it
+                     * is not if the budget was used up before the optimization finished
+                     * @return true if every state got a single input
+                     */
+                    bool is_complete() const {
+                        return m_is_complete;
+                    }
+                    
                     /**
                      * Allows to optimize the controller by performing determinization in
                      * such a way that it minimizes the resulting BDD size.
@@ -155,12 +165,31 @@ namespace tud {
                         
                         //Just use the bold greedy estimate for the determinization sequence
                         vector<abs_type> result;
-                        m_det_est.compute_greedy_estimate(result);
+                        //With a budget publish the controller of the rounds done so far,
+                        //the inputs of the new rounds are applied to the last one
+                        BDD partial = m_ctrl_bdd;
+                        size_t num_applied = 0;
+                        function<void()> on_round;
+                        if(m_p_budget != NULL) {
+                            on_round = [&]() {
+                                m_p_budget->publish_if_due([&]() -> BDD {
+                                    for(; num_applied < result.size(); ++num_applied) {
+                                        partial = determinize(partial, result[num_applied]);
+                                    }
+                                    return partial;
+                                });
+                            };
+                        }
+                        m_is_complete &= m_det_est.compute_greedy_estimate(result, m_p_budget, on_round);
 
                         LOG_INFO << "Found determinization: " << vector_to_string(result) << END_LOG;
 
-                        //Compute the determinization of the original BDD
-                        output_ctrl.m_ctrl_bdd = determinize(result);
+                        //Compute the determinization of the original BDD, going on
+                        //from the inputs applied for the last publication
+                        for(; num_applied < result.size(); ++num_applied) {
+                            partial = determinize(partial, result[num_applied]);
+                        }
+                        output_ctrl.m_ctrl_bdd = partial;
                         
                         //Get the end stats and log them
                         REPORT_STATS(string("Determinizing BDD"));
@@ -193,19 +222,6 @@ namespace tud {
                         return (ctrl_bdd & not_states_input_bdd);
                     }
                     
-                    /**
-                     * Allows to determnize a given controller BDD with a determinization sequence
-                     * @param det_seq the determinization sequence
-                     * @return the resulting BDD
-                     */
-                    inline BDD determinize(const vector<abs_type> & det_seq) {
-                        BDD result = m_ctrl_bdd;
-                        for(abs_type input_id : det_seq) {
-                            result = determinize(result, input_id);
-                        }
-                        return result;
-                    }
-                    
                 private:
                     //Stores the reference to the CUDD manage
                     const Cudd & m_cudd_mgr;
@@ -219,6 +235,10 @@ namespace tud {
                     states_mgr m_ss_mgr;
                     //Stores the greedy estimator
                     greedy_estimator m_det_est;
+                    //Stores the determinization budget, NULL for unlimited
+                    det_budget * m_p_budget;
+                    //Stores whether the optimization finished within the budget
+                    bool m_is_complete;
                 };
 
             }
@@ -36,6 +36,7 @@
 #include "logger.hh"
 #include "monitor.hh"
 
+#include "cudd_mgr.hh"
 #include "inputs_mgr.hh"
 #include "states_mgr.hh"
 
@@ -61,9 +62,11 @@ namespace tud {
                     
                     /**
                      * The basic constructor
+                     * @param source_file the controller's file name used to size the CUDD manager
+                     * @param mem_budget the CUDD manager memory budget in Mb, 0 for unlimited
                      */
-                    input_ctrl_data()
-                    : m_ss_dim(0), m_cudd_mgr(),
+                    input_ctrl_data(const string & source_file, const uint32_t mem_budget)
+                    : m_ss_dim(0), m_cudd_mgr(create_cudd_mgr(source_file, mem_budget)),
                     m_ctrl_set(), m_ctrl_bdd() {
                         //Disable automatic variable ordering
                         m_cudd_mgr.AutodynDisable();
@@ -173,11 +176,11 @@ namespace tud {
                         //Get the inputs set reference
                         const SymbolicSet & is_set = is_mgr.get_inputs_set();
                         
-                        //Get the vector of input points
-                        vector<double> state_inputs = is_set.bdd_to_grid_points(m_cudd_mgr, is_bdd);
-                        
-                        //Convert inputs to input ids
-                        is_mgr.get_input_ids(state_inputs, input_ids);
+                        //Get the input ids straight from the cubes of the BDD
+                        input_ids.clear();
+                        is_set.for_each_id(m_cudd_mgr, is_bdd, [&input_ids](const abs_type id) {
+                            input_ids.insert(id);
+                        });
                     }
                     
                     /**
@@ -210,6 +213,8 @@ namespace tud {
                         LOG_USAGE << "Starting final BDD variable reordering..." << END_LOG;
                         //Get the beginning statistics data
                         INITIALIZE_STATS;
+                        //Release the cached grid point BDDs, they would slow down the sifting
+                        m_ctrl_set.clear_caches();
                         //Reduce the BDDs using sifting
                         m_cudd_mgr.ReduceHeap(CUDD_REORDER_SIFT, 0);
                         //Get the end stats and log them
@@ -219,6 +224,13 @@ namespace tud {
                                    << m_ctrl_bdd.nodeCount() << END_LOG;
                     }
                     
+                    /**
+                     * Allows to report on the CUDD manager usage statistics
+                     */
+                    void report_mgr_stats() const {
+                        report_cudd_mgr_stats(m_cudd_mgr);
+                    }
+                    
                     /**
                      * The basic constructor
                      */
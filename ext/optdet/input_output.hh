@@ -31,6 +31,7 @@
 #include <fstream>
 #include <cfloat>
 #include <algorithm>
+#include <numeric>
 
 #include "scots.hh"
 
@@ -622,9 +623,16 @@ namespace tud {
                      */
                     static inline abs_type compute_max_bdd_id(const size_t max_sco_id,
                                                               const bdd_decoder<true> & decoder) {
+                        //The number of ids converted at once
+                        const size_t BATCH_SIZE = 4096;
                         abs_type max_bdd_id = 0;
-                        for(abs_type sco_id = 0; sco_id <= max_sco_id; ++ sco_id) {
-                            max_bdd_id = max(max_bdd_id, decoder.itob(sco_id));
+                        vector<abs_type> sco_ids, bdd_ids;
+                        for(size_t first_id = 0; first_id <= max_sco_id; first_id += BATCH_SIZE) {
+                            //Convert the next batch of ids
+                            sco_ids.resize(min(BATCH_SIZE, max_sco_id + 1 - first_id));
+                            iota(sco_ids.begin(), sco_ids.end(), first_id);
+                            decoder.itob(sco_ids, bdd_ids);
+                            max_bdd_id = max(max_bdd_id, *max_element(bdd_ids.begin(), bdd_ids.end()));
                         }
                         return max_bdd_id;
                     }
@@ -645,15 +653,9 @@ namespace tud {
                                                         Cudd & ext_cudd_mgr,
                                                         SymbolicSet & ext_ctrl_set,
                                                         BDD & ext_ctrl_bdd) {
-                        //Get the controller's dimensions
-                        const size_t ctrl_dim = ini_ctrl_set.get_dim();
-                        
                         //Disabled automatic variable ordering
                         ext_cudd_mgr.AutodynDisable();
                         
-                        //Get the grid points from the determinized controller.
-                        raw_data data = ini_ctrl_set.bdd_to_grid_points(ini_cudd_mgr, ini_ctrl_bdd);
-                        
                         LOG_DEBUG << "ext_ctrl_set, ll: " << vector_to_string(ext_ctrl_set.get_lower_left())
                         << ", ur: " << vector_to_string(ext_ctrl_set.get_upper_right())
                         << ", eta: " << vector_to_string(ext_ctrl_set.get_eta()) << END_LOG;
@@ -662,20 +664,17 @@ namespace tud {
                         << ", ur: " << vector_to_string(ini_ctrl_set.get_upper_right())
                         << ", eta: " << vector_to_string(ini_ctrl_set.get_eta()) << END_LOG;
                         
-                        //Convert the grid points to the ids and then bdds and append to the extended bdd
-                        auto iter = data.begin();
-                        while(iter != data.end()){
-                            //Get the next controller grid point
-                            auto next_iter = iter + ctrl_dim;
-                            raw_data point(iter, next_iter);
-                            
+                        //Convert the grid points of the determinized controller to the ids
+                        //and then bdds and append to the extended bdd, one cube at a time
+                        ini_ctrl_set.for_each_grid_point(ini_cudd_mgr, ini_ctrl_bdd,
+                                [&](const raw_data & point) {
                             //Add the grid point to the extended space BDD
                             abs_type point_id = ext_ctrl_set.xtoi(point);
                             ext_ctrl_bdd |= ext_ctrl_set.id_to_bdd(point_id);
-                            
-                            //Move on to the next point
-                            iter = next_iter;
-                        }
+                        });
+                        
+                        //Release the cached grid point BDDs, they would slow down the sifting
+                        ext_ctrl_set.clear_caches();
                         
                         //Reduce the BDDs using sifting
                         ext_cudd_mgr.ReduceHeap(CUDD_REORDER_SIFT, 0);
@@ -820,6 +819,9 @@ namespace tud {
                         //Get the beginning statistics data
                         INITIALIZE_STATS;
                         
+                        //Release the cached grid point BDDs, they would slow down the sifting
+                        ini_ctrl_set.clear_caches();
+                        
                         //Reduce the BDDs using sifting
                         ini_cudd_mgr.ReduceHeap(CUDD_REORDER_SIFT, 0);
                         
@@ -54,6 +54,8 @@ namespace tud {
                     bool m_is_reorder;
                     //Stores the over and undershoot points percent
                     float m_overs_pct;
+                    //The CUDD manager memory budget in Mb, 0 for unlimited
+                    uint32_t m_mem_budget;
                 };
             }
         }
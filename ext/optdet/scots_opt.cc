@@ -0,0 +1,299 @@
+/*
+ * File:   scots_opt.cc
+ * Author: Antonio Rueda
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <functional>
+
+// SCOTS header
+#include "scots.hh"
+
+#include "exceptions.hh"
+#include "logger.hh"
+#include "monitor.hh"
+
+#include "scots_opt.hh"
+
+#include "cudd_mgr.hh"
+#include "input_output.hh"
+#include "greedy_optimizer.hh"
+#include "space_optimizer.hh"
+
+using namespace std;
+using namespace scots;
+
+using namespace tud::utils::logging;
+using namespace tud::utils::exceptions;
+using namespace tud::utils::monitor;
+
+namespace tud {
+    namespace ctrl {
+        namespace scots {
+            namespace optimal {
+
+                det_context::det_context(const det_tool_params & params)
+                : m_params(params),
+                m_cudd_mgr(create_cudd_mgr(params.m_source_file, params.m_mem_budget)),
+                m_input_ctrl(), m_output_ctrl(),
+                m_budget(params.m_budget_seconds, params.m_budget_mb) {
+                    //Disable automatic variable ordering
+                    m_cudd_mgr.AutodynDisable();
+                    
+                    //Load the controller's BDD into the structure
+                    load_controller_bdd(m_cudd_mgr, m_params.m_source_file, m_params.m_ss_dim, m_input_ctrl);
+                }
+
+                det_context::det_context(const det_tool_params & params, const Cudd & src_cudd_mgr,
+                                         const ctrl_data & src_ctrl)
+                : m_params(params),
+                m_cudd_mgr(create_cudd_mgr(params.m_source_file, params.m_mem_budget)),
+                m_input_ctrl(), m_output_ctrl(),
+                m_budget(params.m_budget_seconds, params.m_budget_mb) {
+                    //Disable automatic variable ordering
+                    m_cudd_mgr.AutodynDisable();
+                    
+                    //Re-create the BDD intervals with the same variable ids in this manager, as when reading
+                    vector<IntegerInterval<abs_type>> intervals;
+                    for(const IntegerInterval<abs_type> & ivl : src_ctrl.m_ctrl_set.get_bdd_intervals()) {
+                        intervals.emplace_back(m_cudd_mgr, abs_type{0}, ivl.get_ub(), ivl.get_bdd_var_ids());
+                    }
+                    
+                    //Copy the controller over, the variable ids stay the same
+                    LOG_INFO << "Transferring the controller of " << src_cudd_mgr.ReadSize()
+                    << " BDD variables" << END_LOG;
+                    m_input_ctrl.m_ss_dim = src_ctrl.m_ss_dim;
+                    m_input_ctrl.m_ctrl_set = SymbolicSet(static_cast<const UniformGrid &>(src_ctrl.m_ctrl_set), intervals);
+                    m_input_ctrl.m_ctrl_bdd = src_ctrl.m_ctrl_bdd.Transfer(m_cudd_mgr);
+                }
+
+                void det_context::determinize() {
+                    //Declare the statistics data
+                    DECLARE_MONITOR_STATS;
+                    
+                    LOG_USAGE << "Starting the BDD determinization ..." << END_LOG;
+                    
+                    //Get the beginning statistics data
+                    INITIALIZE_STATS;
+                    
+                    //With a budget store a valid controller right away
+                    BDD first_bdd;
+                    if(m_budget.is_limited()) {
+                        const double first_start = m_budget.get_elapsed();
+                        m_output_ctrl.m_ctrl_set = m_input_ctrl.m_ctrl_set;
+                        m_output_ctrl.m_ctrl_bdd = first_input(m_input_ctrl.m_ctrl_bdd);
+                        first_bdd = m_output_ctrl.m_ctrl_bdd;
+                        LOG_RESULT << "First input controller size: #nodes: " << first_bdd.nodeCount()
+                        << ", after " << m_budget.get_elapsed() << " seconds" << END_LOG;
+                        store_output();
+                        //Converting and completing the partial result take about as long as this
+                        m_budget.set_reserve(2 * (m_budget.get_elapsed() - first_start));
+                    }
+                    
+                    //With a budget the optimizers publish their partial results from time
+                    //to time, these are completed and stored if smaller than the best one
+                    BDD best_bdd = first_bdd;
+                    if(m_budget.is_limited()) {
+                        m_budget.set_publisher([&](const BDD & partial) {
+                            const BDD ctrl_bdd = complete(partial);
+                            LOG_RESULT << "Intermediate controller size: #nodes: " << ctrl_bdd.nodeCount()
+                            << ", after " << m_budget.get_elapsed() << " seconds" << END_LOG;
+                            if(ctrl_bdd.nodeCount() < best_bdd.nodeCount()) {
+                                best_bdd = ctrl_bdd;
+                                m_output_ctrl.m_ctrl_bdd = best_bdd;
+                                store_output();
+                            }
+                        });
+                    }
+                    
+                    //Choose the determinization algorithm
+                    bool is_complete = true;
+                    switch(m_params.m_det_alg_type) {
+                        case det_alg_enum::local: {
+                            //Initialize the optimizer class instance
+                            space_optimizer<space_tree_sco<false>> opt(m_cudd_mgr, m_input_ctrl, m_params.m_split_order, &m_budget);
+                            //Optimize by determinization
+                            opt.optimize(m_output_ctrl);
+                            is_complete = opt.is_complete();
+                            break;
+                        }
+                        case det_alg_enum::bdd_local: {
+                            //Initialize the optimizer class instance
+                            space_optimizer<space_tree_bdd<false>> opt(m_cudd_mgr, m_input_ctrl, m_params.m_split_order, &m_budget);
+                            //Optimize by determinization
+                            opt.optimize(m_output_ctrl);
+                            is_complete = opt.is_complete();
+                            break;
+                        }
+                        case det_alg_enum::global: {
+                            //Initialize the optimizer class instance
+                            greedy_optimizer opt(m_cudd_mgr, m_input_ctrl, &m_budget);
+                            //Optimize by determinization
+                            opt.optimize(m_output_ctrl);
+                            is_complete = opt.is_complete();
+                            break;
+                        }
+                        case det_alg_enum::mixed: {
+                            //Initialize the optimizer class instance
+                            space_optimizer<space_tree_sco<true>> opt(m_cudd_mgr, m_input_ctrl, m_params.m_split_order, &m_budget);
+                            //Optimize by determinization
+                            opt.optimize(m_output_ctrl);
+                            is_complete = opt.is_complete();
+                            break;
+                        }
+                        case det_alg_enum::bdd_mixed: {
+                            //Initialize the optimizer class instance
+                            space_optimizer<space_tree_bdd<true>> opt(m_cudd_mgr, m_input_ctrl, m_params.m_split_order, &m_budget);
+                            //Optimize by determinization
+                            opt.optimize(m_output_ctrl);
+                            is_complete = opt.is_complete();
+                            break;
+                        }
+                        default: {
+                            THROW_EXCEPTION(string("Unsupported determinization algorithm type: ")
+                                            + to_string(m_params.m_det_alg_type));
+                        }
+                    }
+                    //The publisher refers to the local best controller
+                    m_budget.set_publisher(function<void(const BDD &)>());
+                    
+                    //Complete the partial result and keep the smaller controller, the
+                    //result is only partial if the budget was used up
+                    if(!is_complete) {
+                        if((m_output_ctrl.m_ctrl_bdd == m_cudd_mgr.bddZero()) ||
+                           (m_output_ctrl.m_ctrl_bdd == m_input_ctrl.m_ctrl_bdd)) {
+                            //Nothing was determinized yet
+                            m_output_ctrl.m_ctrl_bdd = best_bdd;
+                        } else {
+                            LOG_USAGE << "Completing the controller with the first inputs ..." << END_LOG;
+                            m_output_ctrl.m_ctrl_bdd = complete(m_output_ctrl.m_ctrl_bdd);
+                        }
+                    }
+                    if(m_budget.is_limited()) {
+                        LOG_RESULT << "Optimized controller size: #nodes: " << m_output_ctrl.m_ctrl_bdd.nodeCount()
+                        << (is_complete ? "" : " (completed)") << ", after " << m_budget.get_elapsed()
+                        << " seconds" << END_LOG;
+                        if(best_bdd.nodeCount() < m_output_ctrl.m_ctrl_bdd.nodeCount()) {
+                            LOG_USAGE << "Keeping the smaller stored controller" << END_LOG;
+                            m_output_ctrl.m_ctrl_bdd = best_bdd;
+                        }
+                    }
+                    
+                    //Get the end stats and log them
+                    REPORT_STATS(string("BDD determinization"));
+                    
+                    LOG_RESULT << "Resulting controller size, original: "
+                    << "#nodes: " << m_output_ctrl.m_ctrl_bdd.nodeCount()
+                    << ", #paths: " << m_output_ctrl.m_ctrl_bdd.CountPath() << END_LOG;
+                }
+
+                void det_context::store() {
+                    //Store the determinized controller
+                    store_output();
+                    
+                    LOG_INFO2 << "Deleting the original controller BDD" << END_LOG;
+                    //First delete the input BDD
+                    m_input_ctrl.m_ctrl_bdd &= m_cudd_mgr.bddZero();
+                    
+                    //The compressed versions are only made within the budget
+                    if(m_budget.is_exceeded()) {
+                        LOG_USAGE << "The budget is used up, skipping the compressed controllers" << END_LOG;
+                        report_cudd_mgr_stats(m_cudd_mgr);
+                        return;
+                    }
+                    
+                    //Store different options
+                    if(m_params.m_is_reorder) {
+                        store_compressed(store_type_enum::reorder);
+                    }
+                    if(m_params.m_is_extend) {
+                        store_compressed(store_type_enum::extend);
+                    }
+                    if(m_params.m_is_sco_const) {
+                        store_compressed(store_type_enum::sco_const);
+                    }
+                    if(m_params.m_is_sco_lin) {
+                        store_compressed(store_type_enum::sco_lin);
+                    }
+                    if(m_params.m_is_bdd_const) {
+                        store_compressed(store_type_enum::bdd_const);
+                    }
+                    if(m_params.m_is_bdd_lin) {
+                        store_compressed(store_type_enum::bdd_lin);
+                    }
+
+                    //Report on the CUDD manager usage
+                    report_cudd_mgr_stats(m_cudd_mgr);
+                }
+
+                BDD det_context::first_input(BDD ctrl_bdd) const {
+                    //Get the input BDD variables, most significant bit of the first dimension first
+                    const vector<IntegerInterval<abs_type>> intervals = m_input_ctrl.m_ctrl_set.get_bdd_intervals();
+                    vector<BDD> input_vars;
+                    BDD U = m_cudd_mgr.bddOne();
+                    for(size_t dim = m_input_ctrl.m_ss_dim; dim < intervals.size(); ++dim) {
+                        for(const auto & id : intervals[dim].get_bdd_var_ids()) {
+                            input_vars.push_back(m_cudd_mgr.bddVar(id));
+                            U &= input_vars.back();
+                        }
+                    }
+                    //Keep the zero value of each bit for the states that have it
+                    for(const BDD & var : input_vars) {
+                        const BDD zero_states = (ctrl_bdd & !var).ExistAbstract(U);
+                        ctrl_bdd &= !(var & zero_states);
+                    }
+                    return ctrl_bdd;
+                }
+
+                BDD det_context::complete(const BDD & ctrl_bdd) const {
+                    //Get the cube of the input BDD variables
+                    const vector<IntegerInterval<abs_type>> intervals = m_input_ctrl.m_ctrl_set.get_bdd_intervals();
+                    BDD U = m_cudd_mgr.bddOne();
+                    for(size_t dim = m_input_ctrl.m_ss_dim; dim < intervals.size(); ++dim) {
+                        for(const auto & id : intervals[dim].get_bdd_var_ids()) {
+                            U &= m_cudd_mgr.bddVar(id);
+                        }
+                    }
+                    //The valid pairs of the partial result and the states it does not cover
+                    const BDD valid = ctrl_bdd & m_input_ctrl.m_ctrl_bdd;
+                    const BDD rest = m_input_ctrl.m_ctrl_bdd & !valid.ExistAbstract(U);
+                    return first_input(valid | rest);
+                }
+
+                void det_context::store_output() {
+                    LOG_USAGE << "Storing controller '" << m_params.m_target_file << "' ..." << END_LOG;
+                    
+                    //Store the controller's BDD into the file
+                    store_controller(m_cudd_mgr, m_output_ctrl.m_ctrl_set,
+                                     m_output_ctrl.m_ctrl_bdd, m_params.m_target_file);
+                }
+
+                void det_context::store_compressed(const store_type_enum type) {
+                    store_min_controller(m_cudd_mgr, m_output_ctrl.m_ctrl_set,
+                                         m_output_ctrl.m_ctrl_bdd,
+                                         m_params.m_target_file,
+                                         type, m_params.m_ss_dim);
+                }
+
+                void determinize(const det_tool_params & params) {
+                    det_context context(params);
+                    context.determinize();
+                    context.store();
+                }
+            }
+        }
+    }
+}
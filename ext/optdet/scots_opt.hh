@@ -0,0 +1,146 @@
+/*
+ * File:   scots_opt.hh
+ * Author: Antonio Rueda
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCOTS_OPT_LIB_HPP
+#define SCOTS_OPT_LIB_HPP
+
+#include "scots.hh"
+
+#include "exceptions.hh"
+#include "logger.hh"
+
+#include "ctrl_data.hh"
+#include "det_tool_params.hh"
+#include "input_output.hh"
+#include "det_budget.hh"
+
+using namespace std;
+using namespace scots;
+
+namespace tud {
+    namespace ctrl {
+        namespace scots {
+            namespace optimal {
+
+                /**
+                 * This class is the determinization context of one controller, it owns the
+                 * CUDD manager and all the controller data. It does not use any global state
+                 * other than the logger, so several contexts can determinize concurrently,
+                 * each on its own thread.
+                 */
+                class det_context {
+                public:
+
+                    /**
+                     * The basic constructor, creates the CUDD manager
+                     * and loads the source controller into it
+                     * @param params the determinization parameters
+                     */
+                    det_context(const det_tool_params & params);
+
+                    /**
+                     * The constructor from an already loaded controller, creates the
+                     * CUDD manager and transfers the source controller into it. Several
+                     * contexts can be created from one controller this way, but not
+                     * concurrently as the transfer reads the source manager.
+                     * @param params the determinization parameters
+                     * @param src_cudd_mgr the CUDD manager of the source controller
+                     * @param src_ctrl the source controller
+                     */
+                    det_context(const det_tool_params & params, const Cudd & src_cudd_mgr,
+                                const ctrl_data & src_ctrl);
+
+                    /**
+                     * Performs the determinization of the controller. With a time or
+                     * memory budget the controller that takes the first input of every
+                     * state is stored first. The partial results the optimizer publishes
+                     * at the end of its stages and rounds are completed with the first
+                     * inputs and stored if they are smaller. The optimizer stops once the
+                     * budget is used up, its result is completed the same way and the
+                     * smallest of the stored and the final controllers is kept.
+                     */
+                    void determinize();
+
+                    /**
+                     * Stores the determinized controller and its compressed
+                     * versions as requested by the parameters
+                     */
+                    void store();
+
+                    /**
+                     * Stores the determinized controller into the target file
+                     */
+                    void store_output();
+
+                    /**
+                     * Stores one compressed version of the determinized controller,
+                     * the file name is the target file with the suffix of the type
+                     * @param type the compression type
+                     */
+                    void store_compressed(const store_type_enum type);
+
+                    /**
+                     * Allows to get the determinized controller
+                     * @return the determinized controller
+                     */
+                    const ctrl_data & get_output_ctrl() const {
+                        return m_output_ctrl;
+                    }
+
+                private:
+
+                    /**
+                     * Determinizes the controller by taking the first input of every
+                     * state in the order of the input BDD variables
+                     * @param ctrl_bdd the controller to determinize
+                     * @return the deterministic controller
+                     */
+                    BDD first_input(BDD ctrl_bdd) const;
+
+                    /**
+                     * Completes the partial result of an optimizer that was stopped
+                     * by the budget: its valid state-input pairs are kept, the first
+                     * input is taken for the other states of the source controller
+                     * @param ctrl_bdd the partial result of the optimizer
+                     * @return the deterministic controller
+                     */
+                    BDD complete(const BDD & ctrl_bdd) const;
+
+                    //Stores the determinization parameters
+                    const det_tool_params m_params;
+                    //Stores the CUDD manager, it must outlive the controllers
+                    Cudd m_cudd_mgr;
+                    //Stores the source controller
+                    ctrl_data m_input_ctrl;
+                    //Stores the determinized controller
+                    ctrl_data m_output_ctrl;
+                    //Stores the determinization budget
+                    det_budget m_budget;
+                };
+
+                /**
+                 * Loads, determinizes and stores the controller in its own context
+                 * @param params the determinization parameters
+                 */
+                void determinize(const det_tool_params & params);
+            }
+        }
+    }
+}
+
+#endif /* SCOTS_OPT_LIB_HPP */
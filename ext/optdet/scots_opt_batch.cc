@@ -0,0 +1,175 @@
+/*
+ * File:   scots_opt_batch.cc
+ * Author: Antonio Rueda
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atomic>
+
+// SCOTS header
+#include "scots.hh"
+
+#include "exceptions.hh"
+#include "logger.hh"
+#include "monitor.hh"
+
+#include "scots_opt.hh"
+#include "scots_opt_det.hh"
+
+using namespace std;
+
+using namespace tud::utils::logging;
+using namespace tud::utils::exceptions;
+using namespace tud::utils::monitor;
+using namespace tud::ctrl::scots::optimal;
+
+/**
+ * Reads the batch manifest, each of its lines holds the scots_opt_det arguments
+ * of one controller. Empty lines and lines starting with '#' are skipped.
+ * @param manifest_file the manifest file name
+ * @param all_params the parameters of the controllers to be filled in
+ */
+static void read_manifest(const string & manifest_file, vector<det_tool_params> & all_params) {
+    ifstream manifest(manifest_file);
+    ASSERT_CONDITION_THROW(!manifest.is_open(),
+                           string("Could not open the manifest '") + manifest_file + string("'!"));
+
+    string line;
+    size_t line_no = 0;
+    while(getline(manifest, line)) {
+        ++line_no;
+
+        //Split the line into the program arguments
+        vector<string> tokens = {"scots_opt_det"};
+        istringstream line_stream(line);
+        string token;
+        while(line_stream >> token) {
+            tokens.push_back(token);
+        }
+        if((tokens.size() == 1) || (tokens[1][0] == '#')) {
+            continue;
+        }
+        vector<const char *> argv;
+        for(const string & elem : tokens) {
+            argv.push_back(elem.c_str());
+        }
+
+        //Parse the arguments with a parser of their own
+        det_tool_args args = {};
+        create_arguments_parser(args);
+        args.p_cmd_args->setExceptionHandling(false);
+        try {
+            det_tool_params params = {};
+            extract_arguments(args, argv.size(), argv.data(), params);
+            all_params.push_back(params);
+        } catch (std::exception & ex) {
+            destroy_arguments_parser(args);
+            THROW_EXCEPTION(manifest_file + string(":") + to_string(line_no) + string(": ") + ex.what());
+        }
+        destroy_arguments_parser(args);
+    }
+}
+
+/**
+ * The main program entry point
+ */
+int main(int argc, char** argv) {
+    //Declare the return code
+    int return_code = 0;
+
+    //Set the uncaught exception handler
+    std::set_terminate(handler);
+
+    //First print the program info
+    print_info();
+
+    try {
+        //Declare the statistics data
+        DECLARE_MONITOR_STATS;
+
+        //Parse the batch arguments
+        CmdLine cmd_args("", ' ', PROGRAM_VERSION_STR);
+        ValueArg<string> manifest_arg("f", "manifest", string("The manifest file, each line holds the ") +
+                                      string("scots_opt_det arguments of one controller"), true, "",
+                                      "manifest file name", cmd_args);
+        ValueArg<int32_t> jobs_arg("j", "jobs", string("The number of controllers determinized at once, ") +
+                                   string("0 for the number of hardware threads"), false, 0,
+                                   "number of jobs", cmd_args);
+        vector<string> debug_levels;
+        logger::get_reporting_levels(&debug_levels);
+        ValuesConstraint<string> debug_levels_constr(debug_levels);
+        ValueArg<string> debug_level_arg("l", "logging", "The log level to be used",
+                                         false, RESULT_PARAM_VALUE, &debug_levels_constr, cmd_args);
+        cmd_args.setExceptionHandling(false);
+        try {
+            cmd_args.parse(argc, argv);
+        } catch (ArgException &e) {
+            THROW_EXCEPTION(string("Error: ") + e.error() + string(", for argument: ") + e.argId());
+        }
+
+        //Get the parameters of all controllers
+        vector<det_tool_params> all_params;
+        read_manifest(manifest_arg.getValue(), all_params);
+
+        //Set the logging level after the manifest lines have set theirs
+        logger::set_reporting_level(debug_level_arg.getValue());
+
+        const int num_jobs = min<int>(all_params.size(), jobs_arg.getValue() > 0 ?
+                                      jobs_arg.getValue() : default_no_threads());
+        LOG_USAGE << "Determinizing " << all_params.size() << " controllers, "
+        << num_jobs << " at once ..." << END_LOG;
+
+        //Get the beginning statistics data
+        INITIALIZE_STATS;
+
+        //Each job takes the next controller and determinizes it in its own context
+        atomic<size_t> next_ctrl(0);
+        atomic<size_t> num_failed(0);
+        run_threads(num_jobs, [&](int) {
+            size_t idx;
+            while((idx = next_ctrl++) < all_params.size()) {
+                const det_tool_params & params = all_params[idx];
+                try {
+                    determinize(params);
+                    LOG_RESULT << "Controller '" << params.m_source_file << "' is determinized into '"
+                    << params.m_target_file << "'" << END_LOG;
+                } catch (std::exception & ex) {
+                    LOG_ERROR << "Controller '" << params.m_source_file << "' failed: " << ex.what() << END_LOG;
+                    ++num_failed;
+                }
+            }
+        });
+
+        //Get the end stats and log them
+        REPORT_STATS(string("Batch determinization"));
+
+        ASSERT_CONDITION_THROW((num_failed > 0), to_string(num_failed) + string(" out of ") +
+                               to_string(all_params.size()) + string(" controllers failed!"));
+
+        LOG_USAGE << "Finished" << END_LOG;
+    } catch (std::exception & ex) {
+        //The argument's extraction has failed, print the error message and quit
+        LOG_ERROR << ex.what() << END_LOG;
+        return_code = 1;
+    }
+
+    return return_code;
+}
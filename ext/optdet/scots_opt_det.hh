@@ -117,22 +117,33 @@ namespace tud {
                     exit(1);
                 }
                 
-                //The pointer to the command line parameters parser
-                static CmdLine * p_cmd_args = NULL;
-                static ValueArg<string> * p_source_file_arg = NULL;
-                static ValueArg<string> * p_target_file_arg = NULL;
-                static vector<string> debug_levels;
-                static ValuesConstraint<string> * p_debug_levels_constr = NULL;
-                static ValueArg<string> * p_debug_level_arg = NULL;
-                static ValueArg<int32_t> * p_ss_dim = NULL;
-                static SwitchArg * p_is_reorder = NULL;
-                static SwitchArg * p_is_extend = NULL;
-                static SwitchArg * p_is_sco_const = NULL;
-                static SwitchArg * p_is_sco_lin = NULL;
-                static SwitchArg * p_is_bdd_const = NULL;
-                static SwitchArg * p_is_bdd_lin = NULL;
-                static ValueArg<string> * p_det_alg = NULL;
-                static ValuesConstraint<string> * p_det_alg_vals = NULL;
+                /**
+                 * This structure stores the command line parameters parser and its arguments,
+                 * one instance per parsed command line, e.g. per line of a batch manifest.
+                 */
+                struct det_tool_args {
+                    //The pointer to the command line parameters parser
+                    CmdLine * p_cmd_args;
+                    ValueArg<string> * p_source_file_arg;
+                    ValueArg<string> * p_target_file_arg;
+                    vector<string> debug_levels;
+                    ValuesConstraint<string> * p_debug_levels_constr;
+                    ValueArg<string> * p_debug_level_arg;
+                    ValueArg<int32_t> * p_ss_dim;
+                    ValueArg<uint32_t> * p_mem_budget;
+                    ValueArg<double> * p_budget_seconds;
+                    ValueArg<uint32_t> * p_budget_mb;
+                    SwitchArg * p_is_reorder;
+                    SwitchArg * p_is_extend;
+                    SwitchArg * p_is_sco_const;
+                    SwitchArg * p_is_sco_lin;
+                    SwitchArg * p_is_bdd_const;
+                    SwitchArg * p_is_bdd_lin;
+                    ValueArg<string> * p_det_alg;
+                    ValuesConstraint<string> * p_det_alg_vals;
+                    ValueArg<string> * p_split_order;
+                    ValuesConstraint<string> * p_split_order_vals;
+                };
 
                 /**
                  * This functions does nothing more but printing the program header information
@@ -143,142 +154,192 @@ namespace tud {
                 
                 /**
                  * Creates and sets up the command line parameters parser
+                 * @param args the zero initialized parser and arguments to be created
                  */
-                void create_arguments_parser() {
+                void create_arguments_parser(det_tool_args & args) {
                     //Declare the command line arguments parser
-                    p_cmd_args = new CmdLine("", ' ', PROGRAM_VERSION_STR);
+                    args.p_cmd_args = new CmdLine("", ' ', PROGRAM_VERSION_STR);
                     
                     //Add the input controller file parameter - compulsory
                     
-                    p_source_file_arg = new ValueArg<string>("s", "source-controller", string("The SCOTSv2.0 BDD controller ") +
+                    args.p_source_file_arg = new ValueArg<string>("s", "source-controller", string("The SCOTSv2.0 BDD controller ") +
                                                              string("file name without (.scs/.bdd)"), true, "",
-                                                             "source controller file name", *p_cmd_args);
+                                                             "source controller file name", *args.p_cmd_args);
                     
                     //Add the output controller file parameter - compulsory
-                    p_target_file_arg = new ValueArg<string>("t", "target-controller", string("The SCOTSv2.0 BDD controller ") +
+                    args.p_target_file_arg = new ValueArg<string>("t", "target-controller", string("The SCOTSv2.0 BDD controller ") +
                                                              string("file name without (.scs/.bdd)"), true, "",
-                                                             "target controller file name", *p_cmd_args);
+                                                             "target controller file name", *args.p_cmd_args);
                     
                     //Add the number of state-space dimensions for the problem - compulsory
-                    p_ss_dim = new ValueArg<int32_t>("d", "state-dimension", string("The number of state space dimensions"),
-                                                     true, 0, "state-space dimensionality", *p_cmd_args);
+                    args.p_ss_dim = new ValueArg<int32_t>("d", "state-dimension", string("The number of state space dimensions"),
+                                                     true, 0, "state-space dimensionality", *args.p_cmd_args);
+                    
+                    //Add the CUDD memory budget in Mb - optional, default is unlimited
+                    args.p_mem_budget = new ValueArg<uint32_t>("m", "mem-budget", string("The CUDD manager memory budget in Mb, ") +
+                                                          string("0 for unlimited"), false, 0,
+                                                          "memory budget", *args.p_cmd_args);
+                    
+                    //Add the determinization time budget in seconds - optional, default is unlimited
+                    args.p_budget_seconds = new ValueArg<double>("", "budget-seconds", string("The wall time budget of the ") +
+                                                            string("determinization in seconds, the best controller found ") +
+                                                            string("so far is stored once it is used up, 0 for unlimited"),
+                                                            false, 0, "time budget", *args.p_cmd_args);
+                    
+                    //Add the determinization memory budget in Mb - optional, default is unlimited
+                    args.p_budget_mb = new ValueArg<uint32_t>("", "budget-mb", string("The resident memory budget of the ") +
+                                                         string("determinization in Mb, the best controller found ") +
+                                                         string("so far is stored once it is used up, 0 for unlimited"),
+                                                         false, 0, "determinization memory budget", *args.p_cmd_args);
                     
                     //Compression flag: Reorder the variables in the end to get smaller bdd
-                    p_is_reorder = new SwitchArg("r", "reorder", string("Reorder variables to optimize") +
-                                                 string(" resulting BDD size"), *p_cmd_args, false);
+                    args.p_is_reorder = new SwitchArg("r", "reorder", string("Reorder variables to optimize") +
+                                                 string(" resulting BDD size"), *args.p_cmd_args, false);
                     //Compression flag: Store bdd in a form of an extended grid to reduce space
-                    p_is_extend = new SwitchArg("e", "extend", string("Extend to larger grid to optimize") +
-                                                 string(" resulting BDD size"), *p_cmd_args, false);
+                    args.p_is_extend = new SwitchArg("e", "extend", string("Extend to larger grid to optimize") +
+                                                 string(" resulting BDD size"), *args.p_cmd_args, false);
                     //Compression flag: Store the bdd with constant compression applied, the controller then needs decoding
-                    p_is_sco_const = new SwitchArg("c", "constant", string("Compress using constant functions to optimize") +
-                                                   string(" resulting BDD size"), *p_cmd_args, false);
+                    args.p_is_sco_const = new SwitchArg("c", "constant", string("Compress using constant functions to optimize") +
+                                                   string(" resulting BDD size"), *args.p_cmd_args, false);
                     //Compression flag: Store the bdd with angled compression applied, the controller then needs decoding
-                    p_is_sco_lin = new SwitchArg("g", "angled", string("Compress using linear functions to optimize") +
-                                                 string(" resulting BDD size"), *p_cmd_args, false);
+                    args.p_is_sco_lin = new SwitchArg("g", "angled", string("Compress using linear functions to optimize") +
+                                                 string(" resulting BDD size"), *args.p_cmd_args, false);
                     //Compression flag: Store the bdd with constant compression applied on extended grid,
                     //                  the controller then needs decoding
-                    p_is_bdd_const = new SwitchArg("x", "bdd-constant", string("Compress using constant functions") +
+                    args.p_is_bdd_const = new SwitchArg("x", "bdd-constant", string("Compress using constant functions") +
                                                    string(" on the internal bdd state ids"),
-                                                   *p_cmd_args, false);
+                                                   *args.p_cmd_args, false);
                     //Compression flag: Store the bdd with angled compression applied on extended grid,
                     //                  the controller then needs decoding
-                    p_is_bdd_lin = new SwitchArg("n", "bdd-angled", string("Compress using linear functions") +
+                    args.p_is_bdd_lin = new SwitchArg("n", "bdd-angled", string("Compress using linear functions") +
                                                  string(" on the internal bdd state ids"),
-                                                 *p_cmd_args, false);
+                                                 *args.p_cmd_args, false);
 
                     //This argument will define the determinization scope and thus the actual algorithm
-                    p_det_alg_vals = new ValuesConstraint<string>(det_tool_params::get_det_alg());
-                    p_det_alg = new ValueArg<string>("a", "algorithm", string("Define the determinization algorithm"),
-                                                       true, "mixed", p_det_alg_vals, *p_cmd_args);
+                    args.p_det_alg_vals = new ValuesConstraint<string>(det_tool_params::get_det_alg());
+                    args.p_det_alg = new ValueArg<string>("a", "algorithm", string("Define the determinization algorithm"),
+                                                       true, "mixed", args.p_det_alg_vals, *args.p_cmd_args);
+
+                    //This argument will define how the determinization tree split order is chosen
+                    args.p_split_order_vals = new ValuesConstraint<string>(det_tool_params::get_split_orders());
+                    args.p_split_order = new ValueArg<string>("o", "split-order", string("Define how the order in which ") +
+                                                         string("the local and mixed determinization trees split the ") +
+                                                         string("state dimensions is chosen"),
+                                                         false, "round-robin", args.p_split_order_vals, *args.p_cmd_args);
 
                     //Add the -d the debug level parameter - optional, default is e.g. RESULT
-                    logger::get_reporting_levels(&debug_levels);
-                    p_debug_levels_constr = new ValuesConstraint<string>(debug_levels);
-                    p_debug_level_arg = new ValueArg<string>("l", "logging", "The log level to be used",
-                                                             false, RESULT_PARAM_VALUE, p_debug_levels_constr, *p_cmd_args);
+                    logger::get_reporting_levels(&args.debug_levels);
+                    args.p_debug_levels_constr = new ValuesConstraint<string>(args.debug_levels);
+                    args.p_debug_level_arg = new ValueArg<string>("l", "logging", "The log level to be used",
+                                                             false, RESULT_PARAM_VALUE, args.p_debug_levels_constr, *args.p_cmd_args);
                 }
                 
                 /**
                  * This function tries to extract the
+                 * @param args the command line parameters parser and arguments
                  * @param argc the number of program arguments
                  * @param argv the array of program arguments
                  * @param params the structure to store the tool parameter values
                  */
-                static void extract_arguments(const uint argc,
-                                              char const * const * const argv,
-                                              det_tool_params & params) {
+                static inline void extract_arguments(det_tool_args & args, const uint argc,
+                                                     char const * const * const argv,
+                                                     det_tool_params & params) {
                     //Parse the arguments
                     try {
-                        p_cmd_args->parse(argc, argv);
+                        args.p_cmd_args->parse(argc, argv);
                     } catch (ArgException &e) {
                         THROW_EXCEPTION(string("Error: ") + e.error() + string(", for argument: ") + e.argId());
                     }
                     
                     //Set the logging level right away
-                    logger::set_reporting_level(p_debug_level_arg->getValue());
+                    logger::set_reporting_level(args.p_debug_level_arg->getValue());
                     
                     //Store the parsed parameter values
-                    params.m_source_file = p_source_file_arg->getValue();
+                    params.m_source_file = args.p_source_file_arg->getValue();
                     LOG_USAGE << "Given BDD controller input file: '" << params.m_source_file << "'" << END_LOG;
                     
-                    params.m_target_file = p_target_file_arg->getValue();
+                    params.m_target_file = args.p_target_file_arg->getValue();
                     LOG_USAGE << "Given BDD controller output file: '" << params.m_target_file << "'" << END_LOG;
                     
-                    params.m_ss_dim = p_ss_dim->getValue();
+                    params.m_ss_dim = args.p_ss_dim->getValue();
                     LOG_USAGE << "The state-space dimensionality is: " << params.m_ss_dim << END_LOG;
                     ASSERT_CONDITION_THROW((params.m_ss_dim <= 0),
                                            string("Improper number of state-space dimensions: ") +
                                            to_string(params.m_ss_dim) + string(" must be > 0 ") );
                     
-                    params.m_is_reorder = p_is_reorder->getValue();
+                    params.m_mem_budget = args.p_mem_budget->getValue();
+                    LOG_USAGE << "The CUDD memory budget is: " << (params.m_mem_budget > 0 ?
+                    to_string(params.m_mem_budget) + string(" Mb") : string("UNLIMITED")) << END_LOG;
+                    
+                    params.m_budget_seconds = args.p_budget_seconds->getValue();
+                    params.m_budget_mb = args.p_budget_mb->getValue();
+                    LOG_USAGE << "The determinization budget is: " << (params.m_budget_seconds > 0 ?
+                    to_string(params.m_budget_seconds) + string(" seconds") : string("UNLIMITED time")) << ", "
+                    << (params.m_budget_mb > 0 ? to_string(params.m_budget_mb) + string(" Mb") :
+                        string("UNLIMITED memory")) << END_LOG;
+                    ASSERT_CONDITION_THROW((params.m_budget_seconds < 0),
+                                           string("Improper time budget: ") +
+                                           to_string(params.m_budget_seconds) + string(" must be >= 0 ") );
+                    
+                    params.m_is_reorder = args.p_is_reorder->getValue();
                     LOG_USAGE << "The final BDD variable reordering is: " <<
                     (params.m_is_reorder ? "" : "NOT ") << "NEEDED" << END_LOG;
                     
-                    params.m_is_extend = p_is_extend->getValue();
+                    params.m_is_extend = args.p_is_extend->getValue();
                     LOG_USAGE << "The final BDD grid extension is: " <<
                     (params.m_is_extend ? "" : "NOT ") << "NEEDED" << END_LOG;
                     
-                    params.m_is_sco_const = p_is_sco_const->getValue();
+                    params.m_is_sco_const = args.p_is_sco_const->getValue();
                     LOG_USAGE << "The final constant scots compression is: " <<
                     (params.m_is_sco_const ? "" : "NOT ") << "NEEDED" << END_LOG;
                     
-                    params.m_is_sco_lin = p_is_sco_lin->getValue();
+                    params.m_is_sco_lin = args.p_is_sco_lin->getValue();
                     LOG_USAGE << "The final linear scots compression is: " <<
                     (params.m_is_sco_lin ? "" : "NOT ") << "NEEDED" << END_LOG;
                     
-                    params.m_is_bdd_const = p_is_bdd_const->getValue();
+                    params.m_is_bdd_const = args.p_is_bdd_const->getValue();
                     LOG_USAGE << "The final constant bdd compression is: " <<
                     (params.m_is_bdd_const ? "" : "NOT ") << "NEEDED" << END_LOG;
                     
-                    params.m_is_bdd_lin = p_is_bdd_lin->getValue();
+                    params.m_is_bdd_lin = args.p_is_bdd_lin->getValue();
                     LOG_USAGE << "The final linear bdd compression is: " <<
                     (params.m_is_bdd_lin ? "" : "NOT ") << "NEEDED" << END_LOG;
 
-                    params.set_det_alg_type(p_det_alg->getValue());
+                    params.set_det_alg_type(args.p_det_alg->getValue());
                     LOG_USAGE << "The determinization algorithm: " <<
                     (params.m_det_alg_type == det_alg_enum::local ?
                      "Local" : ( params.m_det_alg_type == det_alg_enum::global ?
                                 "Global" : "Mixed" ) ) << END_LOG;
+
+                    params.set_split_order(args.p_split_order->getValue());
+                    LOG_USAGE << "The determinization tree split order is: "
+                    << args.p_split_order->getValue() << END_LOG;
                 }
                 
                 /**
                  * Allows to deallocate the parameters parser if it is needed
+                 * @param args the command line parameters parser and arguments
                  */
-                void destroy_arguments_parser() {
-                    SAFE_DESTROY(p_source_file_arg);
-                    SAFE_DESTROY(p_target_file_arg);
-                    SAFE_DESTROY(p_ss_dim);
-                    SAFE_DESTROY(p_is_reorder);
-                    SAFE_DESTROY(p_is_extend);
-                    SAFE_DESTROY(p_is_sco_const);
-                    SAFE_DESTROY(p_is_sco_lin);
-                    SAFE_DESTROY(p_is_bdd_const);
-                    SAFE_DESTROY(p_is_bdd_lin);
-                    SAFE_DESTROY(p_det_alg);
-                    SAFE_DESTROY(p_det_alg_vals);
-                    SAFE_DESTROY(p_debug_levels_constr);
-                    SAFE_DESTROY(p_debug_level_arg);
-                    SAFE_DESTROY(p_cmd_args);
+                void destroy_arguments_parser(det_tool_args & args) {
+                    SAFE_DESTROY(args.p_source_file_arg);
+                    SAFE_DESTROY(args.p_target_file_arg);
+                    SAFE_DESTROY(args.p_ss_dim);
+                    SAFE_DESTROY(args.p_mem_budget);
+                    SAFE_DESTROY(args.p_budget_seconds);
+                    SAFE_DESTROY(args.p_budget_mb);
+                    SAFE_DESTROY(args.p_is_reorder);
+                    SAFE_DESTROY(args.p_is_extend);
+                    SAFE_DESTROY(args.p_is_sco_const);
+                    SAFE_DESTROY(args.p_is_sco_lin);
+                    SAFE_DESTROY(args.p_is_bdd_const);
+                    SAFE_DESTROY(args.p_is_bdd_lin);
+                    SAFE_DESTROY(args.p_det_alg);
+                    SAFE_DESTROY(args.p_det_alg_vals);
+                    SAFE_DESTROY(args.p_split_order);
+                    SAFE_DESTROY(args.p_split_order_vals);
+                    SAFE_DESTROY(args.p_debug_levels_constr);
+                    SAFE_DESTROY(args.p_debug_level_arg);
+                    SAFE_DESTROY(args.p_cmd_args);
                 }
             }
         }
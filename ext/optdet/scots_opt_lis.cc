@@ -37,6 +37,7 @@
 
 #include "scots_opt_lis.hh"
 
+#include "cudd_mgr.hh"
 #include "ctrl_data.hh"
 #include "input_output.hh"
 #include "linearizer.hh"
@@ -91,18 +92,20 @@ int main(int argc, char** argv) {
     create_arguments_parser();
     
     try {
-        //Declare the CUDD manager
-        Cudd cudd_mgr;
         //Declare the parameters structure
         lis_tool_params params = {};
-        //Declare the input and output controller structures
-        ctrl_data input_ctrl = {};
         //Declare the statistics data
         DECLARE_MONITOR_STATS;
         
         //Attempt to extract the program arguments
         extract_arguments(argc, argv, params);
         
+        //Declare the CUDD manager sized for the source controller,
+        //it must outlive the controller structures declared below
+        Cudd cudd_mgr = create_cudd_mgr(params.m_source_file, params.m_mem_budget);
+        //Declare the input and output controller structures
+        ctrl_data input_ctrl = {};
+        
         //Disable automatic variable ordering
         cudd_mgr.AutodynDisable();
         
@@ -132,6 +135,9 @@ int main(int argc, char** argv) {
         
         //ToDo: Implement storing the support BDD
         
+        //Report on the CUDD manager usage
+        report_cudd_mgr_stats(cudd_mgr);
+        
         LOG_USAGE << "Finished" << END_LOG;
     } catch (std::exception & ex) {
         //The argument's extraction has failed, print the error message and quit
@@ -125,6 +125,7 @@ namespace tud {
                 static ValuesConstraint<string> * p_debug_levels_constr = NULL;
                 static ValueArg<string> * p_debug_level_arg = NULL;
                 static ValueArg<int32_t> * p_ss_dim = NULL;
+                static ValueArg<uint32_t> * p_mem_budget = NULL;
                 static ValueArg<float> * p_overs_pct = NULL;
                 static SwitchArg * p_is_no_supp = NULL;
                 static SwitchArg * p_is_reorder = NULL;
@@ -158,6 +159,11 @@ namespace tud {
                     p_ss_dim = new ValueArg<int32_t>("d", "state-dimension", string("The number of state space dimensions"),
                                                      true, 0, "state-space dimensionality", *p_cmd_args);
                     
+                    //Add the CUDD memory budget in Mb - optional, default is unlimited
+                    p_mem_budget = new ValueArg<uint32_t>("m", "mem-budget", string("The CUDD manager memory budget in Mb, ") +
+                                                          string("0 for unlimited"), false, 0,
+                                                          "memory budget", *p_cmd_args);
+                    
                     //Add the percentage of the overshoot for the states with no input, optional, default is 50%
                     p_overs_pct = new ValueArg<float>("o", "overshoot", string("The percent (%) of extra inputs above "),
                                                       false, 50.0, "and below, for the no-input states", *p_cmd_args);
@@ -209,6 +215,10 @@ namespace tud {
                                            string("Improper number of state-space dimensions: ") +
                                            to_string(params.m_ss_dim) + string(" must be > 0 ") );
                     
+                    params.m_mem_budget = p_mem_budget->getValue();
+                    LOG_USAGE << "The CUDD memory budget is: " << (params.m_mem_budget > 0 ?
+                    to_string(params.m_mem_budget) + string(" Mb") : string("UNLIMITED")) << END_LOG;
+                    
                     params.m_overs_pct = p_overs_pct->getValue();
                     LOG_USAGE << "The overshoot for no-input states is: " << params.m_overs_pct << " %" << END_LOG;
                     ASSERT_CONDITION_THROW((params.m_overs_pct < 0), string("The overshoot percent must be >= 0.0") );
@@ -230,6 +240,7 @@ namespace tud {
                     SAFE_DESTROY(p_source_file_arg);
                     SAFE_DESTROY(p_target_file_arg);
                     SAFE_DESTROY(p_ss_dim);
+                    SAFE_DESTROY(p_mem_budget);
                     SAFE_DESTROY(p_overs_pct);
                     SAFE_DESTROY(p_is_no_supp);
                     SAFE_DESTROY(p_is_reorder);
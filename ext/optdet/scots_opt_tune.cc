@@ -0,0 +1,381 @@
+/*
+ * File:   scots_opt_tune.cc
+ * Author: Antonio Rueda
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <chrono>
+
+// SCOTS header
+#include "scots.hh"
+
+#include "exceptions.hh"
+#include "logger.hh"
+#include "monitor.hh"
+
+#include "scots_opt.hh"
+#include "scots_opt_det.hh"
+#include "cudd_mgr.hh"
+
+using namespace std;
+
+using namespace tud::utils::logging;
+using namespace tud::utils::exceptions;
+using namespace tud::utils::monitor;
+using namespace tud::ctrl::scots::optimal;
+
+//The compressions, the first one stands for the determinized controller itself,
+//the others follow store_type_enum and are stored in this order
+static const vector<string> COMPRESSIONS = {"none", "reorder", "extend", "sco-const", "bdd-const", "sco-lin", "bdd-lin"};
+//The file suffixes of the compressions as given by store_min_controller
+static const vector<string> SUFFIXES = {"", "_reo", "_ext", "_con", "_bcon", "_lin", "_blin"};
+
+/**
+ * One candidate controller of the sweep
+ */
+struct tune_candidate {
+    //The candidate name: algorithm and compression
+    string m_name;
+    //The candidate controller file name without (.scs/.bdd)
+    string m_file;
+    //The determinization plus the compression time in seconds
+    double m_time;
+    //The number of BDD nodes of the stored controller
+    uint32_t m_nodes;
+    //The number of LUTs after abc, or -1 if not counted
+    int64_t m_luts;
+    //Is true if no other candidate is both smaller and faster
+    bool m_is_pareto;
+
+    /**
+     * Allows to get the candidate score, the smaller the better
+     * @return the LUT count if the LUTs are counted, otherwise the number of nodes
+     */
+    int64_t score() const {
+        return (m_luts >= 0) ? m_luts : m_nodes;
+    }
+};
+
+/**
+ * Counts the LUTs of the controller as it is implemented by generate_blif: one
+ * function per input bit and the domain, mapped onto 6-input LUTs by abc.
+ * @param abc the abc binary
+ * @param file the controller file name without (.scs/.bdd)
+ * @param is_dim the input-space dimensionality
+ * @param mem_budget_mb the memory budget in MB, 0 for unlimited
+ * @return the number of LUTs
+ */
+static int64_t count_luts(const string & abc, const string & file, const int32_t is_dim,
+                          const uint32_t mem_budget_mb) {
+    Cudd cudd_mgr = create_cudd_mgr(file, mem_budget_mb);
+    SymbolicSet ctrl_set;
+    BDD ctrl_bdd;
+    ASSERT_CONDITION_THROW(!read_from_file(cudd_mgr, ctrl_set, ctrl_bdd, file.c_str()),
+                           string("Controller files '") + file + string(".scs/.bdd' could not be loaded!"));
+
+    //The input variables are those of the last dimensions
+    vector<BDD> inputs;
+    const vector<IntegerInterval<abs_type>> intervals = ctrl_set.get_bdd_intervals();
+    for(size_t dof = intervals.size() - is_dim; dof < intervals.size(); ++dof) {
+        for(const BDD & var : intervals[dof].get_bdd_vars()) {
+            inputs.push_back(var);
+        }
+    }
+    BDD all_inputs = cudd_mgr.bddOne();
+    for(const BDD & var : inputs) {
+        all_inputs &= var;
+    }
+
+    //Split the controller, each input bit is true where it is 1
+    vector<BDD> outputs;
+    for(const BDD & var : inputs) {
+        outputs.push_back((ctrl_bdd & var).ExistAbstract(all_inputs));
+    }
+    outputs.push_back(ctrl_bdd.ExistAbstract(all_inputs));
+    vector<DdNode *> nodes;
+    for(const BDD & out : outputs) {
+        nodes.push_back(out.getNode());
+    }
+    const string blif_file = file + string(".blif");
+    FILE * blif = fopen(blif_file.c_str(), "w");
+    ASSERT_CONDITION_THROW((blif == NULL), string("Could not write '") + blif_file + string("'!"));
+    Cudd_DumpBlif(cudd_mgr.getManager(), nodes.size(), nodes.data(), NULL, NULL, NULL, blif, 0);
+    fclose(blif);
+
+    //Map the functions and take the node count of the LUT network
+    const string command = abc + string(" -c \"read_blif ") + blif_file +
+                           string("; strash; dch; if -K 6; print_stats\" 2>&1");
+    FILE * pipe = popen(command.c_str(), "r");
+    ASSERT_CONDITION_THROW((pipe == NULL), string("Could not run '") + command + string("'!"));
+    int64_t luts = -1;
+    char buffer[1024];
+    while(fgets(buffer, sizeof(buffer), pipe) != NULL) {
+        const string line(buffer);
+        const size_t pos = line.find("nd =");
+        if(pos != string::npos) {
+            luts = stoll(line.substr(pos + 4));
+        }
+    }
+    pclose(pipe);
+    remove(blif_file.c_str());
+    ASSERT_CONDITION_THROW((luts < 0), string("No LUT count in the output of '") + command + string("'!"));
+    return luts;
+}
+
+/**
+ * Copies the controller files
+ * @param source the source controller file name without (.scs/.bdd)
+ * @param target the target controller file name without (.scs/.bdd)
+ */
+static void copy_controller(const string & source, const string & target) {
+    for(const string ext : {".scs", ".bdd"}) {
+        ifstream in(source + ext, ios::binary);
+        ofstream out(target + ext, ios::binary);
+        ASSERT_CONDITION_THROW((!in.is_open() || !out.is_open()),
+                               string("Could not copy '") + source + ext + string("'!"));
+        out << in.rdbuf();
+    }
+}
+
+/**
+ * Marks the Pareto optimal candidates and writes the table of all candidates
+ * @param candidates the candidates
+ * @param table_file the table file name
+ */
+static void write_pareto_table(vector<tune_candidate> & candidates, const string & table_file) {
+    for(tune_candidate & cand : candidates) {
+        cand.m_is_pareto = true;
+        for(const tune_candidate & other : candidates) {
+            if((other.score() <= cand.score()) && (other.m_time <= cand.m_time) &&
+               ((other.score() < cand.score()) || (other.m_time < cand.m_time))) {
+                cand.m_is_pareto = false;
+                break;
+            }
+        }
+    }
+
+    ofstream table(table_file);
+    ASSERT_CONDITION_THROW(!table.is_open(), string("Could not write '") + table_file + string("'!"));
+    table << "#candidate\tnodes\tluts\ttime_sec\tpareto" << endl;
+    for(const tune_candidate & cand : candidates) {
+        table << cand.m_name << "\t" << cand.m_nodes << "\t" << cand.m_luts << "\t"
+        << cand.m_time << "\t" << (cand.m_is_pareto ? "yes" : "no") << endl;
+        LOG_RESULT << cand.m_name << ": " << cand.m_nodes << " nodes, "
+        << ((cand.m_luts >= 0) ? to_string(cand.m_luts) + string(" LUTs, ") : string(""))
+        << cand.m_time << " sec" << (cand.m_is_pareto ? ", Pareto optimal" : "") << END_LOG;
+    }
+}
+
+/**
+ * The main program entry point
+ */
+int main(int argc, char** argv) {
+    //Declare the return code
+    int return_code = 0;
+
+    //Set the uncaught exception handler
+    std::set_terminate(handler);
+
+    //First print the program info
+    print_info();
+
+    try {
+        //Declare the statistics data
+        DECLARE_MONITOR_STATS;
+
+        //Parse the tuner arguments
+        CmdLine cmd_args("", ' ', PROGRAM_VERSION_STR);
+        ValueArg<string> source_arg("s", "source", "The source controller file name without (.scs/.bdd)",
+                                    true, "", "source file name", cmd_args);
+        ValueArg<string> target_arg("t", "target", string("The best controller file name without (.scs/.bdd), ") +
+                                    string("the candidates get it as prefix"), true, "", "target file name", cmd_args);
+        ValueArg<int32_t> dim_arg("d", "state-dim", "The state-space dimensionality",
+                                  true, 0, "state-space dim", cmd_args);
+        ValuesConstraint<string> algs_constr(det_tool_params::get_det_alg());
+        MultiArg<string> alg_arg("a", "algorithm", "The algorithms to try, all if none is given",
+                                 false, &algs_constr, cmd_args);
+        vector<string> all_comps = COMPRESSIONS;
+        ValuesConstraint<string> comps_constr(all_comps);
+        MultiArg<string> comp_arg("z", "compression", "The compressions to try, all if none is given",
+                                  false, &comps_constr, cmd_args);
+        ValuesConstraint<string> split_orders_constr(det_tool_params::get_split_orders());
+        ValueArg<string> split_order_arg("o", "split-order", "The split order of the local and mixed trees",
+                                         false, "round-robin", &split_orders_constr, cmd_args);
+        ValueArg<string> abc_arg("L", "luts", "The abc binary, if given the candidates are scored by their LUT count",
+                                 false, "", "abc binary", cmd_args);
+        ValueArg<int32_t> jobs_arg("j", "jobs", string("The number of candidates determinized at once, ") +
+                                   string("0 for the number of hardware threads"), false, 0,
+                                   "number of jobs", cmd_args);
+        ValueArg<uint32_t> mem_arg("m", "mem-budget", "The memory budget of each job in Mb, 0 for unlimited",
+                                   false, 0, "memory budget", cmd_args);
+        vector<string> debug_levels;
+        logger::get_reporting_levels(&debug_levels);
+        ValuesConstraint<string> debug_levels_constr(debug_levels);
+        ValueArg<string> debug_level_arg("l", "logging", "The log level to be used",
+                                         false, RESULT_PARAM_VALUE, &debug_levels_constr, cmd_args);
+        cmd_args.setExceptionHandling(false);
+        try {
+            cmd_args.parse(argc, argv);
+        } catch (ArgException &e) {
+            THROW_EXCEPTION(string("Error: ") + e.error() + string(", for argument: ") + e.argId());
+        }
+        logger::set_reporting_level(debug_level_arg.getValue());
+        const vector<string> algorithms = alg_arg.getValue().empty() ?
+                                            det_tool_params::get_det_alg() : alg_arg.getValue();
+        //The reordering changes the manager, so the compressions keep their own order
+        vector<string> compressions;
+        for(const string & comp : COMPRESSIONS) {
+            const vector<string> & chosen = comp_arg.getValue();
+            if(chosen.empty() || (find(chosen.begin(), chosen.end(), comp) != chosen.end())) {
+                compressions.push_back(comp);
+            }
+        }
+
+        //Load the controller once, each job gets its own copy
+        det_tool_params base_params = {};
+        base_params.m_source_file = source_arg.getValue();
+        base_params.m_ss_dim = dim_arg.getValue();
+        base_params.m_mem_budget = mem_arg.getValue();
+        base_params.set_split_order(split_order_arg.getValue());
+        Cudd cudd_mgr = create_cudd_mgr(base_params.m_source_file, base_params.m_mem_budget);
+        cudd_mgr.AutodynDisable();
+        ctrl_data input_ctrl;
+        load_controller_bdd(cudd_mgr, base_params.m_source_file, base_params.m_ss_dim, input_ctrl);
+        const int32_t is_dim = input_ctrl.m_ctrl_set.get_dim() - input_ctrl.m_ss_dim;
+
+        //The contexts are created here as the transfers read the source manager
+        vector<unique_ptr<det_context>> contexts;
+        for(const string & alg : algorithms) {
+            det_tool_params params = base_params;
+            params.set_det_alg_type(alg);
+            params.m_target_file = target_arg.getValue() + string("_") + alg;
+            contexts.push_back(unique_ptr<det_context>(new det_context(params, cudd_mgr, input_ctrl)));
+        }
+        input_ctrl.m_ctrl_bdd &= cudd_mgr.bddZero();
+
+        const int num_jobs = min<int>(contexts.size(), jobs_arg.getValue() > 0 ?
+                                      jobs_arg.getValue() : default_no_threads());
+        LOG_USAGE << "Trying " << algorithms.size() << " algorithms with " << compressions.size()
+        << " compressions, " << num_jobs << " jobs at once ..." << END_LOG;
+
+        //Get the beginning statistics data
+        INITIALIZE_STATS;
+
+        //Each job determinizes with one algorithm and stores all its compressions
+        vector<vector<tune_candidate>> alg_candidates(contexts.size());
+        atomic<size_t> next_ctx(0);
+        atomic<size_t> num_failed(0);
+        run_threads(num_jobs, [&](int) {
+            size_t idx;
+            while((idx = next_ctx++) < contexts.size()) {
+                try {
+                    det_context & context = *contexts[idx];
+                    const string target = target_arg.getValue() + string("_") + algorithms[idx];
+                    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                    context.determinize();
+                    const double det_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    for(const string & comp : compressions) {
+                        const size_t type = find(COMPRESSIONS.begin(), COMPRESSIONS.end(), comp) - COMPRESSIONS.begin();
+                        start = chrono::steady_clock::now();
+                        if(type == 0) {
+                            context.store_output();
+                        } else {
+                            context.store_compressed(static_cast<store_type_enum>(type - 1));
+                        }
+                        tune_candidate cand = {};
+                        cand.m_name = algorithms[idx] + string("/") + comp;
+                        cand.m_file = target + SUFFIXES[type];
+                        cand.m_time = det_time + chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                        cand.m_luts = -1;
+                        alg_candidates[idx].push_back(cand);
+                    }
+                } catch (std::exception & ex) {
+                    LOG_ERROR << "Algorithm '" << algorithms[idx] << "' failed: " << ex.what() << END_LOG;
+                    ++num_failed;
+                }
+                contexts[idx].reset();
+            }
+        });
+
+        vector<tune_candidate> candidates;
+        for(const vector<tune_candidate> & cands : alg_candidates) {
+            candidates.insert(candidates.end(), cands.begin(), cands.end());
+        }
+        ASSERT_CONDITION_THROW(candidates.empty(), "All algorithms failed!");
+
+        //Score the candidates, the LUT counts are obtained concurrently
+        for(tune_candidate & cand : candidates) {
+            bdd_header_info info = {};
+            read_bdd_header_info(cand.m_file, info);
+            cand.m_nodes = info.m_num_nodes;
+        }
+        if(!abc_arg.getValue().empty()) {
+            atomic<size_t> next_cand(0);
+            run_threads(min<int>(candidates.size(), num_jobs), [&](int) {
+                size_t idx;
+                while((idx = next_cand++) < candidates.size()) {
+                    try {
+                        candidates[idx].m_luts = count_luts(abc_arg.getValue(), candidates[idx].m_file,
+                                                            is_dim, base_params.m_mem_budget);
+                    } catch (std::exception & ex) {
+                        LOG_ERROR << "LUT count of '" << candidates[idx].m_name << "' failed: " << ex.what() << END_LOG;
+                        ++num_failed;
+                    }
+                }
+            });
+            //A candidate without LUT count can not be compared with the others
+            candidates.erase(remove_if(candidates.begin(), candidates.end(),
+                                       [](const tune_candidate & cand) { return cand.m_luts < 0; }),
+                             candidates.end());
+            ASSERT_CONDITION_THROW(candidates.empty(), "All LUT counts failed!");
+        }
+
+        //Get the end stats and log them
+        REPORT_STATS(string("Autotuning"));
+
+        write_pareto_table(candidates, target_arg.getValue() + string("_tune.txt"));
+        const tune_candidate * best = &candidates[0];
+        for(const tune_candidate & cand : candidates) {
+            if((cand.score() < best->score()) ||
+               ((cand.score() == best->score()) && (cand.m_time < best->m_time))) {
+                best = &cand;
+            }
+        }
+        copy_controller(best->m_file, target_arg.getValue());
+        LOG_RESULT << "The best candidate is " << best->m_name << " with " << best->m_nodes << " nodes"
+        << ((best->m_luts >= 0) ? string(" and ") + to_string(best->m_luts) + string(" LUTs") : string(""))
+        << ", stored as '" << target_arg.getValue() << "'" << END_LOG;
+
+        ASSERT_CONDITION_THROW((num_failed > 0), to_string(num_failed) + string(" candidates failed!"));
+
+        LOG_USAGE << "Finished" << END_LOG;
+    } catch (std::exception & ex) {
+        //The argument's extraction has failed, print the error message and quit
+        LOG_ERROR << ex.what() << END_LOG;
+        return_code = 1;
+    }
+
+    return return_code;
+}
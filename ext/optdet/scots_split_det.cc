@@ -66,7 +66,7 @@ static void split_per_input(const split_tool_params & params, const input_ctrl_d
     //Create, strip and store a new controller for each of the given ids
     for(abs_type input_id : input_ids) {
         //1. Load the controller
-        input_ctrl_data input_ctrl;
+        input_ctrl_data input_ctrl(params.m_source_file, params.m_mem_budget);
         input_ctrl.load_controller_bdd(params.m_source_file, params.m_ss_dim);
         //2. Remove other ids
         input_ctrl.fix_input(input_id);
@@ -76,6 +76,8 @@ static void split_per_input(const split_tool_params & params, const input_ctrl_d
         const string res_file_name = params.m_target_file + string("_") + to_string(input_id);
         input_ctrl.store_controller_bdd(res_file_name);
         LOG_RESULT << "String the controller: " << res_file_name << END_LOG;
+        //5. Report on the CUDD manager usage
+        input_ctrl.report_mgr_stats();
     }
     //Get the end stats and log them
     REPORT_STATS(string("Splitting the controller"));
@@ -126,7 +128,7 @@ int main(int argc, char** argv) {
         extract_arguments(argc, argv, params);
 
         //Define the main controller's variable
-        input_ctrl_data main_ctrl;
+        input_ctrl_data main_ctrl(params.m_source_file, params.m_mem_budget);
         
         //Load the controller
         main_ctrl.load_controller_bdd(params.m_source_file, params.m_ss_dim);
@@ -141,6 +143,9 @@ int main(int argc, char** argv) {
             extract_domain(params, main_ctrl);
         }
         
+        //Report on the CUDD manager usage
+        main_ctrl.report_mgr_stats();
+        
         LOG_USAGE << "Finished" << END_LOG;
     } catch (std::exception & ex) {
         //The argument's extraction has failed, print the error message and quit
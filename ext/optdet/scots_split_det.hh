@@ -130,6 +130,8 @@ namespace tud {
                     bool m_is_input;
                     //If true then we need the domain BDD
                     bool m_is_supp;
+                    //The CUDD manager memory budget in Mb, 0 for unlimited
+                    uint32_t m_mem_budget;
                 };
                 
                 //The pointer to the command line parameters parser
@@ -140,6 +142,7 @@ namespace tud {
                 static ValuesConstraint<string> * p_debug_levels_constr = NULL;
                 static ValueArg<string> * p_debug_level_arg = NULL;
                 static ValueArg<int32_t> * p_ss_dim = NULL;
+                static ValueArg<uint32_t> * p_mem_budget = NULL;
                 static SwitchArg * p_is_input = NULL;
                 static SwitchArg * p_is_supp = NULL;
                 
@@ -172,6 +175,11 @@ namespace tud {
                     p_ss_dim = new ValueArg<int32_t>("d", "state-dimension", string("The number of state space dimensions"),
                                                      true, 0, "state-space dimensionality", *p_cmd_args);
                     
+                    //Add the CUDD memory budget in Mb - optional, default is unlimited
+                    p_mem_budget = new ValueArg<uint32_t>("m", "mem-budget", string("The CUDD manager memory budget in Mb, ") +
+                                                          string("0 for unlimited"), false, 0,
+                                                          "memory budget", *p_cmd_args);
+                    
                     //Request the per-input splitting, default is false
                     p_is_input = new SwitchArg("i", "input", string("Request the splitting ") +
                                                string("the controller per input"), *p_cmd_args, false);
@@ -219,6 +227,10 @@ namespace tud {
                                            string("Improper number of state-space dimensions: ") +
                                            to_string(params.m_ss_dim) + string(" must be > 0 ") );
                     
+                    params.m_mem_budget = p_mem_budget->getValue();
+                    LOG_USAGE << "The CUDD memory budget is: " << (params.m_mem_budget > 0 ?
+                    to_string(params.m_mem_budget) + string(" Mb") : string("UNLIMITED")) << END_LOG;
+                    
                     params.m_is_input = p_is_input->getValue();
                     LOG_USAGE << "The per-input splitting is: "
                     << (params.m_is_input ? "" : "NOT ") << "NEEDED" << END_LOG;
@@ -238,6 +250,7 @@ namespace tud {
                     SAFE_DESTROY(p_source_file_arg);
                     SAFE_DESTROY(p_target_file_arg);
                     SAFE_DESTROY(p_ss_dim);
+                    SAFE_DESTROY(p_mem_budget);
                     SAFE_DESTROY(p_is_input);
                     SAFE_DESTROY(p_is_supp);
                     SAFE_DESTROY(p_debug_levels_constr);
@@ -41,6 +41,7 @@
 
 #include "scots_to_svg.hh"
 
+#include "cudd_mgr.hh"
 #include "ctrl_data.hh"
 #include "input_output.hh"
 #include "bdd_decoder.hh"
@@ -404,8 +405,8 @@ int main(int argc, char** argv) {
         //Attempt to extract the program arguments
         extract_arguments(argc, argv, params);
         
-        //Declare the CUDD manager
-        Cudd cudd_mgr;
+        //Declare the CUDD manager sized for the source controller
+        Cudd cudd_mgr = create_cudd_mgr(params.m_source_file, params.m_mem_budget);
         
         //Declare the input and output controller structures
         ctrl_data input_ctrl = {};
@@ -429,6 +430,9 @@ int main(int argc, char** argv) {
         } else {
             convert_controller_to_svg<false>(cudd_mgr, params.m_target_file, params.m_ss_dim, input_ctrl, perms);
         }
+        
+        //Report on the CUDD manager usage
+        report_cudd_mgr_stats(cudd_mgr);
     } catch (std::exception & ex) {
         //The argument's extraction has failed, print the error message and quit
         LOG_ERROR << ex.what() << END_LOG;
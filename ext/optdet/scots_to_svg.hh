@@ -128,6 +128,8 @@ namespace tud {
                     int32_t m_ss_dim;
                     //This flag allows to switch between scots ids and internal bdd ids
                     bool m_is_bdd_ids;
+                    //The CUDD manager memory budget in Mb, 0 for unlimited
+                    uint32_t m_mem_budget;
                 };
                 
                 //The pointer to the command line parameters parser
@@ -138,6 +140,7 @@ namespace tud {
                 static ValuesConstraint<string> * p_debug_levels_constr = NULL;
                 static ValueArg<string> * p_debug_level_arg = NULL;
                 static ValueArg<int32_t> * p_ss_dim = NULL;
+                static ValueArg<uint32_t> * p_mem_budget = NULL;
                 static SwitchArg * p_is_bdd_ids = NULL;
                 
                 /**
@@ -169,6 +172,11 @@ namespace tud {
                     p_ss_dim = new ValueArg<int32_t>("d", "state-dimension", string("The number of state space dimensions"),
                                                      true, 0, "state-space dimensionality", *p_cmd_args);
                     
+                    //Add the CUDD memory budget in Mb - optional, default is unlimited
+                    p_mem_budget = new ValueArg<uint32_t>("m", "mem-budget", string("The CUDD manager memory budget in Mb, ") +
+                                                          string("0 for unlimited"), false, 0,
+                                                          "memory budget", *p_cmd_args);
+                    
                     //Request the per-input splitting, default is false
                     p_is_bdd_ids = new SwitchArg("b", "bdd", string("Request the bdd ids plotting ") +
                                                string("instead of scots abstract ids"), *p_cmd_args, false);
@@ -212,6 +220,10 @@ namespace tud {
                                            string("Improper number of state-space dimensions: ") +
                                            to_string(params.m_ss_dim) + string(" must be > 0 ") );
                     
+                    params.m_mem_budget = p_mem_budget->getValue();
+                    LOG_USAGE << "The CUDD memory budget is: " << (params.m_mem_budget > 0 ?
+                    to_string(params.m_mem_budget) + string(" Mb") : string("UNLIMITED")) << END_LOG;
+                    
                     params.m_is_bdd_ids = p_is_bdd_ids->getValue();
                     LOG_USAGE << "The BDD ids plotting is: "
                     << (params.m_is_bdd_ids ? "" : "NOT ") << "NEEDED" << END_LOG;
@@ -224,6 +236,7 @@ namespace tud {
                     SAFE_DESTROY(p_source_file_arg);
                     SAFE_DESTROY(p_target_file_arg);
                     SAFE_DESTROY(p_ss_dim);
+                    SAFE_DESTROY(p_mem_budget);
                     SAFE_DESTROY(p_is_bdd_ids);
                     SAFE_DESTROY(p_debug_levels_constr);
                     SAFE_DESTROY(p_debug_level_arg);
@@ -73,16 +73,6 @@ namespace tud {
                     virtual bool is_leaf() {
                         return false;
                     }
-                    
-                    static inline size_t & m_max_depth() {
-                        static size_t max_depth = 0;
-                        return max_depth;
-                    }
-                    
-                    static inline size_t * & m_depth_to_dof() {
-                        static size_t * depth_to_dof;
-                        return depth_to_dof;
-                    }
                 };
                 
             }
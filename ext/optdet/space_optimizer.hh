@@ -41,6 +41,7 @@
 #include "states_mgr.hh"
 #include "space_tree_sco.hh"
 #include "space_tree_bdd.hh"
+#include "det_budget.hh"
 
 using namespace std;
 using namespace scots;
@@ -66,8 +67,12 @@ namespace tud {
                      * The basic constructor
                      * @param cudd_mgr the cudd manager to be used
                      * @param input_ctrl the controller's data
+                     * @param order the way the split order of the tree is chosen
+                     * @param p_budget the determinization budget, NULL for unlimited
                      */
-                    space_optimizer(const Cudd & cudd_mgr, const ctrl_data & input_ctrl)
+                    space_optimizer(const Cudd & cudd_mgr, const ctrl_data & input_ctrl,
+                                    const split_order_enum order = split_order_enum::round_robin,
+                                    det_budget * p_budget = NULL)
                     : m_cudd_mgr(cudd_mgr),
                     m_ctrl_bdd(input_ctrl.m_ctrl_bdd),
                     m_ctrl_set(input_ctrl.m_ctrl_set),
@@ -75,7 +80,7 @@ namespace tud {
                     m_ss_mgr(input_ctrl.m_ctrl_set, input_ctrl.m_ss_dim,
                              input_ctrl.m_ctrl_bdd, m_cudd_mgr,
                              m_is_mgr.get_inputs_set()),
-                    m_tree(m_ss_mgr, m_is_mgr) {
+                    m_tree(m_ss_mgr, m_is_mgr), m_p_budget(p_budget), m_is_complete(true) {
                         //Declare the statistics data
                         DECLARE_MONITOR_STATS;
                         
@@ -83,46 +88,74 @@ namespace tud {
                         
                         //Get the beginning statistics data
                         INITIALIZE_STATS;
-                        //Make local constants for dimensions
-                        const int ss_dim = m_ss_mgr.get_dim();
-                        const int is_dim = m_is_mgr.get_dim();
-                        
                         //Get the number the states with inputs
-                        raw_data all_states = m_ss_mgr.get_points();
-                        
-                        //Get the number of states
-                        const int num_states = all_states.size() / ss_dim;
+                        const size_t num_states = m_ss_mgr.get_size();
                         LOG_INFO << "The number of states with inputs is: " << num_states << END_LOG;
                         
                         //Pre-declare containers
-                        raw_data state(ss_dim), input(is_dim);
                         set<abs_type> input_ids;
                         
+                        //Get the states and the inputs of every state first if
+                        //the tree needs them to choose its split order
+                        raw_data all_states;
+                        vector<set<abs_type>> all_inputs;
+                        if(order != split_order_enum::round_robin) {
+                            all_states.reserve(num_states * m_ss_mgr.get_dim());
+                            all_inputs.reserve(num_states);
+                            try {
+                                m_ss_mgr.for_each_point([&](const raw_data & state) {
+                                    check_budget();
+                                    all_states.insert(all_states.end(), state.begin(), state.end());
+                                    raw_data state_inputs = m_ctrl_set.restriction(m_cudd_mgr, m_ctrl_bdd, state);
+                                    all_inputs.emplace_back();
+                                    m_is_mgr.get_input_ids(state_inputs, all_inputs.back());
+                                });
+                                m_tree.set_split_order(order, all_states, all_inputs);
+                            } catch (const budget_exceeded &) {
+                                //Fall back to the round-robin order for the states collected so far
+                                LOG_USAGE << "Stopped choosing the split order" << END_LOG;
+                                m_is_complete = false;
+                            }
+                        }
+                        
                         //Start the initial estimator creation
                         m_tree.points_started();
                         
                         //Iterate over the states, get the corresponding
                         //inputs and add them to the estimator set by ids
-                        auto state_begin = all_states.begin();
-                        for(int i = 0; i < num_states; ++i) {
-                            //Get a new state vector
-                            state.assign(state_begin, state_begin + ss_dim);
-                            
-                            //Get the list of inputs
-                            raw_data state_inputs = m_ctrl_set.restriction(m_cudd_mgr, m_ctrl_bdd, state);
+                        size_t i = 0;
+                        try {
+                            m_ss_mgr.for_each_point([&](const raw_data & state) {
+                                if(all_inputs.empty()) {
+                                    check_budget();
+                                    
+                                    //Get the list of inputs
+                                    raw_data state_inputs = m_ctrl_set.restriction(m_cudd_mgr, m_ctrl_bdd, state);
 
-                            //Convert inputs to input ids
-                            m_is_mgr.get_input_ids(state_inputs, input_ids);
+                                    //Convert inputs to input ids
+                                    m_is_mgr.get_input_ids(state_inputs, input_ids);
+                                } else if(i < all_inputs.size()) {
+                                    input_ids.swap(all_inputs[i++]);
+                                } else {
+                                    //Only the states collected within the budget are known
+                                    throw budget_exceeded("The determinization budget is used up");
+                                }
 
-                            //Add the state with its inputs into the estimator
-                            m_tree.add_point(state, input_ids);
-                            
-                            //Move forward in the list of states
-                            state_begin += ss_dim;
+                                //Add the state with its inputs into the estimator
+                                m_tree.add_point(state, input_ids);
+                                
+                                //Publish the tree of the states added so far
+                                publish_partial();
+                            });
+                        } catch (const budget_exceeded &) {
+                            LOG_USAGE << "Stopped adding states to the determinization tree" << END_LOG;
+                            m_is_complete = false;
                         }
                         
                         //Finalize the initial estimator creation
-                        m_tree.points_finished();
+                        m_tree.points_finished(m_p_budget, [this]() {
+                            publish_partial();
+                        });
 
                         //Get the end stats and log them
                         REPORT_STATS(string("Initializing space optimizer"));
@@ -134,6 +167,15 @@ namespace tud {
                     virtual ~space_optimizer() {
                     }
                     
+                    /**
+                     * Allows to check if the resulting controller covers all states, it
+                     * does not if the budget was used up before all states were added
+                     * @return true if every state of the controller got an input
+                     */
+                    bool is_complete() const {
+                        return m_is_complete;
+                    }
+                    
                     /**
                      * Allows to optimize the controller by performing determinization in
                      * such a way that it minimizes the resulting BDD size.
@@ -143,12 +185,36 @@ namespace tud {
                         //Copy the symbolic set data
                         output_ctrl.m_ctrl_set = m_ctrl_set;
                         
+                        LOG_RESULT << "Determinization tree leaves: " << m_tree.count_leaves() << END_LOG;
+                        
                         //Get the binary tree as a BDD
                         m_tree.tree_to_bdd(m_cudd_mgr, output_ctrl.m_ctrl_bdd);
                     }
                     
                 protected:
                     
+                    /**
+                     * Throws budget_exceeded if the budget is used up
+                     */
+                    inline void check_budget() {
+                        if(m_p_budget != NULL) {
+                            m_p_budget->check();
+                        }
+                    }
+                    
+                    /**
+                     * Publishes the controller of the current tree if it is due
+                     */
+                    inline void publish_partial() {
+                        if(m_p_budget != NULL) {
+                            m_p_budget->publish_if_due([this]() -> BDD {
+                                BDD partial;
+                                m_tree.tree_to_bdd(m_cudd_mgr, partial);
+                                return partial;
+                            });
+                        }
+                    }
+                    
                 private:
                     //Stores the reference to the CUDD manage
                     const Cudd & m_cudd_mgr;
@@ -162,6 +228,10 @@ namespace tud {
                     states_mgr m_ss_mgr;
                     //Stores the space binary tree
                     space_tree_type m_tree;
+                    //Stores the determinization budget, NULL for unlimited
+                    det_budget * m_p_budget;
+                    //Stores whether the optimization finished within the budget
+                    bool m_is_complete;
                 };
 
             }
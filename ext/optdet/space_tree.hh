@@ -46,6 +46,7 @@
 
 #include "space_node.hh"
 #include "space_node_leaf.hh"
+#include "split_order.hh"
 
 using namespace std;
 using namespace scots;
@@ -81,8 +82,8 @@ namespace tud {
                      * @param is_mgr the inputs manager
                      */
                     space_tree(const bool is_cg, const states_mgr & ss_mgr, inputs_mgr & is_mgr):
-                    m_ss_mgr(ss_mgr), m_is_mgr(is_mgr), m_root(),
-                    m_is_cg(is_cg), m_det_est(), m_det_seq() {
+                    m_ss_mgr(ss_mgr), m_max_depth(0), m_depth_to_dof(),
+                    m_is_mgr(is_mgr), m_root(), m_is_cg(is_cg), m_det_est(), m_det_seq() {
                         LOG_DEBUG3 << "Creating space binary tree: " << this << END_LOG;
                         
                         //Get the symbilic set of the state space
@@ -92,11 +93,60 @@ namespace tud {
                         const size_t ss_dim = m_ss_mgr.get_dim();
                         for(size_t idx = 0; idx < ss_dim; ++idx) {
                             //Update the maximum tree depth by adding the number of bits
-                            space_node::m_max_depth() += ceil(log2(ss_set.get_no_grid_points(idx)));
+                            m_max_depth += ceil(log2(ss_set.get_no_grid_points(idx)));
                         }
                         
                         LOG_INFO << "The determinization tree depth is: "
-                        << space_node::m_max_depth() << END_LOG;
+                        << m_max_depth << END_LOG;
+                        
+                        //The path to a leaf must fit into an abstract id
+                        ASSERT_CONDITION_THROW((m_max_depth > 8 * sizeof(abs_type)),
+                                               string("The determinization tree depth: ") +
+                                               to_string(m_max_depth) + string(" exceeds the id bits: ") +
+                                               to_string(8 * sizeof(abs_type)));
+                    }
+
+                    /**
+                     * Allows to choose the order in which the tree splits the dimensions
+                     * from the controller, is to be called before the points are added.
+                     * By default the tree has a fixed split order and this is not supported.
+                     * @param order the way the split order is chosen
+                     * @param states the states of the controller domain, one after the other
+                     * @param inputs the inputs of each state
+                     */
+                    virtual void set_split_order(const split_order_enum order,
+                                                 const raw_data & /*states*/,
+                                                 const vector<set<abs_type>> & /*inputs*/) {
+                        if(order != split_order_enum::round_robin) {
+                            LOG_WARNING << "The split order of this determinization tree "
+                            << "is fixed by the BDD variable order!" << END_LOG;
+                        }
+                    }
+
+                    /**
+                     * Counts the leaves of the tree, each of them is a
+                     * controller domain region with a single input
+                     * @return the number of leaves
+                     */
+                    size_t count_leaves() {
+                        size_t num_leaves = 0;
+                        queue<space_node_ptr> nodes;
+                        nodes.push(&m_root);
+                        while(nodes.size() > 0) {
+                            space_node_ptr p_curr_node = nodes.front();
+                            nodes.pop();
+                            if(p_curr_node->is_leaf()) {
+                                ++num_leaves;
+                            } else {
+                                if(p_curr_node->m_p_left != NULL) {
+                                    nodes.push(p_curr_node->m_p_left);
+                                }
+                                if(p_curr_node->m_p_right != NULL) {
+                                    nodes.push(p_curr_node->m_p_right);
+                                }
+                            }
+                        }
+                        return num_leaves;
                     }
 
                     /**
@@ -132,14 +182,17 @@ namespace tud {
 
                     /**
                      * Must be called of all the points are added to the tree.
+                     * @param p_budget the determinization budget, NULL for unlimited
+                     * @param on_round if set, called at the end of every greedy round
                      */
-                    void points_finished() {
+                    void points_finished(det_budget * p_budget = NULL,
+                                         const function<void()> & on_round = function<void()>()) {
                         //If the global check is on then finish points
                         if(m_is_cg){
                             //Finalize the initial estimator creation
                             m_det_est.points_finished();
                             //Just use the bold greedy estimate for the determinization sequence
-                            m_det_est.compute_greedy_estimate(m_det_seq);
+                            m_det_est.compute_greedy_estimate(m_det_seq, p_budget, on_round);
                         }
                         
                         //Get the end stats and log them
@@ -247,37 +300,28 @@ namespace tud {
                      * @param path the path to the node that will be computed
                      */
                     inline void compute_nodes_path(const space_node_ptr p_node, size_t & depth, abs_type &path) {
-                        //Compute the type size in bits
-                        static const size_t ABS_TYPE_SIZE_BITS = 8 * sizeof(abs_type);
-                        //Compute the position of the left bit
-                        static const abs_type MOST_SIG_BIT_MASK = ((abs_type)1) << (ABS_TYPE_SIZE_BITS - 1);
-                        
                         //Make the copy of the pointer for internal use
                         space_node_ptr p_curr_node = p_node;
                         
-                        //Compute the node's depth path and depth
+                        //Compute the node's depth path and depth, the node's own
+                        //branch gets the least significant bit of the path
                         string path_str = "";
                         depth = 0; path = 0;
                         while(p_curr_node->m_p_parent != NULL) {
                             //Check which side of the parent we are
                             if(p_curr_node->m_p_parent->m_p_right == p_curr_node) {
                                 //The node is the right child
-                                path |= MOST_SIG_BIT_MASK;
+                                path |= ((abs_type) 1) << depth;
                                 path_str = string("1") + path_str;
                             } else {
                                 path_str = string("0") + path_str;
                             }
-                            //Shift the path to the right one position
-                            path >>=1;
                             //Increment the depth
                             ++depth;
                             //Move to the parent
                             p_curr_node = p_curr_node->m_p_parent;
                         }
                         
-                        //Now the path length is known so align everithing to the right
-                        path >>= (ABS_TYPE_SIZE_BITS - depth) - 1;
-                        
                         LOG_DEBUG << "Node depth: " << depth << ", path string: '"
                         << path_str << "', path: " << path << END_LOG;
                     }
@@ -301,18 +345,18 @@ namespace tud {
                      */
                     inline void add_branch_to_bdd(const size_t depth, const abs_type path,
                                                   const abs_type input_id, BDD & bdd) {
-                        ASSERT_SANITY_THROW(depth > space_node::m_max_depth(),
+                        ASSERT_SANITY_THROW(depth > m_max_depth,
                                             "Exceeded the maximum path depth!");
                         
                         LOG_DEBUG << "Considering depth: " << depth << "/"
-                        << space_node::m_max_depth() << ", path: " << path << END_LOG;
+                        << m_max_depth << ", path: " << path << END_LOG;
                         
                         //Check if we are at a leaf node yet
-                        if(depth < space_node::m_max_depth()) {
+                        if(depth < m_max_depth) {
                             const size_t new_depth = depth + 1;
                             
                             //Investigate the left branch - add 0 to the path
-                            size_t new_path = path<<1;
+                            abs_type new_path = path<<1;
                             add_branch_to_bdd(new_depth, new_path, input_id, bdd);
                             
                             //Investigate the right branch - add 1 to the path
@@ -421,14 +465,14 @@ namespace tud {
                      * @return the pointer to the next node or the newly created node
                      *          if the next node was null
                      */
-                    static inline space_node_ptr move_next_node(const size_t depth,
-                                                                const set<abs_type> & inputs,
-                                                                const space_node_ptr p_parent,
-                                                                space_node_ptr & p_next_node) {
+                    inline space_node_ptr move_next_node(const size_t depth,
+                                                         const set<abs_type> & inputs,
+                                                         const space_node_ptr p_parent,
+                                                         space_node_ptr & p_next_node) {
                         //Check if a new node is to be created
                         if(p_next_node == NULL) {
                             //If this is a leaf node, then create a leaf one
-                            if(depth + 1 == space_node::m_max_depth()) {
+                            if(depth + 1 == m_max_depth) {
                                 p_next_node = new space_node_leaf(p_parent, inputs);
                             } else {
                                 p_next_node = new space_node(p_parent);
@@ -447,7 +491,7 @@ namespace tud {
                         //Start from the root and traverse the path
                         space_node_ptr p_curr_node = &m_root;
                         size_t depth = 0;
-                        while(depth < space_node::m_max_depth()) {
+                        while(depth < m_max_depth) {
                             //Check if the dof bit directs us right or left
                             if( is_move_right(depth) ) {
                                 //We need to expand right
@@ -469,6 +513,10 @@ namespace tud {
                 protected:
                     //Stores reference to the controller's states manager
                     const states_mgr & m_ss_mgr;
+                    //Stores the depth of the tree leaves
+                    size_t m_max_depth;
+                    //Stores the dimension split at each depth of the tree
+                    vector<size_t> m_depth_to_dof;
                     
                 private:
                     //Stores reference to the controller's inputs manager
@@ -75,10 +75,10 @@ namespace tud {
                         LOG_DEBUG1 << "Creating space binary tree: " << this << END_LOG;
                         
                         //Compute the bit masks for the tree
-                        const size_t num_masks = space_node::m_max_depth();
+                        const size_t num_masks = space_tree::m_max_depth;
                         m_depth_masks = new abs_type[num_masks];
                         for(size_t idx = 0; idx < num_masks; ++idx) {
-                            m_depth_masks[idx] = 1<<(num_masks - idx - 1);
+                            m_depth_masks[idx] = ((abs_type) 1) << (num_masks - idx - 1);
                         }
                         
                         //Initialize the decoder
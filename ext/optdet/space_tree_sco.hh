@@ -86,7 +86,7 @@ namespace tud {
                             //Compute the number of bits needed to store grid points per dof
                             num_bits[idx] = ceil(log2(ss_set.get_no_grid_points(idx)));
                             //Create the major bit mask for the given dof
-                            m_dof_masks[idx] = 1<<(num_bits[idx]-1);
+                            m_dof_masks[idx] = (num_bits[idx] > 0) ? (((abs_type) 1) << (num_bits[idx] - 1)) : 0;
                             
                             LOG_DEBUG << "dof(" << num_bits[idx] << ") num points: "
                             << ss_set.get_no_grid_points(idx) << ", bits: " << num_bits[idx]
@@ -94,16 +94,16 @@ namespace tud {
                         }
                         
                         //Allocate the depth to dimension index array
-                        space_node::m_depth_to_dof() = new size_t[space_node::m_max_depth()]();
+                        space_tree::m_depth_to_dof.assign(space_tree::m_max_depth, 0);
                         
                         //Fill in the depth to dimension id array, since the binary
                         //tree will go on splitting the grid in each dimension in
                         //alternation the dimension bits will be interleaved
                         size_t depth = 0;
-                        while(depth < space_node::m_max_depth()) {
+                        while(depth < space_tree::m_max_depth) {
                             for(size_t dim = 0; dim < m_ss_dim ; ++dim) {
                                 if(num_bits[dim] > 0) {
-                                    space_node::m_depth_to_dof()[depth] = dim;
+                                    space_tree::m_depth_to_dof[depth] = dim;
                                     //Decrement the number of remaining bits
                                     num_bits[dim]--;
                                     //Increment the depth
@@ -113,8 +113,59 @@ namespace tud {
                         }
                         
                         LOG_INFO << "Dimensions split: "
-                        << array_to_string(space_node::m_max_depth(),
-                                           space_node::m_depth_to_dof()) << END_LOG;
+                        << vector_to_string(space_tree::m_depth_to_dof) << END_LOG;
+                    }
+                    
+                    /**
+                     * Chooses the order in which the tree splits the dimensions from the
+                     * controller, see split_order, is to be called before the points are added.
+                     * @param order the way the split order is chosen
+                     * @param states the states of the controller domain, one after the other
+                     * @param inputs the inputs of each state
+                     */
+                    virtual void set_split_order(const split_order_enum order,
+                                                 const raw_data & states,
+                                                 const vector<set<abs_type>> & inputs) {
+                        if(order == split_order_enum::round_robin) {
+                            return;
+                        }
+                        
+                        //Get the number of bits per dimension
+                        const SymbolicSet & ss_set = space_tree::m_ss_mgr.get_states_set();
+                        vector<size_t> num_bits(m_ss_dim);
+                        for(size_t idx = 0; idx < m_ss_dim; ++idx) {
+                            num_bits[idx] = ceil(log2(ss_set.get_no_grid_points(idx)));
+                        }
+                        
+                        //Give the controller to the split order planner
+                        split_order planner(num_bits);
+                        std::vector<abs_type> state_ids(m_ss_dim);
+                        raw_data state(m_ss_dim);
+                        for(size_t idx = 0; idx < inputs.size(); ++idx) {
+                            state.assign(states.begin() + idx * m_ss_dim, states.begin() + (idx + 1) * m_ss_dim);
+                            space_tree::m_ss_mgr.xtois(state, state_ids);
+                            planner.add_point(state_ids, inputs[idx]);
+                        }
+                        
+                        vector<size_t> depth_to_dof(space_tree::m_max_depth);
+                        const size_t rr_leaves = planner.count_leaves(space_tree::m_depth_to_dof);
+                        size_t num_leaves = 0;
+                        if(order == split_order_enum::greedy) {
+                            depth_to_dof = planner.greedy(num_leaves);
+                        } else {
+                            depth_to_dof = planner.search(num_leaves);
+                        }
+                        
+                        LOG_RESULT << "Round-robin split order leaves: " << rr_leaves
+                        << ", chosen split order leaves: " << num_leaves << END_LOG;
+                        
+                        //Keep the round-robin order unless the chosen one is better
+                        if(num_leaves < rr_leaves) {
+                            space_tree::m_depth_to_dof = depth_to_dof;
+                        }
+                        
+                        LOG_INFO << "Dimensions split: "
+                        << vector_to_string(space_tree::m_depth_to_dof) << END_LOG;
                     }
                     
                     /**
@@ -141,10 +192,10 @@ namespace tud {
                           [&](const size_t depth)->bool {
 #else
                           //Makes the C++ compiler crash on Mac OS X
-                          [&state_ids, &dof_masks](const size_t depth)->bool {
+                          [this, &state_ids, &dof_masks](const size_t depth)->bool {
 #endif
                             //Get the dof at the given depth
-                            size_t dof = space_node::m_depth_to_dof()[depth];
+                            size_t dof = space_tree::m_depth_to_dof[depth];
                             
                             LOG_DEBUG2 << "Depth: " << depth << ", dof_masks["
                             << dof << "] equals " << dof_masks[dof] << END_LOG;
@@ -167,10 +218,6 @@ namespace tud {
                         
                         //Delete the dof masks array
                         delete[] m_dof_masks;
-
-                        
-                        //Free the depths array
-                        delete[] space_node::m_depth_to_dof();
                     }
                     
                 protected:
@@ -183,7 +230,7 @@ namespace tud {
                      */
                     virtual abs_type leaf_path_to_state_id(const abs_type path) {
                         //Create the bit mask
-                        abs_type mask = 1<<(space_node::m_max_depth() - 1);
+                        abs_type mask = ((abs_type) 1) << (space_tree::m_max_depth - 1);
                         
                         //Declare the array for storing the bits
                         abs_type state_ids[m_ss_dim];
@@ -193,11 +240,11 @@ namespace tud {
                         
                         //Restore the state ids
                         string path_str = "";
-                        for(size_t idx = 0; idx < space_node::m_max_depth(); ++idx){
+                        for(size_t idx = 0; idx < space_tree::m_max_depth; ++idx){
                             LOG_DEBUG << "Current path mask: " << mask << END_LOG;
                             
                             //Get the dof for the depth
-                            const size_t depth_dim = space_node::m_depth_to_dof()[idx];
+                            const size_t depth_dim = space_tree::m_depth_to_dof[idx];
                             //Make space for new bit
                             state_ids[depth_dim] <<= 1;
                             //Set bit to one if it is marked in the path
@@ -0,0 +1,337 @@
+/*
+ * File:   split_order.hh
+ * Author: Antonio Rueda
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPLIT_ORDER_HPP
+#define SPLIT_ORDER_HPP
+
+#include <set>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include "scots.hh"
+
+#include "exceptions.hh"
+#include "logger.hh"
+#include "string_utils.hh"
+
+#include "det_tool_params.hh"
+
+using namespace std;
+using namespace scots;
+
+using namespace tud::utils::exceptions;
+using namespace tud::utils::logging;
+using namespace tud::utils::text;
+
+namespace tud {
+    namespace ctrl {
+        namespace scots {
+            namespace optimal {
+
+                //The largest number of dimensions for which all dimension permutations are searched
+#define MAX_SEARCH_PERM_DIM 4
+
+                /**
+                 * Chooses the order in which the determinization tree splits the
+                 * state-space dimensions, i.e. the depth to dof array, from the
+                 * controller itself. The tree merges two sibling leaves into their
+                 * parent whenever they share an input, and the result of these
+                 * merges does not depend on the order in which the points are added.
+                 * So the number of leaves of the tree for a given split order can be
+                 * computed bottom up, one depth at a time, without building the tree.
+                 * The bits of a dimension are always split from the most significant
+                 * one down, only the interleaving of the dimensions is chosen.
+                 */
+                class split_order {
+                public:
+
+                    /**
+                     * The basic constructor
+                     * @param num_bits the number of bits of every state-space dimension
+                     */
+                    split_order(const vector<size_t> & num_bits)
+                    : m_num_bits(num_bits), m_offsets(num_bits.size(), 0), m_max_depth(0), m_cells() {
+                        for(size_t dof = 0; dof < m_num_bits.size(); ++dof) {
+                            m_offsets[dof] = m_max_depth;
+                            m_max_depth += m_num_bits[dof];
+                        }
+                        ASSERT_CONDITION_THROW((m_max_depth > 64),
+                                               string("The state space needs more than 64 bits: ") +
+                                               to_string(m_max_depth));
+                    }
+
+                    /**
+                     * Adds a state of the controller domain
+                     * @param state_ids the grid ids of the state per dimension
+                     * @param input_ids the inputs of the state
+                     */
+                    void add_point(const vector<abs_type> & state_ids, const set<abs_type> & input_ids) {
+                        cell point;
+                        point.m_key = 0;
+                        for(size_t dof = 0; dof < m_num_bits.size(); ++dof) {
+                            point.m_key |= ((uint64_t) state_ids[dof]) << m_offsets[dof];
+                        }
+                        point.m_inputs.assign(input_ids.begin(), input_ids.end());
+                        point.m_is_leaf = true;
+                        m_cells.push_back(point);
+                    }
+
+                    /**
+                     * Computes the number of tree leaves for the given split order
+                     * @param depth_to_dof the dimension split at every depth, from the root down
+                     * @return the number of leaves of the tree
+                     */
+                    size_t count_leaves(const vector<size_t> & depth_to_dof) const {
+                        vector<cell> cells = m_cells;
+                        vector<size_t> used(m_num_bits.size(), 0);
+                        size_t num_leaves = 0;
+                        for(size_t depth = m_max_depth; depth > 0; --depth) {
+                            const size_t dof = depth_to_dof[depth - 1];
+                            num_leaves += merge(cells, split_bit(dof, used[dof]++));
+                        }
+                        for(const cell & root : cells) {
+                            num_leaves += root.m_is_leaf ? 1 : 0;
+                        }
+                        return num_leaves;
+                    }
+
+                    /**
+                     * Computes the split order greedily from the leaves up: at every depth
+                     * the dimension whose split gives the most merges of sibling leaves is
+                     * taken, ties are resolved in favor of the dimension with most bits left.
+                     * @param num_leaves the number of tree leaves for the resulting order
+                     * @return the depth to dof array
+                     */
+                    vector<size_t> greedy(size_t & num_leaves) const {
+                        vector<cell> cells = m_cells;
+                        vector<size_t> used(m_num_bits.size(), 0);
+                        vector<size_t> depth_to_dof(m_max_depth, 0);
+                        num_leaves = 0;
+                        for(size_t depth = m_max_depth; depth > 0; --depth) {
+                            size_t best_dof = m_num_bits.size(), best_merges = 0;
+                            for(size_t dof = 0; dof < m_num_bits.size(); ++dof) {
+                                if(used[dof] < m_num_bits[dof]) {
+                                    const size_t merges = count_merges(cells, split_bit(dof, used[dof]));
+                                    if((best_dof == m_num_bits.size()) || (merges > best_merges) ||
+                                       ((merges == best_merges) &&
+                                        (m_num_bits[dof] - used[dof] > m_num_bits[best_dof] - used[best_dof]))) {
+                                        best_dof = dof;
+                                        best_merges = merges;
+                                    }
+                                }
+                            }
+                            LOG_DEBUG << "Depth " << (depth - 1) << " splits dof " << best_dof
+                            << " with " << best_merges << " merges" << END_LOG;
+                            depth_to_dof[depth - 1] = best_dof;
+                            num_leaves += merge(cells, split_bit(best_dof, used[best_dof]++));
+                        }
+                        for(const cell & root : cells) {
+                            num_leaves += root.m_is_leaf ? 1 : 0;
+                        }
+                        return depth_to_dof;
+                    }
+
+                    /**
+                     * Computes the split order by trying the greedy order and the orders
+                     * that cycle through the dimensions taking groups of 1, 2, 4 or all
+                     * of their bits at once, for every permutation of the dimensions if
+                     * there are at most MAX_SEARCH_PERM_DIM of them, otherwise for the
+                     * natural and the reversed dimension order.
+                     * @param num_leaves the number of tree leaves for the resulting order
+                     * @return the depth to dof array with the fewest leaves
+                     */
+                    vector<size_t> search(size_t & num_leaves) const {
+                        vector<size_t> best = greedy(num_leaves);
+                        LOG_INFO << "Greedy split order: " << vector_to_string(best)
+                        << ", leaves: " << num_leaves << END_LOG;
+
+                        //Get the dimension orders to try
+                        vector<size_t> perm(m_num_bits.size());
+                        for(size_t dof = 0; dof < perm.size(); ++dof) {
+                            perm[dof] = dof;
+                        }
+                        vector<vector<size_t>> perms;
+                        if(perm.size() <= MAX_SEARCH_PERM_DIM) {
+                            do {
+                                perms.push_back(perm);
+                            } while(next_permutation(perm.begin(), perm.end()));
+                        } else {
+                            perms.push_back(perm);
+                            reverse(perm.begin(), perm.end());
+                            perms.push_back(perm);
+                        }
+
+                        const size_t group_sizes[] = {1, 2, 4, m_max_depth};
+                        for(const vector<size_t> & dofs : perms) {
+                            for(const size_t group_size : group_sizes) {
+                                const vector<size_t> depth_to_dof = grouped(dofs, group_size);
+                                const size_t leaves = count_leaves(depth_to_dof);
+                                LOG_INFO1 << "Split order: " << vector_to_string(depth_to_dof)
+                                << ", leaves: " << leaves << END_LOG;
+                                if(leaves < num_leaves) {
+                                    num_leaves = leaves;
+                                    best = depth_to_dof;
+                                }
+                            }
+                        }
+                        return best;
+                    }
+
+                    /**
+                     * Computes the split order that cycles through the dimensions in the
+                     * given order taking group_size bits of each of them at once
+                     * @param dofs the dimensions in the order they are cycled through
+                     * @param group_size the number of bits taken at once
+                     * @return the depth to dof array
+                     */
+                    vector<size_t> grouped(const vector<size_t> & dofs, const size_t group_size) const {
+                        vector<size_t> remaining = m_num_bits;
+                        vector<size_t> depth_to_dof;
+                        while(depth_to_dof.size() < m_max_depth) {
+                            for(const size_t dof : dofs) {
+                                for(size_t bit = 0; (bit < group_size) && (remaining[dof] > 0); ++bit) {
+                                    depth_to_dof.push_back(dof);
+                                    remaining[dof]--;
+                                }
+                            }
+                        }
+                        return depth_to_dof;
+                    }
+
+                private:
+
+                    /**
+                     * A node of the tree at the current depth: the state grid ids
+                     * without the bits split below it, the inputs if it is a leaf
+                     */
+                    struct cell {
+                        uint64_t m_key;
+                        vector<abs_type> m_inputs;
+                        bool m_is_leaf;
+                    };
+
+                    /**
+                     * The key bit of the given dimension split with the given
+                     * number of its bits already split below
+                     */
+                    inline uint64_t split_bit(const size_t dof, const size_t used) const {
+                        return ((uint64_t) 1) << (m_offsets[dof] + used);
+                    }
+
+                    /**
+                     * Checks if two sorted input vectors have a common input
+                     */
+                    static inline bool is_intersecting(const vector<abs_type> & a, const vector<abs_type> & b) {
+                        auto ia = a.begin(), ib = b.begin();
+                        while(ia != a.end() && ib != b.end()) {
+                            if(*ia == *ib) {
+                                return true;
+                            }
+                            if(*ia < *ib) {
+                                ++ia;
+                            } else {
+                                ++ib;
+                            }
+                        }
+                        return false;
+                    }
+
+                    /**
+                     * Counts the merges of sibling leaves when the given bit is split
+                     */
+                    static size_t count_merges(const vector<cell> & cells, const uint64_t bit) {
+                        unordered_map<uint64_t, size_t> index(cells.size());
+                        for(size_t idx = 0; idx < cells.size(); ++idx) {
+                            index[cells[idx].m_key] = idx;
+                        }
+                        size_t merges = 0;
+                        for(const cell & left : cells) {
+                            if(left.m_is_leaf && !(left.m_key & bit)) {
+                                auto right = index.find(left.m_key | bit);
+                                if((right != index.end()) && cells[right->second].m_is_leaf &&
+                                   is_intersecting(left.m_inputs, cells[right->second].m_inputs)) {
+                                    ++merges;
+                                }
+                            }
+                        }
+                        return merges;
+                    }
+
+                    /**
+                     * Replaces the cells by their parents for the split of the given bit,
+                     * two sibling leaves with a common input become a leaf
+                     * @return the number of leaves that are final, their parent not being a leaf
+                     */
+                    static size_t merge(vector<cell> & cells, const uint64_t bit) {
+                        unordered_map<uint64_t, size_t> index(cells.size());
+                        for(size_t idx = 0; idx < cells.size(); ++idx) {
+                            index[cells[idx].m_key] = idx;
+                        }
+                        vector<cell> parents;
+                        size_t num_final = 0;
+                        for(cell & child : cells) {
+                            auto sibling = index.find(child.m_key ^ bit);
+                            const bool has_sibling = (sibling != index.end());
+                            //The pair is handled once, by its left child
+                            if(has_sibling && (child.m_key & bit)) {
+                                continue;
+                            }
+                            cell parent;
+                            parent.m_key = child.m_key & ~bit;
+                            parent.m_is_leaf = false;
+                            if(has_sibling) {
+                                cell & right = cells[sibling->second];
+                                if(child.m_is_leaf && right.m_is_leaf) {
+                                    set_intersection(child.m_inputs.begin(), child.m_inputs.end(),
+                                                     right.m_inputs.begin(), right.m_inputs.end(),
+                                                     back_inserter(parent.m_inputs));
+                                    parent.m_is_leaf = !parent.m_inputs.empty();
+                                }
+                                if(!parent.m_is_leaf) {
+                                    num_final += (right.m_is_leaf ? 1 : 0);
+                                    parent.m_inputs.clear();
+                                }
+                                right.m_inputs.clear();
+                            }
+                            if(!parent.m_is_leaf) {
+                                num_final += (child.m_is_leaf ? 1 : 0);
+                            }
+                            child.m_inputs.clear();
+                            parents.push_back(move(parent));
+                        }
+                        cells.swap(parents);
+                        return num_final;
+                    }
+
+                    //The number of bits of every dimension
+                    const vector<size_t> m_num_bits;
+                    //The position of the bits of every dimension in the cell keys
+                    vector<size_t> m_offsets;
+                    //The total number of bits, the depth of the tree
+                    size_t m_max_depth;
+                    //The states of the controller domain with their inputs
+                    vector<cell> m_cells;
+                };
+            }
+        }
+    }
+}
+
+#endif /* SPLIT_ORDER_HPP */
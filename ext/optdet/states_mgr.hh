@@ -242,6 +242,16 @@ namespace tud {
                         return m_p_ss_set->bdd_to_grid_points(m_cudd_mgr, m_ss_bdd);
                     }
 
+                    /**
+                     * Allows to iterate over the state-space points, for which there are
+                     * input signals, without materializing them
+                     * @param func the function called with each grid point, in the order of get_points
+                     */
+                    template<typename FUNC>
+                    inline void for_each_point(FUNC && func) const {
+                        m_p_ss_set->for_each_grid_point(m_cudd_mgr, m_ss_bdd, func);
+                    }
+
                     /**
                      * Allows to get the number of states with input signals
                      * @return the number of states with input signals.
@@ -0,0 +1,294 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Node table of the BDDs of a controller as stored in the block RAM of
+   templates/bdd_engine.vhd, and a bit and cycle exact model of that engine to check
+   the table and its latency without hardware. The table can be read back from the
+   files of generate_bram.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <queue>
+#include <cstdint>
+#include <algorithm>
+#include "cuddObj.hh"
+
+using namespace std;
+
+//The BDDs as a table of node words, see templates/bdd_engine.vhd for the word layout
+struct BddTable {
+    int addr_bits;           //bits of a node address
+    int var_bits;            //bits of a variable index
+    int num_vars;            //number of BDD variables the engine reads, x(0) ... x(num_vars-1)
+    vector<uint64_t> words;  //node words, word 0 is the constant one node
+    vector<uint64_t> roots;  //root address << 1 | complement flag of each BDD
+};
+
+//Number of bits to represent the values 0 ... n-1, at least one
+int BitsFor(uint64_t n){
+    int bits = 1;
+    while (bits < 64 && (1ULL << bits) < n)
+        bits++;
+    return bits;
+}
+
+int WordBits(const BddTable& table){
+    return table.var_bits + 2*table.addr_bits + 1;
+}
+
+//The value as a string of width bits, most significant first
+string ToBits(uint64_t value, int width){
+    string bits(width, '0');
+    for (int i = 0; i < width && i < 64; i++)
+        if ((value >> i) & 1)
+            bits[width-1-i] = '1';
+    return bits;
+}
+
+//Serializes the BDDs, the nodes are numbered breadth first from the roots
+bool MakeBddTable(const vector<BDD>& bdds, BddTable& table){
+    map<DdNode*, uint64_t> address;
+    vector<DdNode*> nodes;
+    queue<DdNode*> pending;
+    nodes.push_back(NULL);
+    int max_var = 0;
+    for (size_t r = 0; r < bdds.size(); r++)
+        pending.push(Cudd_Regular(bdds[r].getNode()));
+    while (!pending.empty()) {
+        DdNode* node = pending.front();
+        pending.pop();
+        if (Cudd_IsConstant(node) || address.count(node))
+            continue;
+        address[node] = nodes.size();
+        nodes.push_back(node);
+        max_var = max(max_var, (int) Cudd_NodeReadIndex(node));
+        pending.push(Cudd_T(node));
+        pending.push(Cudd_Regular(Cudd_E(node)));
+    }
+
+    table.num_vars = max_var + 1;
+    table.addr_bits = BitsFor(nodes.size());
+    //The all ones index marks the constant node
+    table.var_bits = BitsFor(table.num_vars + 1);
+    if (WordBits(table) > 64) {
+        cerr << "The node words of " << nodes.size() << " nodes do not fit in 64 bits" << endl;
+        return false;
+    }
+
+    table.words.assign(nodes.size(), 0);
+    table.words[0] = ((1ULL << table.var_bits) - 1) << (2*table.addr_bits + 1);
+    for (size_t a = 1; a < nodes.size(); a++) {
+        DdNode* hi = Cudd_T(nodes[a]);
+        DdNode* lo = Cudd_E(nodes[a]);
+        const uint64_t hi_addr = Cudd_IsConstant(hi) ? 0 : address[hi];
+        const uint64_t lo_addr = Cudd_IsConstant(Cudd_Regular(lo)) ? 0 : address[Cudd_Regular(lo)];
+        table.words[a] = ((uint64_t) Cudd_NodeReadIndex(nodes[a]) << (2*table.addr_bits + 1))
+                       | (hi_addr << (table.addr_bits + 1)) | (lo_addr << 1)
+                       | (Cudd_IsComplement(lo) ? 1 : 0);
+    }
+    table.roots.clear();
+    for (size_t r = 0; r < bdds.size(); r++) {
+        DdNode* root = bdds[r].getNode();
+        const uint64_t root_addr = Cudd_IsConstant(Cudd_Regular(root)) ? 0 : address[Cudd_Regular(root)];
+        table.roots.push_back((root_addr << 1) | (Cudd_IsComplement(root) ? 1 : 0));
+    }
+    return true;
+}
+
+//The value of a generic of the engine in the port map of <target>_BDD.vhd, empty if there is none
+string ReadGeneric(const string& text, const string& name){
+    const size_t pos = text.find("\n" + name + " => ");
+    if (pos == string::npos)
+        return "";
+    const size_t start = pos + name.size() + 5;
+    string value = text.substr(start, text.find_first_of(",\n", start) - start);
+    value.erase(remove(value.begin(), value.end(), '"'), value.end());
+    return value;
+}
+
+/*Reads the table written by generate_bram, the node words from <target>.coe and the
+  generics of the engine from <target>_BDD.vhd. Returns false and sets error if they
+  can not be read or do not match*/
+bool ReadBddTable(const string& target, BddTable& table, string& error){
+    ifstream vhd(target + "_BDD.vhd");
+    ifstream coe(target + ".coe");
+    if (!vhd || !coe) {
+        error = "Could not open " + target + "_BDD.vhd and " + target + ".coe";
+        return false;
+    }
+    stringstream text;
+    text << vhd.rdbuf();
+    table.addr_bits = atoi(ReadGeneric(text.str(), "ADDR_BITS").c_str());
+    table.var_bits = atoi(ReadGeneric(text.str(), "VAR_BITS").c_str());
+    table.num_vars = atoi(ReadGeneric(text.str(), "NUM_VARS").c_str());
+    const size_t num_roots = atoi(ReadGeneric(text.str(), "NUM_ROOTS").c_str());
+    const string roots = ReadGeneric(text.str(), "ROOTS");
+    const size_t root_bits = table.addr_bits + 1;
+    if (table.addr_bits <= 0 || table.var_bits <= 0 || table.num_vars <= 0 || WordBits(table) > 64
+        || num_roots == 0 || roots.size() != num_roots * root_bits) {
+        error = "Could not read the engine generics of " + target + "_BDD.vhd";
+        return false;
+    }
+    //Root 0 is in the least significant bits
+    table.roots.clear();
+    for (size_t r = 0; r < num_roots; r++)
+        table.roots.push_back(stoull(roots.substr(roots.size() - (r+1) * root_bits, root_bits), NULL, 2));
+    table.words.clear();
+    string line;
+    while (getline(coe, line)) {
+        if (line.empty() || line[0] == ';' || line.find('=') != string::npos)
+            continue;
+        const string word = line.substr(0, line.find_first_of(",;"));
+        if ((int) word.size() != WordBits(table)) {
+            error = "The words of " + target + ".coe do not match " + target + "_BDD.vhd";
+            return false;
+        }
+        table.words.push_back(stoull(word, NULL, 2));
+    }
+    if (table.words.empty() || table.words.size() > (1ULL << table.addr_bits)) {
+        error = "The node table of " + target + ".coe does not match " + target + "_BDD.vhd";
+        return false;
+    }
+    //The engine must not leave the table
+    const uint64_t mask = (1ULL << table.addr_bits) - 1;
+    for (size_t a = 0; a < table.words.size(); a++) {
+        if (((table.words[a] >> (table.addr_bits + 1)) & mask) >= table.words.size()
+            || ((table.words[a] >> 1) & mask) >= table.words.size()) {
+            error = "A node of " + target + ".coe points outside the table";
+            return false;
+        }
+    }
+    for (size_t r = 0; r < num_roots; r++) {
+        if ((table.roots[r] >> 1) >= table.words.size()) {
+            error = "A root of " + target + "_BDD.vhd is not in " + target + ".coe";
+            return false;
+        }
+    }
+    return true;
+}
+
+//Number of nodes on the longest path from the node at addr to the constant node
+int LongestPath(const BddTable& table, uint64_t addr, vector<int>& memo){
+    if (addr == 0)
+        return 0;
+    if (memo[addr] < 0) {
+        const uint64_t mask = (1ULL << table.addr_bits) - 1;
+        const uint64_t hi = (table.words[addr] >> (table.addr_bits + 1)) & mask;
+        const uint64_t lo = (table.words[addr] >> 1) & mask;
+        memo[addr] = 1 + max(LongestPath(table, hi, memo), LongestPath(table, lo, memo));
+    }
+    return memo[addr];
+}
+
+//Worst case number of clock cycles from start to done: the start cycle and one per node, a constant root takes one
+int MaxLatency(const BddTable& table){
+    vector<int> memo(table.words.size(), -1);
+    int cycles = 1;
+    for (size_t r = 0; r < table.roots.size(); r++)
+        cycles += max(LongestPath(table, table.roots[r] >> 1, memo), 1);
+    return cycles;
+}
+
+//Bit and cycle exact model of bdd_engine.vhd and its block RAM, one call of Clock is one rising edge
+class BddEngineModel {
+    const BddTable& m_table;
+    bool m_walking;
+    size_t m_root;
+    uint64_t m_cur;
+    bool m_comp;
+    vector<bool> m_xr;
+    vector<bool> m_res;
+    bool m_done;
+    uint64_t m_mem_data;
+
+    uint64_t Field(uint64_t word, int low, int bits) const {
+        return (word >> low) & ((1ULL << bits) - 1);
+    }
+
+public:
+    BddEngineModel(const BddTable& table) : m_table(table), m_walking(false), m_root(0), m_cur(0),
+        m_comp(false), m_xr(table.num_vars, false), m_res(table.roots.size(), false), m_done(false),
+        m_mem_data(0) {}
+
+    void Clock(bool start, const vector<bool>& x){
+        const int ab = m_table.addr_bits;
+        bool next_walking = m_walking;
+        size_t next_root = m_root;
+        uint64_t next_cur = m_cur;
+        bool next_comp = m_comp;
+        vector<bool> next_res = m_res;
+        bool next_done = false;
+        bool finished = false;
+
+        if (!m_walking) {
+            if (start) {
+                next_walking = true;
+                next_root = 0;
+                next_cur = m_table.roots[0] >> 1;
+                next_comp = m_table.roots[0] & 1;
+            }
+        } else if (m_cur == 0) {
+            next_res[m_root] = !m_comp;
+            finished = true;
+        } else {
+            const uint64_t var = Field(m_mem_data, 2*ab + 1, m_table.var_bits);
+            uint64_t child;
+            bool child_comp;
+            if (var < (uint64_t) m_table.num_vars && m_xr[var]) {
+                child = Field(m_mem_data, ab + 1, ab);
+                child_comp = m_comp;
+            } else {
+                child = Field(m_mem_data, 1, ab);
+                child_comp = (m_comp != ((m_mem_data & 1) != 0));
+            }
+            if (child == 0) {
+                next_res[m_root] = !child_comp;
+                finished = true;
+            } else {
+                next_cur = child;
+                next_comp = child_comp;
+            }
+        }
+
+        if (finished) {
+            if (m_root == m_table.roots.size() - 1) {
+                next_walking = false;
+                next_done = true;
+                next_cur = 0;
+            } else {
+                next_root = m_root + 1;
+                next_cur = m_table.roots[next_root] >> 1;
+                next_comp = m_table.roots[next_root] & 1;
+            }
+        }
+
+        //The registers and the memory take their values at the same edge
+        if (!m_walking && start)
+            m_xr = x;
+        m_walking = next_walking;
+        m_root = next_root;
+        m_cur = next_cur;
+        m_comp = next_comp;
+        m_res = next_res;
+        m_done = next_done;
+        m_mem_data = m_table.words[next_cur];
+    }
+
+    //Runs one evaluation of x, returns the number of clock cycles from start to done
+    int Evaluate(const vector<bool>& x, vector<bool>& result){
+        Clock(true, x);
+        int cycles = 1;
+        while (!m_done) {
+            Clock(false, x);
+            cycles++;
+        }
+        result = m_res;
+        return cycles;
+    }
+};
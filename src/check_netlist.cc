@@ -0,0 +1,308 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Checks that the .blif file of generate_blif, and the verilog that abc
+   writes from it, implement the split determinized controller. Both the netlist and
+   the BDDs (as one multiplexer per node) are turned into gate arrays and simulated
+   bit-parallel, see netlist.hh. With up to FULL_SWEEP_BITS state bits all their values
+   are checked, otherwise all states of the controller domain and random states. The
+   optimized output codes of generate_blif (<blif>.codes) are taken into account.
+
+   Usage: check_netlist <source controller> <blif> <state_space_dim> [verilog] [max_reported]
+ */
+
+#include <iostream>
+#include <random>
+#include <chrono>
+#include "scots.hh"
+#include "optdet/cudd_mgr.hh"
+#include "split_controller.hh"
+#include "encode_inputs.hh"
+#include "netlist.hh"
+#include "wrapper.hh"
+
+using namespace std;
+using namespace scots;
+using namespace tud::ctrl::scots::optimal;
+
+//Largest number of state bits for which all their values are checked
+const int FULL_SWEEP_BITS = 28;
+//Number of random states checked in addition to the domain otherwise
+const uint64_t RANDOM_VECTORS = 1 << 22;
+
+//Compares a netlist with the BDD gate array on batches of SIM_VECTORS states
+class NetlistChecker {
+public:
+    NetlistChecker(const Netlist& reference, const Netlist& netlist, const vector<int>& input_var,
+                   const vector<vector<int> >& dim_vars, int max_reported)
+        : num_vectors(0), num_mismatches(0), ref(reference), net(netlist), dim_vars(dim_vars),
+          max_reported(max_reported), batch_size(0) {
+        //The position of each netlist input among the state variables
+        for (size_t i = 0; i < net.inputs.size(); i++)
+            net_input_pos.push_back(input_var[i]);
+        ref_values.resize(ref.gates.size());
+        net_values.resize(net.gates.size());
+        Clear();
+    }
+
+    //Adds a state, bits holds the value of every state variable
+    void Add(const vector<char>& bits){
+        for (size_t v = 0; v < bits.size(); v++)
+            if (bits[v])
+                ref_values[ref.inputs[v]].w[batch_size / 64] |= 1ULL << (batch_size % 64);
+        if (++batch_size == SIM_VECTORS)
+            Flush();
+    }
+
+    //Adds all SIM_VECTORS states whose variables from the first one up are given by
+    //the lane index and whose other variables are those of base
+    void AddBlock(const vector<char>& base, int low_bits){
+        for (size_t v = 0; v < base.size(); v++) {
+            uint64_t* w = ref_values[ref.inputs[v]].w;
+            for (int k = 0; k < SIM_WORDS; k++) {
+                if ((int) v < low_bits && v < 6)
+                    w[k] = LanePattern(v);
+                else if ((int) v < low_bits)
+                    w[k] = ((k >> (v - 6)) & 1) ? ~0ULL : 0;
+                else
+                    w[k] = base[v] ? ~0ULL : 0;
+            }
+        }
+        batch_size = SIM_VECTORS;
+        Flush();
+    }
+
+    //Checks the states of the batch
+    void Flush(){
+        if (batch_size == 0)
+            return;
+        for (size_t i = 0; i < net.inputs.size(); i++)
+            net_values[net.inputs[i]] = ref_values[ref.inputs[net_input_pos[i]]];
+        ref.Simulate(ref_values);
+        net.Simulate(net_values);
+        for (size_t o = 0; o < ref.outputs.size(); o++) {
+            for (int k = 0; k < SIM_WORDS && k * 64 < batch_size; k++) {
+                uint64_t diff = ref_values[ref.outputs[o]].w[k] ^ net_values[net.outputs[o]].w[k];
+                if (batch_size - k * 64 < 64)
+                    diff &= (1ULL << (batch_size - k * 64)) - 1;
+                while (diff) {
+                    const int lane = k * 64 + __builtin_ctzll(diff);
+                    diff &= diff - 1;
+                    if (num_mismatches++ < (uint64_t) max_reported)
+                        Report(o, lane);
+                }
+            }
+        }
+        num_vectors += batch_size;
+        Clear();
+    }
+
+    uint64_t num_vectors, num_mismatches;
+
+private:
+    const Netlist& ref;
+    const Netlist& net;
+    const vector<vector<int> >& dim_vars;
+    const int max_reported;
+    vector<int> net_input_pos;
+    vector<SimWord> ref_values, net_values;
+    int batch_size;
+
+    static uint64_t LanePattern(int bit){
+        static const uint64_t patterns[6] = {0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+                                             0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+        return patterns[bit];
+    }
+
+    void Clear(){
+        for (size_t i = 0; i < ref.inputs.size(); i++)
+            for (int k = 0; k < SIM_WORDS; k++)
+                ref_values[ref.inputs[i]].w[k] = 0;
+        batch_size = 0;
+    }
+
+    //Prints the grid indices of the state of a lane and the output that differs
+    void Report(size_t output, int lane){
+        cout << "Mismatch in output " << output << " (" << net.output_names[output] << ") at state (";
+        size_t v = 0;
+        for (size_t d = 0; d < dim_vars.size(); d++) {
+            uint64_t idx = 0;
+            for (size_t j = 0; j < dim_vars[d].size(); j++, v++)
+                idx = (idx << 1) | ((ref_values[ref.inputs[v]].w[lane / 64] >> (lane % 64)) & 1);
+            cout << (d ? ", " : "") << idx;
+        }
+        cout << "): expected " << ((ref_values[ref.outputs[output]].w[lane / 64] >> (lane % 64)) & 1)
+             << ", netlist gives " << ((net_values[net.outputs[output]].w[lane / 64] >> (lane % 64)) & 1) << endl;
+    }
+};
+
+/*Checks a netlist against the BDD gate array, returns the number of mismatches*/
+uint64_t CheckNetlist(const Cudd& manager, const BDD& domain, const Netlist& ref, const Netlist& net,
+                      const vector<int>& state_vars, const vector<vector<int> >& dim_vars,
+                      const vector<string>& blif_inputs, int max_reported){
+    //The netlist inputs are named after their BDD variables in the blif
+    vector<int> input_var;
+    for (size_t i = 0; i < net.inputs.size(); i++) {
+        const string& name = blif_inputs.empty() ? net.input_names[i] : blif_inputs.at(i);
+        vector<int>::const_iterator pos = find(state_vars.begin(), state_vars.end(), atoi(name.c_str()));
+        if (pos == state_vars.end()) {
+            cerr << "Input " << net.input_names[i] << " is not a state variable" << endl;
+            return 1;
+        }
+        input_var.push_back(pos - state_vars.begin());
+    }
+    if (net.outputs.size() != ref.outputs.size()) {
+        cerr << "The netlist has " << net.outputs.size() << " outputs instead of " << ref.outputs.size() << endl;
+        return 1;
+    }
+
+    NetlistChecker checker(ref, net, input_var, dim_vars, max_reported);
+    const int n = state_vars.size();
+    vector<char> bits(n, 0);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    if (n <= FULL_SWEEP_BITS) {
+        if (n < 8) {
+            for (uint64_t s = 0; s < (1ULL << n); s++) {
+                for (int v = 0; v < n; v++)
+                    bits[v] = (s >> v) & 1;
+                checker.Add(bits);
+            }
+        } else {
+            //The simulator inputs are in the order of the state variables, give the
+            //lanes to the first ones and count with the others
+            for (uint64_t s = 0; s < (1ULL << (n - 8)); s++) {
+                for (int v = 8; v < n; v++)
+                    bits[v] = (s >> (v - 8)) & 1;
+                checker.AddBlock(bits, 8);
+            }
+        }
+        checker.Flush();
+        cout << "Checked all " << checker.num_vectors << " states" << endl;
+    } else {
+        //All states of the domain, the cubes are expanded over their don't cares
+        DdGen* gen;
+        int* cube;
+        CUDD_VALUE_TYPE value;
+        Cudd_ForeachCube(manager.getManager(), domain.getNode(), gen, cube, value) {
+            vector<int> free;
+            for (int v = 0; v < n; v++) {
+                bits[v] = (cube[state_vars[v]] == 1);
+                if (cube[state_vars[v]] == 2)
+                    free.push_back(v);
+            }
+            if (free.size() >= 64) {
+                cerr << "The domain is too large to be checked state by state" << endl;
+                Cudd_GenFree(gen);
+                return 1;
+            }
+            for (uint64_t s = 0; s < (1ULL << free.size()); s++) {
+                for (size_t f = 0; f < free.size(); f++)
+                    bits[free[f]] = (s >> f) & 1;
+                checker.Add(bits);
+            }
+        }
+        const uint64_t domain_vectors = checker.num_vectors;
+        mt19937_64 random(1);
+        for (uint64_t s = 0; s < RANDOM_VECTORS; s++) {
+            uint64_t word = 0;
+            for (int v = 0; v < n; v++, word >>= 1) {
+                if (v % 64 == 0)
+                    word = random();
+                bits[v] = word & 1;
+            }
+            checker.Add(bits);
+        }
+        checker.Flush();
+        cout << "Checked all " << domain_vectors << " states of the domain and "
+             << RANDOM_VECTORS << " random states" << endl;
+    }
+    const double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << checker.num_mismatches << " mismatches, " << net.gates.size() << " netlist gates, "
+         << secs << " s, " << checker.num_vectors / max(secs, 1e-9) / 1e6 << " M states/s" << endl;
+    return checker.num_mismatches;
+}
+
+int main(int argc, char* argv[]){
+
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <source controller> <blif> <state_space_dim> [verilog] [max_reported]" << std::endl;
+        return 1;
+    }
+    cout << "\n\nChecking the netlist of the split controller" << endl;
+    Cudd manager = create_cudd_mgr(argv[1], 0);
+    const string scs_file = string(argv[1]) + ".scs";
+    const string blif_file = argv[2];
+    const int state_dim = atoi(argv[3]);
+    const string verilog_file = (argc > 4) ? argv[4] : "";
+    const int max_reported = (argc > 5) ? atoi(argv[5]) : 10;
+
+    vector<int> readed_inputs = read_input_vars(state_dim, scs_file.c_str());
+    BDD C;
+    scots::SymbolicSet controller;
+    if (!read_from_file(manager, controller, C, argv[1])) {
+        cerr << "Could not read controller " << argv[1] << endl;
+        return 1;
+    }
+    if (readed_inputs.empty()) {
+        cerr << "No input variables in " << scs_file << endl;
+        return 1;
+    }
+    if (!Read_Modes(blif_file + ".modes").empty()) {
+        cerr << "Bundles of several controllers are not supported" << endl;
+        return 1;
+    }
+
+    //The outputs of the blif, with the optimized codes if there are
+    vector<BDD> s = split_controller(manager, C, readed_inputs);
+    const vector<long long> codes = Read_Codes(blif_file + ".codes");
+    if (!codes.empty()) {
+        if (codes.size() != (1ULL << readed_inputs.size())) {
+            cerr << "The decode table " << blif_file << ".codes does not match the controller" << endl;
+            return 1;
+        }
+        encoded_outputs(manager, code_state_sets(manager, C, readed_inputs), vector<int>(codes.begin(), codes.end()), s);
+        cout << "Using the output codes of " << blif_file << ".codes" << endl;
+    }
+
+    //The state variables, most significant first in each dimension
+    vector<int> state_vars;
+    vector<vector<int> > dim_vars;
+    for (int k = 0; k < state_dim; k++) {
+        vector<double> vars = Read_ScsVector(scs_file, "BDD_VAR_ID_IN_DIM_" + to_string(k+1));
+        dim_vars.push_back(vector<int>(vars.begin(), vars.end()));
+        state_vars.insert(state_vars.end(), vars.begin(), vars.end());
+    }
+    Netlist ref;
+    if (!BddNetlist(s, state_vars, ref)) {
+        cerr << "The split controller depends on variables other than the state" << endl;
+        return 1;
+    }
+
+    string error;
+    Netlist blif;
+    if (!ReadBlifNetlist(blif_file, blif, error)) {
+        cerr << error << endl;
+        return 1;
+    }
+    cout << "\n" << blif_file << ":" << endl;
+    uint64_t mismatches = CheckNetlist(manager, s.back(), ref, blif, state_vars, dim_vars, vector<string>(), max_reported);
+
+    //The verilog inputs follow the order of the blif inputs, as in the wrapper
+    if (!verilog_file.empty()) {
+        Netlist verilog;
+        if (!ReadVerilogNetlist(verilog_file, verilog, error)) {
+            cerr << error << endl;
+            return 1;
+        }
+        if (verilog.inputs.size() != blif.inputs.size()) {
+            cerr << "The inputs of " << verilog_file << " do not match " << blif_file << endl;
+            return 1;
+        }
+        cout << "\n" << verilog_file << ":" << endl;
+        mismatches += CheckNetlist(manager, s.back(), ref, verilog, state_vars, dim_vars, blif.input_names, max_reported);
+    }
+    report_cudd_mgr_stats(manager);
+
+    return mismatches ? 1 : 0;
+}
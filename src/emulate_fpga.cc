@@ -0,0 +1,454 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Software stand-in for the controller on the myRIO FPGA. It loads the
+   netlist of generate_blif (with its .codes) or the block RAM table of generate_bram
+   together with the grid of the controller, and evaluates them as the quantized wrapper
+   does: the fixed-point quantizer of wrapper.cc, the controller, and the decoder of the
+   input values, bit for bit. The netlist takes QUANTIZER_LATENCY clock cycles, the
+   block RAM the three quantizer stages, the cycles of the model of bdd_engine.vhd from
+   start to done and the decoder stage.
+
+   The emulator answers states sent to a UDP port on localhost. With the name of an
+   example plant (dcdc, vehicle or aircraft, see plants.hh) it also runs that plant in
+   closed loop over the port, starting over from the initial state of its simulate.cc
+   when it reaches the target or leaves the domain of the controller. A step can be
+   released every period_us microseconds, otherwise the steps run back to back. It
+   reports the emulated latency of the steps in clock cycles, the round trip and the
+   release jitter of the steps in wall time as histograms, and writes the trajectory
+   to <image>_trajectory.txt. With - instead of a plant it serves an external plant
+   for the given number of steps, or until it sends a state of dimension 0.
+
+   Usage: emulate_fpga <source controller> <image> <state_space_dim> <plant|-> [steps] [fraction_bits] [period_us] [port]
+
+   The image is a .blif file or the target of generate_bram. The messages are the
+   StateMsg and InputMsg structures below, in the byte order of the host.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include "netlist.hh"
+#include "bdd_engine.hh"
+#include "wrapper.hh"
+#include "quantizer.hh"
+#include "plants.hh"
+
+using namespace std;
+
+//Clock of the FPGA top level of the myRIO in MHz
+const double MYRIO_CLOCK_MHZ = 40.0;
+//Largest number of state or input dimensions of a message
+const int MAX_MSG_DIM = 8;
+//Default number of closed loop steps
+const int DEFAULT_STEPS = 10000;
+//Time the plant waits for the answer of a step, in ms
+const int REPLY_TIMEOUT_MS = 1000;
+//Number of buckets of the histograms
+const int HIST_BUCKETS = 16;
+
+//A state sent to the emulator, dim 0 stops it
+struct StateMsg {
+    uint32_t seq;
+    uint32_t dim;
+    double x[MAX_MSG_DIM];
+};
+
+//The answer of the emulator, the input values are valid if the state is in the controller domain
+struct InputMsg {
+    uint32_t seq;
+    uint32_t valid;
+    uint32_t cycles;
+    uint32_t dim;
+    double u[MAX_MSG_DIM];
+};
+
+/*The quantized wrapper around a netlist or a block RAM table, see wrapper.cc. The
+  controller outputs are the bits of the input BDD variables, or their codes, and the
+  domain bit last*/
+class FpgaEmulator {
+public:
+    FpgaEmulator() : is_bram(false), frac_bits(FXP_FRAC_BITS), first_var(0), no_outputs(0) {}
+
+    //Reads the grid of the controller and the image, returns false and sets error if it can not
+    bool Load(const string& scs_file, const string& image, int state_dim, int fraction_bits, string& error){
+        frac_bits = fraction_bits;
+        const vector<double> eta = Read_ScsVector(scs_file, "ETA");
+        const vector<double> lower = Read_ScsVector(scs_file, "LOWER_LEFT");
+        const vector<double> upper = Read_ScsVector(scs_file, "UPPER_RIGHT");
+        const int dim = eta.size();
+        if (dim == 0 || (int) lower.size() != dim || (int) upper.size() != dim || state_dim <= 0 || state_dim >= dim
+            || state_dim > MAX_MSG_DIM || dim - state_dim > MAX_MSG_DIM) {
+            error = "Could not read the grid of " + scs_file + " for state dimension " + to_string(state_dim);
+            return false;
+        }
+        int max_var = 0;
+        for (int k = 0; k < dim; k++) {
+            const vector<double> vars = Read_ScsVector(scs_file, "BDD_VAR_ID_IN_DIM_" + to_string(k+1));
+            if (vars.empty()) {
+                error = "No BDD variables of dimension " + to_string(k+1) + " in " + scs_file;
+                return false;
+            }
+            dim_vars.push_back(vector<int>(vars.begin(), vars.end()));
+            max_var = max(max_var, *max_element(dim_vars.back().begin(), dim_vars.back().end()));
+        }
+        var_values.assign(max_var + 1, false);
+        for (int k = 0; k < state_dim; k++) {
+            FxpDim fxp;
+            if (!MakeFxpDim(eta, lower, upper, k, frac_bits, fxp)) {
+                error = "State dimension " + to_string(k+1) + " can not be quantized in <" + to_string(FXP_WORD_BITS)
+                      + "," + to_string(frac_bits) + "> fixed-point";
+                return false;
+            }
+            fxp_dims.push_back(fxp);
+        }
+        //The decoder tables, the output bits are numbered from the first input BDD variable
+        first_var = dim_vars[state_dim][0];
+        int no_input_vars = 0;
+        for (int m = state_dim; m < dim; m++) {
+            const long long num = llround((upper[m] - lower[m]) / eta[m]) + 1;
+            vector<long long> rom;
+            for (long long i = 0; i < (1LL << dim_vars[m].size()); i++)
+                rom.push_back(FxpInputValue(eta, lower, num, m, i, frac_bits));
+            u_roms.push_back(rom);
+            no_input_vars += dim_vars[m].size();
+        }
+        no_outputs = no_input_vars + 1;
+
+        const bool is_blif = image.size() > 5 && image.substr(image.size() - 5) == ".blif";
+        is_bram = !is_blif;
+        if (is_bram) {
+            if (!ReadBddTable(image, table, error))
+                return false;
+            if ((int) table.roots.size() != no_outputs) {
+                error = "The node table of " + image + " does not match the input bits of the controller";
+                return false;
+            }
+            engine.reset(new BddEngineModel(table));
+            engine_x.assign(table.num_vars, false);
+            return true;
+        }
+        if (!ReadBlifNetlist(image, net, error))
+            return false;
+        codes = Read_Codes(image + ".codes");
+        if (!Read_Modes(image + ".modes").empty()) {
+            error = "Bundles of several controllers are not supported";
+            return false;
+        }
+        const bool outputs_match = codes.empty() ? ((int) net.outputs.size() == no_outputs)
+            : (net.outputs.size() > 1 && codes.size() == (1ULL << (net.outputs.size() - 1)));
+        if (!outputs_match) {
+            error = "The outputs of " + image + " do not match the input bits of the controller";
+            return false;
+        }
+        for (size_t i = 0; i < net.inputs.size(); i++) {
+            const int var = atoi(net.input_names[i].c_str());
+            if (var < 0 || var > max_var) {
+                error = "Input " + net.input_names[i] + " of " + image + " is not a BDD variable";
+                return false;
+            }
+            net_input_vars.push_back(var);
+        }
+        net_values.resize(net.gates.size());
+        return true;
+    }
+
+    //Largest number of clock cycles of a step
+    int MaxCycles() const {
+        return is_bram ? MaxLatency(table) + QUANTIZER_LATENCY - 1 : QUANTIZER_LATENCY;
+    }
+
+    string Describe() const {
+        stringstream ss;
+        if (is_bram)
+            ss << "block RAM table of " << table.words.size() << " words of " << WordBits(table) << " bits";
+        else
+            ss << "netlist of " << net.gates.size() << " gates" << (codes.empty() ? "" : " with output codes");
+        return ss.str();
+    }
+
+    //Runs one step from the state x, sets the input values u and returns the clock cycles it takes
+    int Step(const double* x, double* u, bool& valid){
+        //1-3: offset, scale, grid index and range check
+        bool in_range = true;
+        for (size_t k = 0; k < fxp_dims.size(); k++) {
+            uint64_t idx;
+            in_range &= FxpQuantize(fxp_dims[k], FxpFromDouble(x[k], frac_bits), idx);
+            const size_t nb = dim_vars[k].size();
+            for (size_t j = 0; j < nb; j++)
+                var_values[dim_vars[k][j]] = (idx >> (nb-1-j)) & 1;
+        }
+        //4: controller outputs
+        int cycles;
+        vector<bool> outputs(no_outputs);
+        if (is_bram) {
+            for (int v = 0; v < table.num_vars; v++)
+                engine_x[v] = (v < (int) var_values.size()) && var_values[v];
+            vector<bool> result;
+            cycles = (QUANTIZER_LATENCY - 2) + engine->Evaluate(engine_x, result) + 1;
+            outputs = result;
+        } else {
+            for (size_t i = 0; i < net.inputs.size(); i++)
+                net_values[net.inputs[i]].w[0] = var_values[net_input_vars[i]] ? 1 : 0;
+            net.Simulate(net_values);
+            vector<bool> po(net.outputs.size());
+            for (size_t o = 0; o < net.outputs.size(); o++)
+                po[o] = net_values[net.outputs[o]].w[0] & 1;
+            if (!codes.empty()) {
+                uint64_t code = 0;
+                for (size_t j = 0; j + 1 < po.size(); j++)
+                    code |= (uint64_t) po[j] << j;
+                for (int j = 0; j + 1 < no_outputs; j++)
+                    outputs[j] = (codes[code] >> j) & 1;
+                outputs.back() = po.back();
+            } else {
+                outputs = po;
+            }
+            cycles = QUANTIZER_LATENCY;
+        }
+        //5: input values, valid if the state is in the controller domain
+        valid = outputs.back() && in_range;
+        for (size_t m = 0; m < u_roms.size(); m++) {
+            const vector<int>& vars = dim_vars[fxp_dims.size() + m];
+            const size_t nb = vars.size();
+            uint64_t uidx = 0;
+            for (size_t j = 0; j < nb; j++)
+                uidx |= (uint64_t) outputs[vars[j] - first_var] << (nb-1-j);
+            u[m] = ldexp((double) u_roms[m][uidx], -frac_bits);
+        }
+        return cycles;
+    }
+
+    int InputDim() const {
+        return u_roms.size();
+    }
+
+private:
+    bool is_bram;
+    int frac_bits;
+    int first_var;
+    int no_outputs;
+    //BDD variable ids of every dimension, the most significant bit first
+    vector<vector<int> > dim_vars;
+    vector<FxpDim> fxp_dims;
+    vector<vector<long long> > u_roms;
+    //The value of every BDD variable in the current step
+    vector<bool> var_values;
+    BddTable table;
+    unique_ptr<BddEngineModel> engine;
+    vector<bool> engine_x;
+    Netlist net;
+    vector<int> net_input_vars;
+    vector<long long> codes;
+    vector<SimWord> net_values;
+};
+
+//Prints the percentiles of the samples and their counts in HIST_BUCKETS buckets between the smallest and the largest
+void PrintHistogram(const string& title, const string& unit, vector<double> samples, bool integral){
+    if (samples.empty())
+        return;
+    sort(samples.begin(), samples.end());
+    const size_t n = samples.size();
+    const double mean = accumulate(samples.begin(), samples.end(), 0.0) / n;
+    cout << "\n" << title << " (" << unit << "), " << n << " steps" << endl
+         << "  min " << samples[0] << ", mean " << mean << ", p50 " << samples[n/2]
+         << ", p99 " << samples[(n*99)/100] << ", max " << samples[n-1] << endl;
+    double width = (samples[n-1] - samples[0]) / HIST_BUCKETS;
+    if (integral)
+        width = max(1.0, ceil(width));
+    if (width <= 0)
+        width = 1;
+    vector<size_t> counts(HIST_BUCKETS, 0);
+    for (size_t i = 0; i < n; i++)
+        counts[min(HIST_BUCKETS - 1, (int) ((samples[i] - samples[0]) / width))]++;
+    const size_t peak = *max_element(counts.begin(), counts.end());
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        if (counts[b] == 0)
+            continue;
+        const double from = samples[0] + b * width;
+        cout << "  " << setw(10) << from;
+        if (integral && width == 1)
+            cout << setw(13) << "";
+        else
+            cout << " .. " << setw(9) << (integral ? from + width - 1 : from + width);
+        cout << setw(9) << counts[b] << " " << string((40 * counts[b] + peak - 1) / peak, '#') << endl;
+    }
+}
+
+//Answers the states on the socket until the steps are served or a state of dimension 0
+void Serve(int sock, FpgaEmulator& emu, int state_dim, size_t steps, vector<double>& cycles){
+    StateMsg request;
+    InputMsg reply;
+    sockaddr_in from;
+    while (steps == 0 || cycles.size() < steps) {
+        socklen_t len = sizeof(from);
+        const ssize_t got = recvfrom(sock, &request, sizeof(request), 0, (sockaddr*) &from, &len);
+        if (got < (ssize_t) (2 * sizeof(uint32_t)))
+            continue;
+        if (request.dim == 0)
+            break;
+        memset(&reply, 0, sizeof(reply));
+        reply.seq = request.seq;
+        reply.dim = emu.InputDim();
+        if ((int) request.dim == state_dim) {
+            bool valid;
+            reply.cycles = emu.Step(request.x, reply.u, valid);
+            reply.valid = valid;
+            cycles.push_back(reply.cycles);
+        }
+        sendto(sock, &reply, sizeof(reply), 0, (sockaddr*) &from, len);
+    }
+}
+
+int main(int argc, char* argv[]){
+
+    if (argc < 5) {
+        std::cerr << "Usage: " << argv[0] << " <source controller> <image> <state_space_dim> <plant|->"
+                  << " [steps] [fraction_bits] [period_us] [port]" << std::endl;
+        return 1;
+    }
+    cout << "\n\nEmulating the FPGA controller" << endl;
+    const string scs_file = string(argv[1]) + ".scs";
+    const string image = argv[2];
+    const int state_dim = atoi(argv[3]);
+    const string plant_name = argv[4];
+    const int steps = (argc > 5) ? atoi(argv[5]) : DEFAULT_STEPS;
+    const int frac_bits = (argc > 6) ? atoi(argv[6]) : FXP_FRAC_BITS;
+    const int period_us = (argc > 7) ? atoi(argv[7]) : 0;
+    const int port = (argc > 8) ? atoi(argv[8]) : 0;
+
+    FpgaEmulator emu;
+    string error;
+    if (!emu.Load(scs_file, image, state_dim, frac_bits, error)) {
+        cerr << error << endl;
+        return 1;
+    }
+    Plant plant;
+    const bool closed_loop = (plant_name != "-");
+    if (closed_loop && !MakePlant(plant_name, plant)) {
+        cerr << "Unknown plant " << plant_name << ", use dcdc, vehicle or aircraft" << endl;
+        return 1;
+    }
+    if (closed_loop && (plant.state_dim != state_dim || plant.input_dim != emu.InputDim())) {
+        cerr << "The plant " << plant_name << " does not match the dimensions of the controller" << endl;
+        return 1;
+    }
+    cout << image << ": " << emu.Describe() << ", at most " << emu.MaxCycles() << " clock cycles ("
+         << emu.MaxCycles() / MYRIO_CLOCK_MHZ << " us at " << MYRIO_CLOCK_MHZ << " MHz)" << endl;
+
+    const int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    socklen_t addr_len = sizeof(addr);
+    if (sock < 0 || ::bind(sock, (sockaddr*) &addr, sizeof(addr)) < 0
+        || getsockname(sock, (sockaddr*) &addr, &addr_len) < 0) {
+        cerr << "Could not open UDP port " << port << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    cout << "Serving states on 127.0.0.1:" << ntohs(addr.sin_port) << endl;
+
+    vector<double> cycles;
+    if (!closed_loop) {
+        Serve(sock, emu, state_dim, max(steps, 0), cycles);
+        close(sock);
+        PrintHistogram("Emulated latency", "clock cycles", cycles, true);
+        return 0;
+    }
+
+    //The emulator answers on its own thread, the plant sends it one state per step
+    thread server(Serve, sock, ref(emu), state_dim, 0, ref(cycles));
+    const int client = socket(AF_INET, SOCK_DGRAM, 0);
+    timeval timeout = {REPLY_TIMEOUT_MS / 1000, (REPLY_TIMEOUT_MS % 1000) * 1000};
+    if (client < 0 || setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0
+        || connect(client, (sockaddr*) &addr, sizeof(addr)) < 0) {
+        cerr << "Could not connect to the emulator: " << strerror(errno) << endl;
+        return 1;
+    }
+    ofstream trajectory(image + "_trajectory.txt");
+    trajectory << "# step x[0.." << state_dim-1 << "] u[0.." << plant.input_dim-1 << "] valid cycles" << endl;
+    vector<double> round_trip, jitter;
+    int runs = 1, arrived = 0, left = 0, lost = 0;
+    vector<double> x = plant.x0;
+    StateMsg request;
+    InputMsg reply;
+    chrono::steady_clock::time_point release = chrono::steady_clock::now();
+    for (int s = 0; s < steps; s++) {
+        if (period_us > 0) {
+            release += chrono::microseconds(period_us);
+            this_thread::sleep_until(release);
+        }
+        const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        if (period_us > 0)
+            jitter.push_back(chrono::duration<double, micro>(start - release).count());
+        memset(&request, 0, sizeof(request));
+        request.seq = s;
+        request.dim = state_dim;
+        copy(x.begin(), x.end(), request.x);
+        ssize_t got = -1;
+        if (send(client, &request, sizeof(request), 0) == (ssize_t) sizeof(request)) {
+            do {
+                got = recv(client, &reply, sizeof(reply), 0);
+            } while (got == (ssize_t) sizeof(reply) && reply.seq != request.seq);
+        }
+        if (got != (ssize_t) sizeof(reply)) {
+            lost++;
+            continue;
+        }
+        round_trip.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+        const vector<double> u(reply.u, reply.u + plant.input_dim);
+        trajectory << s;
+        for (int k = 0; k < state_dim; k++)
+            trajectory << " " << setprecision(17) << x[k];
+        for (int m = 0; m < plant.input_dim; m++)
+            trajectory << " " << u[m];
+        trajectory << " " << reply.valid << " " << reply.cycles << endl;
+        //Start over when the trajectory is done
+        if (reply.valid)
+            plant.post(x, u);
+        if (!reply.valid || plant.target(x)) {
+            arrived += reply.valid;
+            left += !reply.valid;
+            runs++;
+            x = plant.x0;
+        }
+    }
+    request.dim = 0;
+    send(client, &request, sizeof(request), 0);
+    server.join();
+    close(client);
+    close(sock);
+
+    cout << steps << " steps of " << plant_name << " in " << runs << " trajectories: " << arrived
+         << " reached the target, " << left << " left the controller domain, " << lost << " steps lost" << endl;
+    PrintHistogram("Emulated latency", "clock cycles", cycles, true);
+    if (!cycles.empty()) {
+        const double worst_us = *max_element(cycles.begin(), cycles.end()) / MYRIO_CLOCK_MHZ;
+        cout << "  worst case " << worst_us << " us at " << MYRIO_CLOCK_MHZ << " MHz, "
+             << (worst_us * 1e-6 <= plant.tau ? "within" : "beyond") << " the sampling time of "
+             << plant.tau << " s" << endl;
+    }
+    PrintHistogram("Round trip of the steps", "us", round_trip, false);
+    PrintHistogram("Release jitter of the steps", "us", jitter, false);
+    cout << "\nTrajectory written to " << image << "_trajectory.txt" << endl;
+
+    return lost ? 1 : 0;
+}
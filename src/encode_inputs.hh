@@ -0,0 +1,177 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Assignment of the output codes of the split controller. By default
+   the output bits of generate_blif are the bits of the input BDD variables, so the
+   code of an input is its own index. Any other one-to-one assignment works as well
+   if the wrapper decodes it, and the size of the output BDDs depends a lot on it.
+   Starting from the binary and from a frequency based assignment, pairs of codes are
+   swapped as long as the number of shared BDD nodes of the outputs goes down.
+
+   Code bit i always stands for the input variable readed_inputs[0]+i, i.e. for the
+   output i of the split controller.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "cuddObj.hh"
+
+using namespace std;
+
+//Largest number of input bits whose codes are optimized, as for the wrapper decoder
+const int MAX_ENCODED_BITS = 12;
+//Largest number of code pairs tried in one pass, each one costs a SharingSize of the outputs
+const int MAX_SWAP_PAIRS = 1024;
+
+/*Returns the states of the controller C for each input code*/
+vector<BDD> code_state_sets(const Cudd& manager, const BDD& C, const vector<int>& readed_inputs){
+	const int size_of_inputs = readed_inputs.size();
+	vector<BDD> sets(1 << size_of_inputs);
+	for (int c = 0; c < (1 << size_of_inputs); c++) {
+		BDD minterm = manager.bddOne();
+		for (int i = 0; i < size_of_inputs; i++) {
+			BDD var = manager.bddVar(readed_inputs[0] + i);
+			minterm &= ((c >> i) & 1) ? var : !var;
+		}
+		sets[c] = C.Cofactor(minterm);
+	}
+	return sets;
+}
+
+/*Builds the output functions of the code assignment, orig[k] being the input of the code k*/
+void encoded_outputs(const Cudd& manager, const vector<BDD>& sets, const vector<int>& orig, vector<BDD>& s){
+	for (size_t i = 0; i + 1 < s.size(); i++) {
+		s[i] = manager.bddZero();
+		for (size_t k = 0; k < orig.size(); k++)
+			if ((k >> i) & 1)
+				s[i] |= sets[orig[k]];
+	}
+}
+
+/*Looks for the code assignment with the least shared nodes of the split controller s,
+  see split_controller. On return s holds the outputs of the best assignment and the
+  result is the input of every code, the decode table of the wrapper. With a controller
+  that is not deterministic or too many input bits the codes are kept as they are.
+  At most passes rounds of pairwise swaps are done, of at most MAX_SWAP_PAIRS pairs each*/
+vector<int> encode_inputs(const Cudd& manager, const BDD& C, const vector<int>& readed_inputs,
+                          vector<BDD>& s, int passes){
+	const int size_of_inputs = readed_inputs.size();
+	if (size_of_inputs > MAX_ENCODED_BITS) {
+		cout << "Too many input bits, the output codes are not optimized" << endl;
+		return {};
+	}
+	const int num_codes = 1 << size_of_inputs;
+	vector<int> orig(num_codes);
+	for (int k = 0; k < num_codes; k++)
+		orig[k] = k;
+	const int binary_size = manager.SharingSize(s);
+
+	//Every state of a deterministic controller has one input
+	const int num_vars = manager.ReadSize();
+	const vector<BDD> sets = code_state_sets(manager, C, readed_inputs);
+	vector<double> frequency(num_codes);
+	double num_states = 0;
+	for (int c = 0; c < num_codes; c++)
+		num_states += frequency[c] = sets[c].CountMinterm(num_vars);
+	if (num_states != s[size_of_inputs].CountMinterm(num_vars)) {
+		cout << "The controller is not deterministic, the output codes are not optimized" << endl;
+		return {};
+	}
+
+	//The most used inputs get the codes with the fewest ones, they have the smallest on-sets
+	vector<int> by_frequency(orig), by_weight(orig);
+	stable_sort(by_frequency.begin(), by_frequency.end(),
+	            [&](int a, int b){ return frequency[a] > frequency[b]; });
+	stable_sort(by_weight.begin(), by_weight.end(),
+	            [](int a, int b){ return __builtin_popcount(a) < __builtin_popcount(b); });
+	vector<int> seeded(num_codes);
+	for (int k = 0; k < num_codes; k++)
+		seeded[by_weight[k]] = by_frequency[k];
+	vector<BDD> t(s);
+	encoded_outputs(manager, sets, seeded, t);
+	int best_size = binary_size;
+	if (manager.SharingSize(t) < best_size) {
+		best_size = manager.SharingSize(t);
+		orig = seeded;
+		s = t;
+	}
+
+	/*Swapping the codes p and q flips the outputs of the bits where they differ on the
+	  states of both inputs. Every used code is tried against the codes next to it, which
+	  flips a single output, then against the other used codes while there is room*/
+	bool improved = true;
+	vector<pair<int, int>> pairs;
+	for (int pass = 0; pass < passes && improved; pass++) {
+		improved = false;
+		pairs.clear();
+		for (int p = 0; p < num_codes; p++) {
+			if (frequency[orig[p]] == 0)
+				continue;
+			for (int i = 0; i < size_of_inputs && (int) pairs.size() < MAX_SWAP_PAIRS; i++) {
+				const int q = p ^ (1 << i);
+				if (q > p || frequency[orig[q]] == 0)
+					pairs.push_back(make_pair(p, q));
+			}
+		}
+		for (int p = 0; p < num_codes && (int) pairs.size() < MAX_SWAP_PAIRS; p++) {
+			if (frequency[orig[p]] == 0)
+				continue;
+			for (int q = p + 1; q < num_codes && (int) pairs.size() < MAX_SWAP_PAIRS; q++)
+				if (frequency[orig[q]] != 0 && __builtin_popcount(p ^ q) != 1)
+					pairs.push_back(make_pair(p, q));
+		}
+		for (const pair<int, int>& pq : pairs) {
+			const int p = pq.first, q = pq.second;
+			//An earlier swap of the pass may have moved the used code away
+			if (frequency[orig[p]] == 0 && frequency[orig[q]] == 0)
+				continue;
+			const BDD flip = sets[orig[p]] | sets[orig[q]];
+			for (int i = 0; i < size_of_inputs; i++)
+				if (((p ^ q) >> i) & 1)
+					s[i] ^= flip;
+			const int size = manager.SharingSize(s);
+			if (size < best_size) {
+				best_size = size;
+				swap(orig[p], orig[q]);
+				improved = true;
+			} else {
+				for (int i = 0; i < size_of_inputs; i++)
+					if (((p ^ q) >> i) & 1)
+						s[i] ^= flip;
+			}
+		}
+		cout << "Output codes, pass " << pass+1 << ": " << best_size << " nodes" << endl;
+	}
+	cout << "Output codes: " << binary_size << " nodes with the binary codes, " << best_size
+	     << " with the optimized codes" << endl;
+	return orig;
+}
+
+/*Checks that decoding the outputs s with the table orig gives back the controller C*/
+bool check_codes(const Cudd& manager, const BDD& C, const vector<int>& readed_inputs,
+                 const vector<BDD>& s, const vector<int>& orig){
+	const int size_of_inputs = readed_inputs.size();
+	BDD decoded = manager.bddZero();
+	for (size_t k = 0; k < orig.size(); k++) {
+		BDD states = s[size_of_inputs], input = manager.bddOne();
+		for (int i = 0; i < size_of_inputs; i++) {
+			BDD var = manager.bddVar(readed_inputs[0] + i);
+			states &= ((k >> i) & 1) ? s[i] : !s[i];
+			input &= ((orig[k] >> i) & 1) ? var : !var;
+		}
+		decoded |= states & input;
+	}
+	return decoded == C;
+}
+
+/*Writes the decode table, one line per code with the code and its input*/
+void write_codes(const string& fname, const vector<int>& orig){
+	ofstream out(fname);
+	out << "#output code and input code of the split controller outputs, bit i is output i" << endl;
+	for (size_t k = 0; k < orig.size(); k++)
+		out << k << " " << orig[k] << endl;
+}
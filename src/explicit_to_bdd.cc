@@ -0,0 +1,52 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Converts a controller of the explicit SCOTS engine (a StaticController
+   written with write_to_file) to a controller BDD in the format of the BDD engine, so
+   that it can be determinized with scots_opt_det and implemented with generate_blif.
+   The BDD is built bottom up from the sorted state-input pairs of the winning domain,
+   see ExplicitToSymbolic.hh.
+
+   Usage: explicit_to_bdd <source static controller> <target controller>
+ */
+
+#include <iostream>
+#include <time.h>
+#include "scots.hh"
+
+using namespace std;
+using namespace scots;
+
+int main(int argc, char* argv[]){
+
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <source static controller> <target controller>" << std::endl;
+        return 1;
+    }
+    cout << "\n\nConverting the explicit controller to a BDD" << endl;
+    StaticController sc;
+    if (!read_from_file(sc, argv[1])) {
+        cerr << "Could not read the static controller from " << argv[1] << ".scs" << endl;
+        return 1;
+    }
+    clock_t start = clock();
+    Cudd manager;
+    //The state variables first, then the input variables, as in the BDD engine
+    SymbolicSet ss(manager, sc.get_state_grid());
+    SymbolicSet is(manager, sc.get_input_grid());
+    BDD C = winning_domain_to_bdd(manager, ss, is, sc.get_winning_domain());
+    cout << "CPU_Time_used =  " << ((double) (clock() - start)) / CLOCKS_PER_SEC << endl;
+    SymbolicSet controller(ss, is);
+    controller.print_info(1);
+    cout << "Winning states: " << sc.get_winning_domain().get_size() << endl;
+    cout << "State-input pairs: " << controller.get_size(manager, C) << endl;
+    cout << "BDD nodes: " << C.nodeCount() << endl;
+
+    if (!write_to_file(manager, controller, C, argv[2])) {
+        cerr << "Could not write the controller to " << argv[2] << ".scs" << endl;
+        return 1;
+    }
+    cout << argv[2] << ".scs and .bdd written" << endl;
+    return 0;
+}
@@ -11,54 +11,30 @@
 #include <iostream>
 #include <array>
 #include "scots.hh"
+#include "optdet/cudd_mgr.hh"
+#include "split_controller.hh"
+#include "encode_inputs.hh"
 #include <time.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 
 using namespace std;
 using namespace scots;
-
-/*The read_input_vars fucntion look into the .scs file and search for the number
-   of inputs, storing them and returning them in a vector */
-vector <int> read_input_vars(int state_dim, char* filename){
-	static const int max_line = 65536;
-	bool input_vars = false;
-	int counter = 0;
-	vector<int> u;
-	ifstream file( filename );
-	if (!file) {
-		cerr << "Could not open file " << filename << endl;
-		return {};
-	}
-	vector<string> tokens; // Storing all tokens
-	string line;
-	while (getline(file, line)) {
-		if (line.find("#END", 0) != string::npos) {
-			input_vars = false;
-		}
-		if (input_vars) {
-			u.push_back(stoi(line));
-		}
-		if (line.find("#VECTOR:BDD_VAR_ID_IN_DIM_" + to_string(state_dim+1+counter), 0) != string::npos) {
-			input_vars = true;
-			counter++;
-			file.ignore(max_line, '\n');
-		}
-
-	}
-	file.close();
-	return u;
-}
+using namespace tud::ctrl::scots::optimal;
 
 int main(int argc, char* argv[]){
 
 	if (argc < 4) {
-		std::cerr << "Usage: " << argv[0] << " <source controller> <target blif> <state_space_dim>" << std::endl;
+		std::cerr << "Usage: " << argv[0] << " <source controller> <target blif> <state_space_dim> [mem_budget_mb [encode_passes]]" << std::endl;
 		return 1;
 	}
 	cout << "\n\nSplitting controller and generating blif file" << endl;
-	/* Cudd manager */
-	Cudd manager;
+	//Optional memory budget of the Cudd manager in Mb, 0 for unlimited
+	uint32_t mem_budget = (argc > 4) ? atoi(argv[4]) : 0;
+	//Optional passes of the output code optimization, 0 to keep the binary codes
+	int encode_passes = (argc > 5) ? atoi(argv[5]) : 0;
+	/* Cudd manager, sized according to the controller's node count */
+	Cudd manager = create_cudd_mgr(argv[1], mem_budget);
 	char filename2[100];
 	strcpy(filename2,argv[1]);
 	strcat(filename2,".scs");
@@ -77,49 +53,27 @@ int main(int argc, char* argv[]){
 	}
 	controller.print_info(1);
 	const int size_of_inputs = readed_inputs.size();
-	BDD s[size_of_inputs+1];
 
 	//Profiling
     //////////////////////////////////////////////////////////////////////////
 	start = clock();
-	int table_no = 0;
-	//Remove the input and create two bdds for u=0 and for u=1
-	for (int i = readed_inputs[0]; i < readed_inputs[0]+size_of_inputs; i++) {
-		//Create a cube to remove the desired input according to its value (u=1)
-		DdNode *vars_to_remove[1] = {manager.ReadVars(i).getNode()};
-		DdNode *cube = Cudd_bddComputeCube(manager.getManager(),vars_to_remove,NULL,1);
-		BDD cube_bdd = BDD(manager,cube);
-
-		//Create a copy of the input vector in order to modify it for the next iteration
-		vector<int> readed_inputs_cpy(size_of_inputs);
-		copy(begin(readed_inputs), end(readed_inputs), begin(readed_inputs_cpy));
-		//Remove the i variable of the vector so we have a vector containing all vars
-		//except for the i var.
-		remove(begin(readed_inputs_cpy), end(readed_inputs_cpy), i);
-
-		//Create a cube to remove all the remaining bits of the input (u=X)
-		DdNode *vars_to_remove2[size_of_inputs-1];
-		for (int j = 0; j < size_of_inputs-1; j++)
-			vars_to_remove2[j] = manager.ReadVars(readed_inputs_cpy[j]).getNode();
-		DdNode *cube_all = Cudd_bddComputeCube(manager.getManager(),vars_to_remove2,NULL,size_of_inputs-1);
-		BDD cube_bdd_all = BDD(manager,cube_all);
-
-		//Restrict C to the value u1 = 1:
-		s[table_no] = C & cube_bdd;
-		//Delete variables from the originial bdd
-		s[table_no] = s[table_no].ExistAbstract(cube_bdd_all);
-		s[table_no] = s[table_no].ExistAbstract(cube_bdd);
-
-		table_no++;
+	vector<BDD> s = split_controller(manager, C, readed_inputs);
+
+	//The decode table of the optimized codes is read by the wrapper, as the modes of a bundle
+	const string codes_file = filename + ".codes";
+	remove(codes_file.c_str());
+	remove((filename + ".modes").c_str());
+	if (encode_passes > 0) {
+		vector<int> orig = encode_inputs(manager, C, readed_inputs, s, encode_passes);
+		if (!orig.empty()) {
+			if (!check_codes(manager, C, readed_inputs, s, orig)) {
+				cerr << "The optimized codes do not decode to the controller" << endl;
+				return 1;
+			}
+			write_codes(codes_file, orig);
+			cout << codes_file << " file generated" << endl;
+		}
 	}
-	//Add BDD removing all inputs so we can check if we are in the domain of the controller
-	DdNode *vars_to_remove3[size_of_inputs];
-	for (int j = 0; j < size_of_inputs; j++)
-		vars_to_remove3[j] = manager.ReadVars(readed_inputs[j]).getNode();
-
-	DdNode *cube_complete = Cudd_bddComputeCube(manager.getManager(),vars_to_remove3,NULL,size_of_inputs);
-	BDD cube_bdd_complete = BDD(manager,cube_complete);
-	s[size_of_inputs] = C.ExistAbstract(cube_bdd_complete);;
 
 	FILE *outfile; // output file pointer for .bdd file
 	//Dump the BDD to a DdNode array
@@ -139,6 +93,7 @@ int main(int argc, char* argv[]){
 
 	cpu_time_used = ((double) (end_time - start)) / CLOCKS_PER_SEC;
 	cout << "CPU_Time_used =  " << cpu_time_used << endl;
+	report_cudd_mgr_stats(manager);
 
 	return 0;
 }
@@ -0,0 +1,172 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Alternative back end to generate_blif for controllers too large for LUT
+   logic. It splits the determinized controller as generate_blif does and stores the
+   resulting BDDs as a node table in a block RAM, evaluated by templates/bdd_engine.vhd
+   one BDD level per clock cycle. It writes the table as <target>.coe and <target>.mif,
+   the top entity <target>_BDD.vhd and bdd_engine.vhd, and checks the table with the C++
+   model of the engine against the BDDs.
+
+   Usage: generate_bram <source controller> <target> <state_space_dim> [mem_budget_mb]
+
+   The templates are read from templates/ next to the executable, or from the
+   directory given by the SCOTS_TEMPLATE_DIR environment variable.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include "scots.hh"
+#include "optdet/cudd_mgr.hh"
+#include "split_controller.hh"
+#include "bdd_engine.hh"
+#include "wrapper.hh"
+
+using namespace std;
+using namespace scots;
+using namespace tud::ctrl::scots::optimal;
+
+//Number of states checked with the engine model, all of them if there are less
+const int MAX_CHECKED_STATES = 1 << 18;
+
+void WriteCoe(const string& fname, const BddTable& table){
+    ofstream out(fname);
+    out << "; BDD node table of " << table.words.size() << " words, see bdd_engine.vhd" << endl;
+    out << "memory_initialization_radix=2;" << endl;
+    out << "memory_initialization_vector=" << endl;
+    for (size_t a = 0; a < table.words.size(); a++)
+        out << ToBits(table.words[a], WordBits(table)) << ((a + 1 < table.words.size()) ? "," : ";") << endl;
+}
+
+void WriteMif(const string& fname, const BddTable& table){
+    ofstream out(fname);
+    out << "-- BDD node table, see bdd_engine.vhd" << endl;
+    out << "WIDTH=" << WordBits(table) << ";" << endl;
+    out << "DEPTH=" << table.words.size() << ";" << endl;
+    out << "ADDRESS_RADIX=UNS;" << endl;
+    out << "DATA_RADIX=BIN;" << endl;
+    out << "CONTENT BEGIN" << endl;
+    for (size_t a = 0; a < table.words.size(); a++)
+        out << a << " : " << ToBits(table.words[a], WordBits(table)) << ";" << endl;
+    out << "END;" << endl;
+}
+
+/*Runs the engine model on the states and compares its results with the BDDs, all
+  states if there are few BDD variables, otherwise random ones and random states of
+  the controller domain. Returns the number of mismatches and the largest latency */
+long CheckTable(const Cudd& manager, const vector<BDD>& bdds, const BddTable& table, int& max_cycles){
+    BddEngineModel engine(table);
+    const BDD one = manager.bddOne();
+    const bool exhaustive = (table.num_vars < 63) && ((1ULL << table.num_vars) <= (uint64_t) MAX_CHECKED_STATES);
+    const uint64_t num_states = exhaustive ? (1ULL << table.num_vars) : MAX_CHECKED_STATES;
+    vector<BDD> vars;
+    for (int v = 0; v < table.num_vars; v++)
+        vars.push_back(manager.bddVar(v));
+    mt19937_64 random(1);
+    vector<int> inputs(manager.ReadSize(), 0);
+    vector<bool> x(table.num_vars), result;
+    long mismatches = 0;
+    max_cycles = 0;
+    for (uint64_t s = 0; s < num_states; s++) {
+        if (exhaustive) {
+            for (int v = 0; v < table.num_vars; v++)
+                inputs[v] = (s >> v) & 1;
+        } else if ((s & 1) && bdds.back() != manager.bddZero()) {
+            //A state of the domain, the last BDD
+            BDD minterm = bdds.back().PickOneMinterm(vars);
+            for (int v = 0; v < table.num_vars; v++)
+                inputs[v] = (minterm & vars[v]) != manager.bddZero();
+        } else {
+            const uint64_t bits = random();
+            for (int v = 0; v < table.num_vars; v++)
+                inputs[v] = (v < 64) ? ((bits >> v) & 1) : (random() & 1);
+        }
+        for (int v = 0; v < table.num_vars; v++)
+            x[v] = inputs[v];
+        max_cycles = max(max_cycles, engine.Evaluate(x, result));
+        for (size_t r = 0; r < bdds.size(); r++)
+            if (result[r] != (bdds[r].Eval(inputs.data()) == one))
+                mismatches++;
+    }
+    cout << "Checked " << num_states << (exhaustive ? " (all)" : " (sampled)") << " states" << endl;
+    return mismatches;
+}
+
+int main(int argc, char* argv[]){
+
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <source controller> <target> <state_space_dim> [mem_budget_mb]" << std::endl;
+        return 1;
+    }
+    cout << "\n\nSplitting controller and generating the BRAM node table" << endl;
+    uint32_t mem_budget = (argc > 4) ? atoi(argv[4]) : 0;
+    Cudd manager = create_cudd_mgr(argv[1], mem_budget);
+    const string scs_file = string(argv[1]) + ".scs";
+    const string target = argv[2];
+    const int state_dim = atoi(argv[3]);
+    const string name = target.substr(target.rfind('/') + 1);
+    string bram_template, engine_template;
+    if (!ReadTemplate("template_bram.vhd", bram_template) || !ReadTemplate("bdd_engine.vhd", engine_template))
+        return 1;
+
+    vector<int> readed_inputs = read_input_vars(state_dim, scs_file.c_str());
+    BDD C;
+    scots::SymbolicSet controller;
+    if(!read_from_file(manager,controller,C,argv[1])) {
+        std::cout << "Could not read determinized from determinized.scs\n";
+        return 1;
+    }
+    if (readed_inputs.empty()) {
+        cerr << "No input variables in " << scs_file << endl;
+        return 1;
+    }
+    controller.print_info(1);
+
+    clock_t start = clock();
+    vector<BDD> s = split_controller(manager, C, readed_inputs);
+    BddTable table;
+    if (!MakeBddTable(s, table))
+        return 1;
+    const int max_latency = MaxLatency(table);
+    cout << "Node table: " << table.words.size() << " words of " << WordBits(table) << " bits ("
+         << table.words.size() * WordBits(table) / 8192.0 << " KiB), " << table.roots.size()
+         << " roots, at most " << max_latency << " clock cycles" << endl;
+
+    WriteCoe(target + ".coe", table);
+    WriteMif(target + ".mif", table);
+
+    stringstream rom, roots;
+    for (size_t a = 0; a < table.words.size(); a++)
+        rom << "\"" << ToBits(table.words[a], WordBits(table)) << "\"" << ((a + 1 < table.words.size()) ? "," : "") << endl;
+    roots << "\"";
+    for (size_t r = table.roots.size(); r > 0; r--)
+        roots << ToBits(table.roots[r-1], table.addr_bits + 1);
+    roots << "\"";
+
+    string OutText = ReplaceString(bram_template, "#$ENTITY_MODEL_NAME$#", name);
+    OutText = ReplaceString(OutText, "#$DATES$#", GetCurrentDateTime());
+    OutText = ReplaceString(OutText, "#$NUM_NODES$#", to_string(table.words.size()));
+    OutText = ReplaceString(OutText, "#$WORD_BITS$#", to_string(WordBits(table)));
+    OutText = ReplaceString(OutText, "#$ADDR_BITS$#", to_string(table.addr_bits));
+    OutText = ReplaceString(OutText, "#$VAR_BITS$#", to_string(table.var_bits));
+    OutText = ReplaceString(OutText, "#$NUM_VARS$#", to_string(table.num_vars));
+    OutText = ReplaceString(OutText, "#$NUM_ROOTS$#", to_string(table.roots.size()));
+    OutText = ReplaceString(OutText, "#$FIRST_INPUT_VAR$#", to_string(readed_inputs[0]));
+    OutText = ReplaceString(OutText, "#$MAX_LATENCY$#", to_string(max_latency));
+    OutText = ReplaceString(OutText, "#$ROM_WORDS$#", rom.str());
+    OutText = ReplaceString(OutText, "#$ROOTS$#", roots.str());
+    FileWriteAllText(target + "_BDD.vhd", OutText);
+    FileWriteAllText(target.substr(0, target.size() - name.size()) + "bdd_engine.vhd", engine_template);
+    cout << target << ".coe, .mif and _BDD.vhd generated" << endl;
+
+    int max_cycles = 0;
+    const long mismatches = CheckTable(manager, s, table, max_cycles);
+    cout << "Engine model: " << mismatches << " mismatches, at most " << max_cycles << " clock cycles" << endl;
+    cout << "CPU_Time_used =  " << ((double) (clock() - start)) / CLOCKS_PER_SEC << endl;
+    report_cudd_mgr_stats(manager);
+
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,151 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Bundles several determinized controllers over the same grid into one
+   .blif file, so that they can share the logic of one FPGA. The controllers are loaded
+   into one Cudd manager and split as generate_blif does. Mode variables select the
+   controller, output i of the bundle is output i of the selected controller. Sub
+   functions common to several controllers are single BDD nodes, so they are emitted
+   once. The mode variables are placed at the top or at the bottom of the variable
+   order, whichever gives the fewer nodes. Their BDD variable ids, most significant
+   bit first, are written to <target blif>.modes for the wrapper, which gets a mode port.
+
+   Usage: generate_bundle <target blif> <state_space_dim> <controller 1> <controller 2> ...
+ */
+
+#include <iostream>
+#include <fstream>
+#include "scots.hh"
+#include "optdet/cudd_mgr.hh"
+#include "split_controller.hh"
+#include "wrapper.hh"
+
+using namespace std;
+using namespace scots;
+using namespace tud::ctrl::scots::optimal;
+
+/*Checks that the controllers have the same grid and BDD variables as the first one*/
+bool SameGrids(const vector<string>& scs_files){
+    const vector<double> dim = Read_ScsVector(scs_files[0], "ETA");
+    vector<string> names = {"ETA", "LOWER_LEFT", "UPPER_RIGHT"};
+    for (size_t k = 0; k < dim.size(); k++)
+        names.push_back("BDD_VAR_ID_IN_DIM_" + to_string(k+1));
+    for (size_t c = 1; c < scs_files.size(); c++)
+        for (vector<string>::const_iterator n = names.begin(); n != names.end(); ++n)
+            if (Read_ScsVector(scs_files[c], *n) != Read_ScsVector(scs_files[0], *n)) {
+                cerr << "The " << *n << " of " << scs_files[c] << " differs from " << scs_files[0] << endl;
+                return false;
+            }
+    return true;
+}
+
+int main(int argc, char* argv[]){
+
+    if (argc < 5) {
+        std::cerr << "Usage: " << argv[0] << " <target blif> <state_space_dim> <controller 1> <controller 2> ..." << std::endl;
+        return 1;
+    }
+    cout << "\n\nBundling controllers and generating blif file" << endl;
+    const string filename = argv[1];
+    const int state_dim = atoi(argv[2]);
+    const int num_ctrls = argc - 3;
+    vector<string> scs_files;
+    for (int c = 0; c < num_ctrls; c++)
+        scs_files.push_back(string(argv[3+c]) + ".scs");
+    if (!SameGrids(scs_files))
+        return 1;
+    vector<int> readed_inputs = read_input_vars(state_dim, scs_files[0].c_str());
+    if (readed_inputs.empty()) {
+        cerr << "No input variables in " << scs_files[0] << endl;
+        return 1;
+    }
+    const int size_of_inputs = readed_inputs.size();
+
+    /* Cudd manager, sized according to the first controller's node count */
+    Cudd manager = create_cudd_mgr(argv[3], 0);
+    clock_t start = clock();
+
+    //Split every controller, they all use the same BDD variables
+    vector<vector<BDD> > s(num_ctrls);
+    int separate_size = 0;
+    for (int c = 0; c < num_ctrls; c++) {
+        BDD C;
+        scots::SymbolicSet controller;
+        if(!read_from_file(manager,controller,C,argv[3+c])) {
+            cerr << "Could not read controller " << argv[3+c] << endl;
+            return 1;
+        }
+        s[c] = split_controller(manager, C, readed_inputs);
+        separate_size += manager.SharingSize(s[c]);
+        cout << argv[3+c] << ": " << manager.SharingSize(s[c]) << " nodes" << endl;
+    }
+
+    //The mode variables are new variables, at the bottom of the order
+    int num_modes = 0;
+    while ((1 << num_modes) < num_ctrls)
+        num_modes++;
+    vector<BDD> mode_vars;
+    for (int j = 0; j < num_modes; j++)
+        mode_vars.push_back(manager.bddVar());
+
+    //Output i of the bundle is output i of the controller of the mode
+    vector<BDD> bundle(size_of_inputs+1, manager.bddZero());
+    for (int c = 0; c < num_ctrls; c++) {
+        BDD mode = manager.bddOne();
+        for (int j = 0; j < num_modes; j++)
+            mode &= ((c >> (num_modes-1-j)) & 1) ? mode_vars[j] : !mode_vars[j];
+        for (int i = 0; i < size_of_inputs+1; i++)
+            bundle[i] |= mode & s[c][i];
+    }
+    //Every mode has to give back its controller
+    for (int c = 0; c < num_ctrls; c++) {
+        BDD mode = manager.bddOne();
+        for (int j = 0; j < num_modes; j++)
+            mode &= ((c >> (num_modes-1-j)) & 1) ? mode_vars[j] : !mode_vars[j];
+        for (int i = 0; i < size_of_inputs+1; i++)
+            if (bundle[i].Cofactor(mode) != s[c][i]) {
+                cerr << "The bundle differs from " << argv[3+c] << " in output " << i << endl;
+                return 1;
+            }
+    }
+    s.clear();
+    const int bottom_size = manager.SharingSize(bundle);
+
+    //Try the mode variables at the top of the order
+    const int num_vars = manager.ReadSize();
+    vector<int> order(num_vars);
+    for (int l = 0; l < num_vars; l++)
+        order[l] = manager.ReadInvPerm(l);
+    vector<int> top_order(order.end() - num_modes, order.end());
+    top_order.insert(top_order.end(), order.begin(), order.end() - num_modes);
+    manager.ShuffleHeap(top_order.data());
+    const int top_size = manager.SharingSize(bundle);
+    if (bottom_size <= top_size)
+        manager.ShuffleHeap(order.data());
+    cout << "Bundle: " << min(bottom_size, top_size) << " nodes with the mode variables at the "
+         << ((bottom_size <= top_size) ? "bottom" : "top") << ", " << separate_size
+         << " nodes in the separate controllers" << endl;
+
+    //Dump the DdNode array to a .blif file
+    vector<DdNode*> ddnodearray(size_of_inputs+1);
+    for (int i = 0; i < size_of_inputs+1; i++)
+        ddnodearray[i] = bundle[i].getNode();
+    FILE *outfile = fopen(filename.c_str(),"w");
+    Cudd_DumpBlif(manager.getManager(), size_of_inputs+1, ddnodearray.data(), NULL, NULL, NULL, outfile, 0);
+    fclose(outfile);
+    cout << filename << " file generated" << endl;
+
+    remove((filename + ".codes").c_str());
+    ofstream modes(filename + ".modes");
+    modes << "#BDD variable ids of the mode bits, most significant first, of " << num_ctrls << " controllers" << endl;
+    for (int j = 0; j < num_modes; j++)
+        modes << mode_vars[j].NodeReadIndex() << endl;
+    modes.close();
+    cout << filename << ".modes file generated" << endl;
+
+    cout << "CPU_Time_used =  " << ((double) (clock() - start)) / CLOCKS_PER_SEC << endl;
+    report_cudd_mgr_stats(manager);
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Software back end next to generate_blif. It splits the determinized
+   controller as generate_blif does and writes it as a self-contained C99 lookup: a node
+   table of the BDDs walked for a fixed number of steps, the quantization of the state
+   to the grid of the .scs file and the decoding of the input grid point. It writes
+   <target>.c, <target>.h and the Linux micro-benchmark <target>_bench.c, and checks the
+   node table with the same walk in C++ against the BDDs.
+
+   Usage: generate_c <source controller> <target> <state_space_dim> [mem_budget_mb]
+
+   The templates are read from templates/ next to the executable, or from the
+   directory given by the SCOTS_TEMPLATE_DIR environment variable.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <cctype>
+#include <cmath>
+#include "scots.hh"
+#include "optdet/cudd_mgr.hh"
+#include "split_controller.hh"
+#include "bdd_engine.hh"
+#include "wrapper.hh"
+
+using namespace std;
+using namespace scots;
+using namespace tud::ctrl::scots::optimal;
+
+//Number of states checked with the walk of the C code, all of them if there are less
+const int MAX_CHECKED_STATES = 1 << 18;
+
+//The node table of the C code: the children as node << 1 | complement and the variable
+struct CNode {
+    uint64_t child[2];
+    uint64_t var;
+};
+
+//The nodes of the block RAM table with the children of the constant node pointing to itself
+vector<CNode> MakeCNodes(const BddTable& table){
+    const int ab = table.addr_bits;
+    const uint64_t mask = (1ULL << ab) - 1;
+    vector<CNode> nodes(table.words.size(), CNode{{0, 0}, 0});
+    for (size_t a = 1; a < table.words.size(); a++) {
+        const uint64_t word = table.words[a];
+        nodes[a].child[0] = (((word >> 1) & mask) << 1) | (word & 1);
+        nodes[a].child[1] = ((word >> (ab + 1)) & mask) << 1;
+        nodes[a].var = word >> (2*ab + 1);
+    }
+    return nodes;
+}
+
+//The walk of the C code, depth steps from every root, out[r] is the value of root r
+void Walk(const vector<CNode>& nodes, const BddTable& table, int depth,
+          const vector<int>& v, vector<bool>& out){
+    out.resize(table.roots.size());
+    for (size_t r = 0; r < table.roots.size(); r++) {
+        uint64_t e = table.roots[r];
+        for (int d = 0; d < depth; d++) {
+            const CNode& n = nodes[e >> 1];
+            e = n.child[v[n.var]] ^ (e & 1);
+        }
+        out[r] = !(e & 1);
+    }
+}
+
+/*Compares the walk of the C code with the BDDs, on all states if there are few BDD
+  variables, otherwise on random states and random states of the controller domain.
+  Returns the number of mismatches */
+long CheckNodes(const Cudd& manager, const vector<BDD>& bdds, const BddTable& table,
+                const vector<CNode>& nodes, int depth){
+    const BDD one = manager.bddOne();
+    const bool exhaustive = (table.num_vars < 63) && ((1ULL << table.num_vars) <= (uint64_t) MAX_CHECKED_STATES);
+    const uint64_t num_states = exhaustive ? (1ULL << table.num_vars) : MAX_CHECKED_STATES;
+    vector<BDD> vars;
+    for (int v = 0; v < table.num_vars; v++)
+        vars.push_back(manager.bddVar(v));
+    mt19937_64 random(1);
+    vector<int> inputs(manager.ReadSize(), 0);
+    vector<bool> result;
+    long mismatches = 0;
+    for (uint64_t s = 0; s < num_states; s++) {
+        if (exhaustive) {
+            for (int v = 0; v < table.num_vars; v++)
+                inputs[v] = (s >> v) & 1;
+        } else if ((s & 1) && bdds.back() != manager.bddZero()) {
+            //A state of the domain, the last BDD
+            BDD minterm = bdds.back().PickOneMinterm(vars);
+            for (int v = 0; v < table.num_vars; v++)
+                inputs[v] = (minterm & vars[v]) != manager.bddZero();
+        } else {
+            const uint64_t bits = random();
+            for (int v = 0; v < table.num_vars; v++)
+                inputs[v] = (v < 64) ? ((bits >> v) & 1) : (random() & 1);
+        }
+        Walk(nodes, table, depth, inputs, result);
+        for (size_t r = 0; r < bdds.size(); r++)
+            if (result[r] != (bdds[r].Eval(inputs.data()) == one))
+                mismatches++;
+    }
+    cout << "Checked " << num_states << (exhaustive ? " (all)" : " (sampled)") << " states" << endl;
+    return mismatches;
+}
+
+//A double as a C literal that reads back to the same value
+string CDouble(double value){
+    stringstream ss;
+    ss << setprecision(17) << value;
+    string text = ss.str();
+    if (text.find_first_of(".eEn") == string::npos)
+        text += ".0";
+    return text;
+}
+
+int main(int argc, char* argv[]){
+
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <source controller> <target> <state_space_dim> [mem_budget_mb]" << std::endl;
+        return 1;
+    }
+    cout << "\n\nSplitting controller and generating the C code" << endl;
+    uint32_t mem_budget = (argc > 4) ? atoi(argv[4]) : 0;
+    Cudd manager = create_cudd_mgr(argv[1], mem_budget);
+    const string scs_file = string(argv[1]) + ".scs";
+    const string target = argv[2];
+    const int state_dim = atoi(argv[3]);
+    const string templates[3] = {"template_c.h", "template_c.c", "template_c_bench.c"};
+    string template_text[3];
+    for (int f = 0; f < 3; f++)
+        if (!ReadTemplate(templates[f], template_text[f]))
+            return 1;
+
+    //The name of the target is the prefix of the C identifiers
+    string name = target.substr(target.rfind('/') + 1);
+    for (size_t c = 0; c < name.size(); c++)
+        if (!isalnum((unsigned char) name[c]))
+            name[c] = '_';
+    if (name.empty() || isdigit((unsigned char) name[0]))
+        name = "ctrl_" + name;
+    string prefix = name;
+    for (size_t c = 0; c < prefix.size(); c++)
+        prefix[c] = toupper((unsigned char) prefix[c]);
+    const string path = target.substr(0, target.rfind('/') + 1) + name;
+
+    vector<int> readed_inputs = read_input_vars(state_dim, scs_file.c_str());
+    BDD C;
+    scots::SymbolicSet controller;
+    if(!read_from_file(manager,controller,C,argv[1])) {
+        std::cout << "Could not read determinized from determinized.scs\n";
+        return 1;
+    }
+    if (readed_inputs.empty() || state_dim <= 0 || state_dim >= controller.get_dim()) {
+        cerr << "No input variables in " << scs_file << " for state dimension " << state_dim << endl;
+        return 1;
+    }
+    controller.print_info(1);
+
+    clock_t start = clock();
+    vector<BDD> s = split_controller(manager, C, readed_inputs);
+    BddTable table;
+    if (!MakeBddTable(s, table))
+        return 1;
+    const vector<CNode> nodes = MakeCNodes(table);
+    vector<int> memo(table.words.size(), -1);
+    int depth = 0;
+    for (size_t r = 0; r < table.roots.size(); r++)
+        depth = max(depth, LongestPath(table, table.roots[r] >> 1, memo));
+    const int num_steps = depth * table.roots.size();
+
+    //The quantizer, the index bits of each state dimension set their BDD variables
+    const vector<double> eta = controller.get_eta();
+    const vector<double> lower = controller.get_lower_left();
+    const vector<double> upper = controller.get_upper_right();
+    const vector<abs_type> no_gp = controller.get_no_gp_per_dim();
+    const vector<IntegerInterval<abs_type>> intervals = controller.get_bdd_intervals();
+    int num_vars = table.num_vars;
+    stringstream quantizer, state_lower, state_upper;
+    for (int k = 0; k < state_dim; k++) {
+        const vector<unsigned int> vars = intervals[k].get_bdd_var_ids();
+        const int nb = vars.size();
+        //The same index as UniformGrid::xtoi
+        const double inv = 1.0 / eta[k];
+        const double sh = lower[k] * inv - 0.5;
+        quantizer << "    /* x[" << k << "]: " << no_gp[k] << " grid points from " << lower[k] + 0.0 << " by " << eta[k] << " */" << endl
+                  << "    q = x[" << k << "] * " << CDouble(inv) << ((sh < 0) ? " + " : " - ") << CDouble(fabs(sh)) << ";" << endl
+                  << "    ok = (q >= 0.0) & (q < " << CDouble(no_gp[k]) << ");" << endl
+                  << "    in &= ok;" << endl
+                  << "    i = (uint32_t) (ok ? q : 0.0);" << endl;
+        for (int j = 0; j < nb; j++) {
+            quantizer << "    v[" << vars[j] << "] = (unsigned char) ((i >> " << nb-1-j << ") & 1);" << endl;
+            num_vars = max(num_vars, (int) vars[j] + 1);
+        }
+        state_lower << (k ? ", " : "") << CDouble(lower[k] - eta[k]/2);
+        state_upper << (k ? ", " : "") << CDouble(upper[k] + eta[k]/2);
+    }
+
+    //The decoder, output i is the input BDD variable readed_inputs[0]+i
+    stringstream decoder;
+    for (int m = state_dim; m < controller.get_dim(); m++) {
+        const vector<unsigned int> vars = intervals[m].get_bdd_var_ids();
+        const int nb = vars.size();
+        decoder << "    i = 0;" << endl;
+        for (int j = 0; j < nb; j++) {
+            const int bit = (int) vars[j] - readed_inputs[0];
+            if (bit < 0 || bit >= (int) table.roots.size() - 1) {
+                cerr << "BDD variable " << vars[j] << " is not an output of the controller" << endl;
+                return 1;
+            }
+            decoder << "    i |= (uint32_t) out[" << bit << "] << " << nb-1-j << ";" << endl;
+        }
+        decoder << "    u[" << m - state_dim << "] = " << CDouble(lower[m] + 0.0) << " + i * " << CDouble(eta[m]) << ";" << endl;
+    }
+
+    const bool short_edges = (nodes.size() <= (1 << 15));
+    const string edge_type = short_edges ? "uint16_t" : "uint32_t";
+    const string var_type = (num_vars <= 256) ? "uint8_t" : "uint16_t";
+    const size_t node_bytes = short_edges ? 6 : 12;
+    stringstream node_text, roots;
+    for (size_t a = 0; a < nodes.size(); a++)
+        node_text << "    { { " << nodes[a].child[0] << ", " << nodes[a].child[1] << " }, " << nodes[a].var << " }"
+                  << ((a + 1 < nodes.size()) ? "," : "") << endl;
+    for (size_t r = 0; r < table.roots.size(); r++)
+        roots << (r ? ", " : "") << table.roots[r];
+    cout << "Node table: " << nodes.size() << " nodes (" << nodes.size() * node_bytes / 1024.0 << " KiB), "
+         << table.roots.size() << " roots, " << num_steps << " node steps per lookup" << endl;
+
+    const string files[3] = {path + ".h", path + ".c", path + "_bench.c"};
+    for (int f = 0; f < 3; f++) {
+        string OutText = ReplaceString(template_text[f], "#$NAME$#", name);
+        OutText = ReplaceString(OutText, "#$PREFIX$#", prefix);
+        OutText = ReplaceString(OutText, "#$GUARD$#", prefix + "_H_");
+        OutText = ReplaceString(OutText, "#$DATES$#", GetCurrentDateTime());
+        OutText = ReplaceString(OutText, "#$STATE_DIM$#", to_string(state_dim));
+        OutText = ReplaceString(OutText, "#$INPUT_DIM$#", to_string(controller.get_dim() - state_dim));
+        OutText = ReplaceString(OutText, "#$NUM_VARS$#", to_string(num_vars));
+        OutText = ReplaceString(OutText, "#$NUM_NODES$#", to_string(nodes.size()));
+        OutText = ReplaceString(OutText, "#$NUM_ROOTS$#", to_string(table.roots.size()));
+        OutText = ReplaceString(OutText, "#$NUM_STEPS$#", to_string(num_steps));
+        OutText = ReplaceString(OutText, "#$FIRST_INPUT_VAR$#", to_string(readed_inputs[0]));
+        OutText = ReplaceString(OutText, "#$EDGE_TYPE$#", edge_type);
+        OutText = ReplaceString(OutText, "#$VAR_TYPE$#", var_type);
+        OutText = ReplaceString(OutText, "#$NODES$#", node_text.str());
+        OutText = ReplaceString(OutText, "#$ROOTS$#", roots.str());
+        OutText = ReplaceString(OutText, "#$DEPTH$#", to_string(depth));
+        OutText = ReplaceString(OutText, "#$STATE_LOWER$#", state_lower.str());
+        OutText = ReplaceString(OutText, "#$STATE_UPPER$#", state_upper.str());
+        OutText = ReplaceString(OutText, "#$QUANTIZER$#", quantizer.str());
+        OutText = ReplaceString(OutText, "#$DECODER$#", decoder.str());
+        FileWriteAllText(files[f], OutText);
+    }
+    cout << path << ".c, .h and _bench.c generated" << endl;
+
+    const long mismatches = CheckNodes(manager, s, table, nodes, depth);
+    cout << "C node table: " << mismatches << " mismatches" << endl;
+    cout << "CPU_Time_used =  " << ((double) (clock() - start)) / CLOCKS_PER_SEC << endl;
+    report_cudd_mgr_stats(manager);
+
+    return mismatches ? 1 : 0;
+}
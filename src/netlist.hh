@@ -0,0 +1,454 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Flat gate array of a combinational netlist, read from the .blif files
+   of generate_blif or the structural verilog that abc writes from them, or built from
+   BDDs with one multiplexer per node. It is simulated bit-parallel, SIM_WORDS words of
+   64 input vectors per gate, with a plain loop over the words that the compiler vectorizes.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <cctype>
+#include "cuddObj.hh"
+
+using namespace std;
+
+//Words of 64 input vectors simulated at once, 256 vectors
+const int SIM_WORDS = 4;
+const int SIM_VECTORS = 64 * SIM_WORDS;
+
+enum GateOp { GATE_ZERO, GATE_ONE, GATE_INPUT, GATE_NOT, GATE_AND, GATE_OR, GATE_XOR, GATE_MUX };
+
+//A gate, its output is the signal of its position, MUX is a ? b : c
+struct Gate {
+    GateOp op;
+    int a, b, c;
+};
+
+//The values of a signal for SIM_VECTORS input vectors
+struct SimWord {
+    uint64_t w[SIM_WORDS];
+};
+
+struct Netlist {
+    //The gates in topological order
+    vector<Gate> gates;
+    //The gates of the inputs and the outputs, in the order of the netlist
+    vector<int> inputs, outputs;
+    vector<string> input_names, output_names;
+
+    int AddGate(GateOp op, int a = -1, int b = -1, int c = -1){
+        Gate g = {op, a, b, c};
+        gates.push_back(g);
+        return gates.size() - 1;
+    }
+
+    //Simulates the gates, the values of the inputs must be set in values
+    void Simulate(vector<SimWord>& values) const {
+        values.resize(gates.size());
+        SimWord* v = values.data();
+        const Gate* gate = gates.data();
+        const size_t num_gates = gates.size();
+        for (size_t i = 0; i < num_gates; i++) {
+            const Gate& g = gate[i];
+            uint64_t* r = v[i].w;
+            const uint64_t* a = v[g.a < 0 ? i : g.a].w;
+            const uint64_t* b = v[g.b < 0 ? i : g.b].w;
+            const uint64_t* c = v[g.c < 0 ? i : g.c].w;
+            switch (g.op) {
+            case GATE_ZERO: for (int k = 0; k < SIM_WORDS; k++) r[k] = 0; break;
+            case GATE_ONE:  for (int k = 0; k < SIM_WORDS; k++) r[k] = ~0ULL; break;
+            case GATE_INPUT: break;
+            case GATE_NOT:  for (int k = 0; k < SIM_WORDS; k++) r[k] = ~a[k]; break;
+            case GATE_AND:  for (int k = 0; k < SIM_WORDS; k++) r[k] = a[k] & b[k]; break;
+            case GATE_OR:   for (int k = 0; k < SIM_WORDS; k++) r[k] = a[k] | b[k]; break;
+            case GATE_XOR:  for (int k = 0; k < SIM_WORDS; k++) r[k] = a[k] ^ b[k]; break;
+            case GATE_MUX:  for (int k = 0; k < SIM_WORDS; k++) r[k] = (a[k] & b[k]) | (~a[k] & c[k]); break;
+            }
+        }
+    }
+};
+
+/*Builds the gate array of signals defined by text, a .names cover or a verilog
+  expression, in the order of their use so that the gates are topological*/
+class NetlistBuilder {
+public:
+    NetlistBuilder(Netlist& netlist) : net(netlist), pos(0) {}
+
+    void AddInput(const string& name){
+        signals[name] = net.AddGate(GATE_INPUT);
+        net.inputs.push_back(signals[name]);
+        net.input_names.push_back(name);
+    }
+
+    void Define(const string& name, bool is_cover, const vector<string>& fanins, const string& text){
+        Definition d = {is_cover, fanins, text};
+        definitions[name] = d;
+    }
+
+    //Builds the outputs, returns false and sets error if a signal can not be built
+    bool Build(const vector<string>& outputs){
+        for (vector<string>::const_iterator o = outputs.begin(); o != outputs.end(); ++o) {
+            const int s = Signal(*o);
+            if (s < 0)
+                return false;
+            net.outputs.push_back(s);
+            net.output_names.push_back(*o);
+        }
+        return true;
+    }
+
+    string error;
+
+private:
+    struct Definition {
+        bool is_cover;
+        vector<string> fanins;
+        string text;
+    };
+    Netlist& net;
+    map<string, int> signals;
+    map<string, Definition> definitions;
+    //Signals being built, to detect combinational loops
+    map<string, bool> building;
+
+    int Fail(const string& message){
+        if (error.empty())
+            error = message;
+        return -1;
+    }
+
+    int Signal(const string& name){
+        map<string, int>::const_iterator s = signals.find(name);
+        if (s != signals.end())
+            return s->second;
+        map<string, Definition>::const_iterator d = definitions.find(name);
+        if (d == definitions.end())
+            return Fail("Signal " + name + " is not defined");
+        if (building[name])
+            return Fail("Signal " + name + " is in a combinational loop");
+        building[name] = true;
+        const int gate = d->second.is_cover ? Cover(d->second) : Expression(d->second.text);
+        building[name] = false;
+        if (gate >= 0)
+            signals[name] = gate;
+        return gate;
+    }
+
+    //A .names cover, the OR of its cubes or its complement if they give the 0 outputs
+    int Cover(const Definition& d){
+        vector<int> fanins;
+        for (vector<string>::const_iterator f = d.fanins.begin(); f != d.fanins.end(); ++f) {
+            fanins.push_back(Signal(*f));
+            if (fanins.back() < 0)
+                return -1;
+        }
+        stringstream lines(d.text);
+        string line;
+        int sum = -1;
+        bool on_set = true;
+        while (getline(lines, line)) {
+            stringstream ss(line);
+            string cube, value;
+            if (!(ss >> cube))
+                continue;
+            if (!(ss >> value)) {
+                //No inputs, a constant
+                value = cube;
+                cube = "";
+            }
+            if (cube.size() != fanins.size())
+                return Fail("Cover line '" + line + "' does not match its inputs");
+            on_set = (value == "1");
+            int product = -1;
+            for (size_t i = 0; i < cube.size(); i++) {
+                if (cube[i] == '-')
+                    continue;
+                const int literal = (cube[i] == '1') ? fanins[i] : net.AddGate(GATE_NOT, fanins[i]);
+                product = (product < 0) ? literal : net.AddGate(GATE_AND, product, literal);
+            }
+            if (product < 0)
+                product = net.AddGate(GATE_ONE);
+            sum = (sum < 0) ? product : net.AddGate(GATE_OR, sum, product);
+        }
+        if (sum < 0)
+            return net.AddGate(on_set ? GATE_ZERO : GATE_ONE);
+        return on_set ? sum : net.AddGate(GATE_NOT, sum);
+    }
+
+    //A verilog expression of ~, &, ^, |, ?: and parentheses, by precedence
+    string expr;
+    size_t pos;
+
+    void Skip(){
+        while (pos < expr.size() && isspace(expr[pos]))
+            pos++;
+    }
+    bool Accept(char c){
+        Skip();
+        if (pos < expr.size() && expr[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+    int Expression(const string& text){
+        //Operands are built recursively, keep the text of the outer expression
+        const string saved_expr = expr;
+        const size_t saved_pos = pos;
+        expr = text;
+        pos = 0;
+        int result = Conditional();
+        Skip();
+        if (result >= 0 && pos != expr.size())
+            result = Fail("Can not parse '" + text + "'");
+        expr = saved_expr;
+        pos = saved_pos;
+        return result;
+    }
+    int Conditional(){
+        const int cond = Or();
+        if (cond < 0 || !Accept('?'))
+            return cond;
+        const int a = Conditional();
+        if (a < 0 || !Accept(':'))
+            return (a < 0) ? -1 : Fail("Missing ':' in '" + expr + "'");
+        const int b = Conditional();
+        return (b < 0) ? -1 : net.AddGate(GATE_MUX, cond, a, b);
+    }
+    int Or(){
+        int a = Xor();
+        while (a >= 0 && Accept('|')) {
+            const int b = Xor();
+            a = (b < 0) ? -1 : net.AddGate(GATE_OR, a, b);
+        }
+        return a;
+    }
+    int Xor(){
+        int a = And();
+        while (a >= 0 && Accept('^')) {
+            const int b = And();
+            a = (b < 0) ? -1 : net.AddGate(GATE_XOR, a, b);
+        }
+        return a;
+    }
+    int And(){
+        int a = Unary();
+        while (a >= 0 && Accept('&')) {
+            const int b = Unary();
+            a = (b < 0) ? -1 : net.AddGate(GATE_AND, a, b);
+        }
+        return a;
+    }
+    int Unary(){
+        if (Accept('~') || Accept('!')) {
+            const int a = Unary();
+            return (a < 0) ? -1 : net.AddGate(GATE_NOT, a);
+        }
+        if (Accept('(')) {
+            const int a = Conditional();
+            if (a >= 0 && !Accept(')'))
+                return Fail("Missing ')' in '" + expr + "'");
+            return a;
+        }
+        Skip();
+        if (expr.compare(pos, 4, "1'b0") == 0 || expr.compare(pos, 4, "1'b1") == 0) {
+            pos += 4;
+            return net.AddGate(expr[pos-1] == '1' ? GATE_ONE : GATE_ZERO);
+        }
+        const size_t start = pos;
+        while (pos < expr.size() && (isalnum(expr[pos]) || expr[pos] == '_' || expr[pos] == '$'))
+            pos++;
+        if (pos == start)
+            return Fail("Can not parse '" + expr + "'");
+        return Signal(expr.substr(start, pos - start));
+    }
+};
+
+/*Reads a .blif file with one model of .names, returns false if it can not*/
+bool ReadBlifNetlist(const string& fname, Netlist& net, string& error){
+    ifstream file(fname);
+    if (!file) {
+        error = "Could not open file " + fname;
+        return false;
+    }
+    NetlistBuilder builder(net);
+    vector<string> outputs, fanins;
+    string line, statement, name, cover;
+    bool in_names = false;
+    //Joins the lines continued by a backslash
+    while (getline(file, line)) {
+        while (!line.empty() && line[line.size()-1] == '\\') {
+            string next;
+            if (!getline(file, next))
+                break;
+            line = line.substr(0, line.size()-1) + " " + next;
+        }
+        const size_t comment = line.find('#');
+        if (comment != string::npos)
+            line = line.substr(0, comment);
+        stringstream ss(line);
+        string keyword;
+        if (!(ss >> keyword))
+            continue;
+        if (keyword[0] != '.') {
+            if (in_names)
+                cover += line + "\n";
+            continue;
+        }
+        if (in_names)
+            builder.Define(name, true, fanins, cover);
+        in_names = false;
+        string token;
+        if (keyword == ".inputs") {
+            while (ss >> token)
+                builder.AddInput(token);
+        } else if (keyword == ".outputs") {
+            while (ss >> token)
+                outputs.push_back(token);
+        } else if (keyword == ".names") {
+            fanins.clear();
+            while (ss >> token)
+                fanins.push_back(token);
+            if (fanins.empty()) {
+                error = "A .names without output in " + fname;
+                return false;
+            }
+            name = fanins.back();
+            fanins.pop_back();
+            cover.clear();
+            in_names = true;
+        } else if (keyword == ".end") {
+            break;
+        } else if (keyword != ".model") {
+            error = "Unsupported " + keyword + " in " + fname;
+            return false;
+        }
+    }
+    if (in_names)
+        builder.Define(name, true, fanins, cover);
+    if (!builder.Build(outputs)) {
+        error = builder.error;
+        return false;
+    }
+    return true;
+}
+
+/*Reads the structural verilog module written by abc, returns false if it can not*/
+bool ReadVerilogNetlist(const string& fname, Netlist& net, string& error){
+    ifstream file(fname);
+    if (!file) {
+        error = "Could not open file " + fname;
+        return false;
+    }
+    //Drop the comments and split the module into its statements
+    string text, line;
+    while (getline(file, line))
+        text += line.substr(0, line.find("//")) + "\n";
+    NetlistBuilder builder(net);
+    vector<string> outputs;
+    stringstream statements(text);
+    string statement;
+    while (getline(statements, statement, ';')) {
+        for (size_t i = 0; i < statement.size(); i++)
+            if (statement[i] == '\n' || statement[i] == '\t')
+                statement[i] = ' ';
+        stringstream ss(statement);
+        string keyword;
+        if (!(ss >> keyword) || keyword == "module" || keyword == "wire" || keyword == "endmodule")
+            continue;
+        if (keyword == "input" || keyword == "output") {
+            string names, token;
+            getline(ss, names);
+            for (size_t i = 0; i < names.size(); i++)
+                if (names[i] == ',')
+                    names[i] = ' ';
+            stringstream ns(names);
+            while (ns >> token) {
+                if (keyword == "input")
+                    builder.AddInput(token);
+                else
+                    outputs.push_back(token);
+            }
+        } else if (keyword == "assign") {
+            const size_t eq = statement.find('=');
+            if (eq == string::npos) {
+                error = "Can not parse '" + statement + "'";
+                return false;
+            }
+            stringstream target(statement.substr(statement.find("assign") + 6, eq - statement.find("assign") - 6));
+            string name;
+            target >> name;
+            builder.Define(name, false, vector<string>(), statement.substr(eq + 1));
+        } else {
+            error = "Unsupported statement '" + keyword + "' in " + fname;
+            return false;
+        }
+    }
+    if (!builder.Build(outputs)) {
+        error = builder.error;
+        return false;
+    }
+    return true;
+}
+
+/*Builds the gate array of BDDs, one multiplexer per node. The inputs are the BDD
+  variables in var_ids, all variables of the BDDs must be among them*/
+bool BddNetlist(const vector<BDD>& bdds, const vector<int>& var_ids, Netlist& net){
+    map<int, int> var_gate;
+    for (size_t v = 0; v < var_ids.size(); v++) {
+        var_gate[var_ids[v]] = net.AddGate(GATE_INPUT);
+        net.inputs.push_back(var_gate[var_ids[v]]);
+        net.input_names.push_back(to_string(var_ids[v]));
+    }
+    unordered_map<DdNode*, int> node_gate;
+    const int one = net.AddGate(GATE_ONE);
+    //Post-order traversal without recursion, the regular nodes get gates
+    for (size_t o = 0; o < bdds.size(); o++) {
+        vector<DdNode*> stack(1, Cudd_Regular(bdds[o].getNode()));
+        while (!stack.empty()) {
+            DdNode* node = stack.back();
+            if (node_gate.count(node)) {
+                stack.pop_back();
+                continue;
+            }
+            if (Cudd_IsConstant(node)) {
+                node_gate[node] = one;
+                stack.pop_back();
+                continue;
+            }
+            DdNode* t = Cudd_Regular(Cudd_T(node));
+            DdNode* e = Cudd_Regular(Cudd_E(node));
+            if (!node_gate.count(t) || !node_gate.count(e)) {
+                if (!node_gate.count(t))
+                    stack.push_back(t);
+                if (!node_gate.count(e))
+                    stack.push_back(e);
+                continue;
+            }
+            if (!var_gate.count(Cudd_NodeReadIndex(node)))
+                return false;
+            const int then_gate = node_gate[t];
+            int else_gate = node_gate[e];
+            if (Cudd_IsComplement(Cudd_E(node)))
+                else_gate = net.AddGate(GATE_NOT, else_gate);
+            node_gate[node] = net.AddGate(GATE_MUX, var_gate[Cudd_NodeReadIndex(node)], then_gate, else_gate);
+            stack.pop_back();
+        }
+        DdNode* root = bdds[o].getNode();
+        int gate = node_gate[Cudd_Regular(root)];
+        if (Cudd_IsComplement(root))
+            gate = net.AddGate(GATE_NOT, gate);
+        net.outputs.push_back(gate);
+        net.output_names.push_back("f" + to_string(o));
+    }
+    return true;
+}
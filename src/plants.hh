@@ -0,0 +1,125 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   The plants of the examples, with the dynamics, initial state and target
+   of their simulate.cc, to close the loop around a controller outside of SCOTS.
+ */
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cmath>
+#include <functional>
+#include "RungeKutta4.hh"
+
+using namespace std;
+
+struct Plant {
+    string name;
+    int state_dim;
+    int input_dim;
+    //sampling time in seconds
+    double tau;
+    vector<double> x0;
+    //integrates the plant by tau from x with the input u
+    function<void(vector<double>& x, const vector<double>& u)> post;
+    //true if x is in the target, never for the plants without one
+    function<bool(const vector<double>& x)> target;
+};
+
+//examples/models/dcdc_bdd/simulate.cc, the input selects the mode 1 or 2
+void DcdcPost(vector<double>& state, const vector<double>& input){
+    using state_type = array<double,2>;
+    const double tau = 0.05;
+    const double xc=70;
+    const double xl=3;
+    const double rc=0.005;
+    const double rl=0.05;
+    const double ro=1;
+    const double vs=1;
+    auto rhs =[&](state_type& xx,  const state_type &x, const double &u) noexcept {
+        if(u==1) {
+            xx[0]=-rl/xl*x[0]+vs/xl;
+            xx[1]=-1/(xc*(ro+rc))*x[1];
+        } else {
+            xx[0]=-(1/xl)*(rl+ro*rc/(ro+rc))*x[0]-(1/xl)*ro/(5*(ro+rc))*x[1]+vs/xl;
+            xx[1]=(1/xc)*5*ro/(ro+rc)*x[0]-(1/xc)*(1/(ro+rc))*x[1];
+        }
+    };
+    state_type x = {{state[0], state[1]}};
+    double u = input[0];
+    scots::runge_kutta_fixed4(rhs,x,u,2,tau);
+    state.assign(x.begin(), x.end());
+}
+
+//examples/models/vehicle_bdd/simulate.cc
+void VehiclePost(vector<double>& state, const vector<double>& input){
+    using state_type = array<double,3>;
+    using input_type = vector<double>;
+    const double tau = 0.3;
+    auto rhs =[](state_type& xx,  const state_type& x, const input_type& u) {
+        double alpha=atan(tan(u[1])/2.0);
+        xx[0] = u[0]*cos(alpha+x[2])/cos(alpha);
+        xx[1] = u[0]*sin(alpha+x[2])/cos(alpha);
+        xx[2] = u[0]*tan(u[1]);
+    };
+    state_type x = {{state[0], state[1], state[2]}};
+    input_type u = input;
+    scots::runge_kutta_fixed4(rhs,x,u,3,tau,10);
+    state.assign(x.begin(), x.end());
+}
+
+//examples/models/aircraft_bdd/simulate.cc
+void AircraftPost(vector<double>& state, const vector<double>& input){
+    using state_type = array<double,3>;
+    const double tau = 0.25;
+    auto rhs =[] (state_type& xx,  const state_type& x, const vector<double>& u) {
+        double mg = 60000.0*9.81;
+        double mi = 1.0/60000;
+        double c=(1.25+4.2*u[1]);
+        xx[0] = mi*(u[0]*cos(u[1])-(2.7+3.08*c*c)*x[0]*x[0]-mg*sin(x[1]));
+        xx[1] = (1.0/(60000*x[0]))*(u[0]*sin(u[1])+68.6*c*x[0]*x[0]-mg*cos(x[1]));
+        xx[2] = x[0]*sin(x[1]);
+    };
+    state_type x = {{state[0], state[1], state[2]}};
+    vector<double> u = input;
+    scots::runge_kutta_fixed4(rhs,x,u,3,tau,10);
+    state.assign(x.begin(), x.end());
+}
+
+/*Sets plant to the example of the given name, dcdc, vehicle or aircraft, returns
+  false if there is none*/
+bool MakePlant(const string& name, Plant& plant){
+    plant.name = name;
+    if (name == "dcdc") {
+        plant.state_dim = 2;
+        plant.input_dim = 1;
+        plant.tau = 0.05;
+        plant.x0 = {0.7, 5.4};
+        plant.post = DcdcPost;
+        plant.target = [](const vector<double>&) { return false; };
+    } else if (name == "vehicle") {
+        plant.state_dim = 3;
+        plant.input_dim = 2;
+        plant.tau = 0.3;
+        plant.x0 = {0.6, 0.6, 0};
+        plant.post = VehiclePost;
+        plant.target = [](const vector<double>& x) {
+            return 9 <= x[0] && x[0] <= 9.5 && 0 <= x[1] && x[1] <= 0.5;
+        };
+    } else if (name == "aircraft") {
+        plant.state_dim = 3;
+        plant.input_dim = 2;
+        plant.tau = 0.25;
+        plant.x0 = {81, -1*M_PI/180, 55};
+        plant.post = AircraftPost;
+        plant.target = [](const vector<double>& x) {
+            return 63 <= x[0] && x[0] <= 75 && -3*M_PI/180 <= x[1] && x[1] <= 0 &&
+                   0 <= x[2] && x[2] <= 2.5 && -0.91 <= x[0] * sin(x[1]);
+        };
+    } else {
+        return false;
+    }
+    return true;
+}
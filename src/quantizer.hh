@@ -0,0 +1,87 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Fixed-point quantizer and input decoder of the quantized wrapper, shared
+   by wrapper.cc, which writes them as VHDL, and emulate_fpga.cc, which evaluates them
+   bit for bit in software.
+ */
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+//Word length of the fixed-point state and input values of the quantized wrapper
+const int FXP_WORD_BITS = 32;
+//Default number of fraction bits of the fixed-point values
+const int FXP_FRAC_BITS = 16;
+//Extra fraction bits of the offsets, they keep the cell borders exact to the input resolution
+const int FXP_GUARD_BITS = 8;
+//Bits of the constant multipliers of the quantizer, 25 fit in one DSP block
+const int FXP_INV_BITS = 25;
+//Clock cycles from the state to the input values: offset, scale, index, controller, decoder
+const int QUANTIZER_LATENCY = 5;
+//Width of the offset state and of its product with the inverse of eta
+const int FXP_OFFSET_BITS = FXP_WORD_BITS + FXP_GUARD_BITS + 1;
+const int FXP_PRODUCT_BITS = FXP_OFFSET_BITS + FXP_INV_BITS + 1;
+
+/*The constants of one state dimension. Its grid index floor((x - first + eta/2)/eta)
+  is (x - low)*inv >> shift, with low and inv the fixed-point versions of
+  first - eta/2 and 1/eta, low with FXP_GUARD_BITS more fraction bits than x*/
+struct FxpDim {
+    long long num;   //number of grid points
+    long long low;
+    long long inv;
+    int shift;
+};
+
+/*Computes the constants of state dimension k, returns false if the dimension can not
+  be quantized in <FXP_WORD_BITS,frac_bits> fixed-point*/
+bool MakeFxpDim(const vector<double>& eta, const vector<double>& lower, const vector<double>& upper,
+                int k, int frac_bits, FxpDim& dim){
+    dim.num = llround((upper[k] - lower[k]) / eta[k]) + 1;
+    dim.low = llround(ldexp(lower[k] - eta[k]/2, frac_bits + FXP_GUARD_BITS));
+    //The largest scale for which 1/eta fits into the multiplier
+    int scale = floor(log2(ldexp(eta[k], FXP_INV_BITS)));
+    while (llround(ldexp(1.0 / eta[k], scale)) >= (1LL << FXP_INV_BITS))
+        scale--;
+    dim.inv = llround(ldexp(1.0 / eta[k], scale));
+    dim.shift = frac_bits + FXP_GUARD_BITS + scale;
+    return dim.shift >= 0 && dim.low < (1LL << (FXP_OFFSET_BITS-1)) && dim.low >= -(1LL << (FXP_OFFSET_BITS-1));
+}
+
+//The input value of grid point i of input dimension m in the decoder table, 0 outside the grid
+long long FxpInputValue(const vector<double>& eta, const vector<double>& lower, long long num,
+                        int m, long long i, int frac_bits){
+    return (i < num) ? llround(ldexp(lower[m] + i*eta[m], frac_bits)) : 0;
+}
+
+//The value as a signed number of the given bits, as the numeric_std operators wrap it
+long long FxpWrap(long long value, int bits){
+    const int unused = 64 - bits;
+    return (long long) ((uint64_t) value << unused) >> unused;
+}
+
+/*The state value x as the fixed-point number the wrapper gets from LabVIEW, rounded
+  half to even and saturated as its default conversion does*/
+long long FxpFromDouble(double x, int frac_bits){
+    const double scaled = nearbyint(ldexp(x, frac_bits));
+    const double limit = ldexp(1.0, FXP_WORD_BITS-1);
+    if (!(scaled < limit))
+        return (long long) limit - 1;
+    if (scaled < -limit)
+        return -(long long) limit;
+    return (long long) scaled;
+}
+
+/*The three quantizer stages of one dimension on the fixed-point state xf: sets the
+  index bits idx and returns whether the state is in the grid of the dimension*/
+bool FxpQuantize(const FxpDim& dim, long long xf, uint64_t& idx){
+    const long long d = FxpWrap(xf * (1LL << FXP_GUARD_BITS) - dim.low, FXP_OFFSET_BITS);
+    //The product needs more than 64 bits, it is not wrapped as it fits its signal
+    const __int128 q = ((__int128) d * dim.inv) >> dim.shift;
+    idx = (uint64_t) q;
+    return q >= 0 && q < dim.num;
+}
@@ -0,0 +1,291 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Pipeline driver replacing the example scripts 1-run.sh ... 6-verilog_and_wrapper_whole.sh.
+   For every model of the configuration file it builds the stages
+   synthesize -> determinize -> split/whole blif -> verilog (abc) -> VHDL wrapper
+   as a dependency graph and runs them on a pool of threads. Each stage is keyed
+   by the content of its inputs, its tool binary and its command line; a stage
+   whose key matches the stamp of its last successful run is skipped. The
+   synthesis is also keyed by the model source and Makefile and by the .scs/.bdd
+   files of the model directory it reads, e.g. a saved transition function.
+
+   Usage: scots2fpga <models file> [jobs]
+
+   Every non-comment line of the models file reads
+       <name> <model dir> <state_space_dim> <det algorithm> <synthesis program|-> [fraction bits]
+   with paths relative to the directory the driver is run from (examples/).
+   With the fraction bits the wrapper of the split controller quantizes the
+   fixed-point state in the fabric, see wrapper.cc.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdlib>
+#include "scots2fpga.hh"
+#include "wrapper.hh"
+
+using namespace std;
+
+//Passes of the output code optimization of generate_blif for the quantized wrapper
+const int ENCODE_PASSES = 4;
+
+//A model of the models file
+struct Model {
+    string name;
+    string dir;
+    int state_dim;
+    string det_alg;
+    string synth;
+    int frac_bits;
+};
+
+vector<Model> ReadModels(const char* filename){
+    vector<Model> models;
+    ifstream file(filename);
+    if (!file) {
+        cerr << "Could not open file " << filename << endl;
+        return models;
+    }
+    string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        stringstream ss(line);
+        Model model;
+        if (ss >> model.name >> model.dir >> model.state_dim >> model.det_alg >> model.synth) {
+            if (!(ss >> model.frac_bits))
+                model.frac_bits = 0;
+            models.push_back(model);
+        }
+        else if (line.find_first_not_of(" \t\r") != string::npos)
+            cerr << "Skipping malformed line: " << line << endl;
+    }
+    return models;
+}
+
+//Adds the stage to the graph, making it depend on the stage with index after (if any)
+int AddStage(vector<Stage>& stages, Stage stage, int after){
+    stage.pending = 0;
+    stage.failed = false;
+    stage.stamp = DirName(stage.outputs.empty() ? stage.log : stage.outputs[0]) + "/." + stage.name + ".key";
+    stages.push_back(stage);
+    const int idx = stages.size() - 1;
+    if (after >= 0) {
+        stages[after].next.push_back(idx);
+        stages[idx].pending++;
+    }
+    return idx;
+}
+
+/*Creates the stages of one model, bin_dir is the directory of the src tools and
+  template_dir the one of their templates, ending in '/'*/
+void AddModelStages(vector<Stage>& stages, const Model& m, const string& bin_dir, const string& template_dir){
+    const string optdet = bin_dir + "/../ext/optdet/scots_opt_det";
+    const string abc = bin_dir + "/../ext/abc/abc";
+    const string controller = m.dir + "/controller";
+    const string det = m.dir + "/blgdet/determinized";
+    const string dim = to_string(m.state_dim);
+
+    int synth = -1;
+    if (m.synth != "-") {
+        Stage s;
+        s.model = m.name;
+        s.name = "synthesize";
+        //In a subshell, so that the log given relative to the working directory is written there
+        s.command = "(cd " + m.dir + " && ./" + m.synth + ")";
+        s.inputs = {m.dir + "/" + m.synth, m.dir + "/" + m.synth + ".cc", m.dir + "/Makefile"};
+        s.outputs = {controller + ".scs", controller + ".bdd"};
+        //The saved grids, transition function, ... the program reads, or writes if they are missing
+        s.cache_dir = m.dir;
+        s.log = controller + ".log";
+        synth = AddStage(stages, s, -1);
+    }
+
+    Stage d;
+    d.model = m.name;
+    d.name = "determinize";
+    d.command = optdet + " -s " + controller + " -t " + det + " -d " + dim + " -a " + m.det_alg;
+    d.inputs = {optdet, controller + ".scs", controller + ".bdd"};
+    d.outputs = {det + ".scs", det + ".bdd"};
+    d.dirs = {DirName(det)};
+    d.log = det + ".log";
+    const int determinize = AddStage(stages, d, synth);
+
+    //The split (per input bit) and the whole controller flows
+    const string flows[2][4] = {
+        {"", "generate_blif", "blif_file/blif_controller", "FPGA_files/verilog_controller"},
+        {"_whole", "generate_blif_whole", "blif_file_whole/blif_controller_whole", "FPGA_files_whole/verilog_controller_whole"}};
+    for (int f = 0; f < 2; f++) {
+        const string blif = m.dir + "/" + flows[f][2] + ".blif";
+        const string verilog = m.dir + "/" + flows[f][3] + ".v";
+
+        Stage b;
+        b.model = m.name;
+        b.name = "blif" + flows[f][0];
+        b.command = bin_dir + "/" + flows[f][1] + " " + det + " " + blif + " " + dim;
+        b.inputs = {bin_dir + "/" + flows[f][1], det + ".scs", det + ".bdd"};
+        b.outputs = {blif};
+        b.dirs = {DirName(blif)};
+        b.log = blif + ".log";
+        //The quantized wrapper decodes the optimized output codes of the split controller,
+        //their table is not written if the codes can not be optimized
+        if (f == 0 && m.frac_bits > 0)
+            b.command += " 0 " + to_string(ENCODE_PASSES);
+        const int blif_idx = AddStage(stages, b, determinize);
+
+        Stage v;
+        v.model = m.name;
+        v.name = "verilog" + flows[f][0];
+        v.command = abc + " -c \"read_blif " + blif + "; short_names; write_verilog " + verilog + "\"";
+        v.inputs = {abc, blif};
+        v.outputs = {verilog};
+        v.dirs = {DirName(verilog)};
+        v.log = verilog + ".log";
+        const int verilog_idx = AddStage(stages, v, blif_idx);
+
+        //The wrapper names its output after the verilog module, only the stamp tracks it
+        Stage w;
+        w.model = m.name;
+        w.name = "wrapper" + flows[f][0];
+        //The wrapper is given the templates the stage is keyed by
+        w.command = "SCOTS_TEMPLATE_DIR=" + template_dir + " " + bin_dir + "/wrapper " + verilog + " " + DirName(verilog) + "/";
+        w.inputs = {bin_dir + "/wrapper", template_dir + "template.vhd", verilog};
+        if (f == 0 && m.frac_bits > 0) {
+            w.command += " " + det + " " + blif + " " + dim + " " + to_string(m.frac_bits);
+            w.inputs.push_back(template_dir + "template_quantizer.vhd");
+            w.inputs.push_back(det + ".scs");
+            w.inputs.push_back(blif);
+            w.inputs.push_back(blif + ".codes");
+        }
+        w.log = DirName(verilog) + "/wrapper.log";
+        AddStage(stages, w, verilog_idx);
+    }
+}
+
+//Runs one stage unless it is up to date, returns true on success
+bool RunStage(Stage& stage, mutex& out_mutex){
+    const string key = StageKey(stage);
+    bool up_to_date = (ReadStamp(stage.stamp) == key);
+    for (vector<string>::const_iterator i = stage.outputs.begin(); i != stage.outputs.end(); ++i)
+        up_to_date = up_to_date && FileExists(*i);
+    if (up_to_date) {
+        lock_guard<mutex> lock(out_mutex);
+        cout << "[" << stage.model << "] " << stage.name << ": up to date" << endl;
+        return true;
+    }
+
+    for (vector<string>::const_iterator i = stage.dirs.begin(); i != stage.dirs.end(); ++i)
+        MakeDirs(*i);
+    //Invalidate the stamp first so that an interrupted run is never taken for a good one
+    remove(stage.stamp.c_str());
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    const int ret = system((stage.command + " > " + stage.log + " 2>&1").c_str());
+    const double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    bool ok = (ret == 0);
+    for (vector<string>::const_iterator i = stage.outputs.begin(); i != stage.outputs.end(); ++i)
+        ok = ok && FileExists(*i);
+    //The cached files are keyed as the run left them, the next run reads them
+    if (ok)
+        WriteStamp(stage.stamp, stage.cache_dir.empty() ? key : StageKey(stage));
+
+    lock_guard<mutex> lock(out_mutex);
+    cout << "[" << stage.model << "] " << stage.name << ": " << (ok ? "done" : "FAILED")
+         << " in " << secs << " s" << (ok ? "" : ", see " + stage.log) << endl;
+    return ok;
+}
+
+//Executes the graph on jobs threads, a stage starts as soon as all stages it depends on are finished
+int RunStages(vector<Stage>& stages, unsigned jobs){
+    mutex graph_mutex, out_mutex;
+    condition_variable cv;
+    queue<int> ready;
+    size_t finished = 0;
+    int failures = 0;
+
+    for (size_t i = 0; i < stages.size(); i++)
+        if (stages[i].pending == 0)
+            ready.push(i);
+
+    auto worker = [&]() {
+        unique_lock<mutex> lock(graph_mutex);
+        while (true) {
+            cv.wait(lock, [&]() { return !ready.empty() || finished == stages.size(); });
+            if (ready.empty())
+                return;
+            const int idx = ready.front();
+            ready.pop();
+            Stage& stage = stages[idx];
+
+            lock.unlock();
+            bool ok = false;
+            if (stage.failed) {
+                lock_guard<mutex> out_lock(out_mutex);
+                cout << "[" << stage.model << "] " << stage.name << ": skipped" << endl;
+            } else {
+                ok = RunStage(stage, out_mutex);
+            }
+            lock.lock();
+
+            if (!ok)
+                failures++;
+            for (vector<int>::const_iterator n = stage.next.begin(); n != stage.next.end(); ++n) {
+                stages[*n].failed = stages[*n].failed || !ok;
+                if (--stages[*n].pending == 0)
+                    ready.push(*n);
+            }
+            finished++;
+            cv.notify_all();
+        }
+    };
+
+    vector<thread> pool;
+    for (unsigned t = 0; t < jobs; t++)
+        pool.push_back(thread(worker));
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+    return failures;
+}
+
+int main(int argc, char* argv[]){
+
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <models file> [jobs]" << std::endl;
+        return 1;
+    }
+    unsigned jobs = (argc > 2) ? atoi(argv[2]) : thread::hardware_concurrency();
+    if (jobs == 0)
+        jobs = 1;
+
+    vector<Model> models = ReadModels(argv[1]);
+    if (models.empty()) {
+        cerr << "No models to process in " << argv[1] << endl;
+        return 1;
+    }
+
+    //The tools are expected next to the driver, in the build tree layout, whichever way it was started
+    const string bin_dir = ExecutableDir();
+    const string template_dir = TemplateDir();
+    vector<Stage> stages;
+    for (vector<Model>::const_iterator m = models.begin(); m != models.end(); ++m)
+        AddModelStages(stages, *m, bin_dir, template_dir);
+
+    cout << "Running " << stages.size() << " stages of " << models.size() << " models on " << jobs << " threads" << endl;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    const int failures = RunStages(stages, jobs);
+    cout << "Finished in " << chrono::duration<double>(chrono::steady_clock::now() - start).count()
+         << " s, " << failures << " stages failed or skipped" << endl;
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,133 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Helpers of the scots2fpga pipeline driver: the stage description,
+   content hashing of the stage inputs and the stamp files used to skip the
+   stages that are up to date.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <cerrno>
+#include <sys/stat.h>
+#include <dirent.h>
+
+using namespace std;
+
+//One step of the pipeline of a single model
+struct Stage {
+    string model;            //name of the model the stage belongs to
+    string name;             //name of the stage
+    string command;          //shell command executing the stage
+    vector<string> inputs;   //files whose content is part of the stage key
+    string cache_dir;        //directory whose .scs/.bdd files other than the outputs the command reads and may write
+    vector<string> outputs;  //files the stage must produce
+    vector<string> dirs;     //directories to create before running
+    string stamp;            //file storing the key of the last successful run
+    string log;              //file receiving the output of the command
+    vector<int> next;        //stages depending on this one
+    int pending;             //number of unfinished stages this one depends on
+    bool failed;             //true if the stage or one it depends on failed
+};
+
+//Offset basis of the 64 bit FNV-1a hash
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+//64 bit FNV-1a hash of a memory block, chained through the seed
+uint64_t Fnv1a(const char* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS){
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char) data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+//Hash of the content of a file, a missing file gets its own fixed hash
+uint64_t HashFile(const string& fname){
+    ifstream file(fname, ios::binary);
+    if (!file)
+        return Fnv1a("<missing>", 9);
+    uint64_t hash = FNV_OFFSET_BASIS;
+    char buffer[65536];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        hash = Fnv1a(buffer, file.gcount(), hash);
+    return hash;
+}
+
+//The files of a directory (not its subdirectories) ending in one of the suffixes, sorted
+vector<string> ListFiles(const string& dir, const vector<string>& suffixes){
+    vector<string> files;
+    DIR* d = opendir(dir.c_str());
+    if (!d)
+        return files;
+    for (struct dirent* e = readdir(d); e != NULL; e = readdir(d)) {
+        const string name = e->d_name;
+        for (vector<string>::const_iterator s = suffixes.begin(); s != suffixes.end(); ++s)
+            if (name.size() > s->size() && name.compare(name.size() - s->size(), s->size(), *s) == 0)
+                files.push_back(dir + "/" + name);
+    }
+    closedir(d);
+    sort(files.begin(), files.end());
+    return files;
+}
+
+//The key of a stage: its name, its command line and the content of all its inputs and cached files
+string StageKey(const Stage& stage){
+    stringstream key;
+    key << stage.name << "|" << stage.command;
+    for (vector<string>::const_iterator i = stage.inputs.begin(); i != stage.inputs.end(); ++i)
+        key << "|" << *i << "=" << hex << HashFile(*i);
+    if (!stage.cache_dir.empty()) {
+        const vector<string> cached = ListFiles(stage.cache_dir, {".scs", ".bdd"});
+        for (vector<string>::const_iterator i = cached.begin(); i != cached.end(); ++i)
+            if (find(stage.outputs.begin(), stage.outputs.end(), *i) == stage.outputs.end())
+                key << "|" << *i << "=" << hex << HashFile(*i);
+    }
+    const string text = key.str();
+    stringstream out;
+    out << hex << Fnv1a(text.data(), text.size());
+    return out.str();
+}
+
+bool FileExists(const string& fname){
+    struct stat info;
+    return stat(fname.c_str(), &info) == 0;
+}
+
+//Creates a directory and all its parents, like mkdir -p
+bool MakeDirs(const string& path){
+    for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+        const string dir = path.substr(0, pos);
+        if (!dir.empty() && mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+            return false;
+        if (pos == string::npos)
+            return true;
+    }
+}
+
+string ReadStamp(const string& fname){
+    ifstream file(fname);
+    string key;
+    file >> key;
+    return key;
+}
+
+void WriteStamp(const string& fname, const string& key){
+    ofstream file(fname);
+    file << key << endl;
+}
+
+//Directory part of a path, "." if there is none
+string DirName(const string& path){
+    const size_t pos = path.rfind('/');
+    if (pos == string::npos)
+        return ".";
+    return path.substr(0, pos);
+}
@@ -0,0 +1,138 @@
+/*
+   Author:        Antonio Rueda
+   Date:          18/10/2026
+   University:    TUDelft
+   Description:   Splitting of a determinized controller according to its control
+   input bits, shared by the blif and the BRAM generators.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <stdexcept>
+#include "cuddObj.hh"
+
+using namespace std;
+
+/*The read_input_vars fucntion look into the .scs file and search for the number
+   of inputs, storing them and returning them in a vector */
+vector <int> read_input_vars(int state_dim, const char* filename){
+	static const int max_line = 65536;
+	bool input_vars = false;
+	int counter = 0;
+	vector<int> u;
+	ifstream file( filename );
+	if (!file) {
+		cerr << "Could not open file " << filename << endl;
+		return {};
+	}
+	vector<string> tokens; // Storing all tokens
+	string line;
+	while (getline(file, line)) {
+		if (line.find("#END", 0) != string::npos) {
+			input_vars = false;
+		}
+		if (input_vars) {
+			u.push_back(stoi(line));
+		}
+		if (line.find("#VECTOR:BDD_VAR_ID_IN_DIM_" + to_string(state_dim+1+counter), 0) != string::npos) {
+			input_vars = true;
+			counter++;
+			file.ignore(max_line, '\n');
+		}
+
+	}
+	file.close();
+	return u;
+}
+
+/*The outputs of split_controller for the sub-BDD f: entry k is true where some input
+  of f has the bit k, the last entry where f has some input, computed from the
+  outputs of the children of f. Every edge of C is visited once, the results of
+  the complemented and regular edges are kept in memo. If CUDD fails, e.g. on the
+  memory budget of the manager, the error of the manager is thrown as by its C++
+  interface */
+struct split_traversal {
+	const Cudd* manager;
+	DdManager* dd;
+	//Position k of each BDD variable that is an input bit, -1 for state variables
+	vector<int> bit;
+	size_t no_outputs;
+	unordered_map<DdNode*, vector<DdNode*>> memo;
+
+	const vector<DdNode*>& outputs(DdNode* f) {
+		auto it = memo.find(f);
+		if (it != memo.end())
+			return it->second;
+		vector<DdNode*> s(no_outputs);
+		if (Cudd_IsConstant(f)) {
+			//Any input extends the path to one, none extends it to zero
+			DdNode* value = (f == Cudd_ReadOne(dd)) ? Cudd_ReadOne(dd) : Cudd_ReadLogicZero(dd);
+			for (auto& v : s) {
+				v = value;
+				Cudd_Ref(v);
+			}
+		} else {
+			DdNode* r = Cudd_Regular(f);
+			DdNode* T = Cudd_NotCond(Cudd_T(r), f != r);
+			DdNode* E = Cudd_NotCond(Cudd_E(r), f != r);
+			const int k = (Cudd_NodeReadIndex(r) < bit.size()) ? bit[Cudd_NodeReadIndex(r)] : -1;
+			//Copies, the memo may rehash in the recursion
+			const vector<DdNode*> sT = outputs(T);
+			const vector<DdNode*> sE = outputs(E);
+			for (size_t j = 0; j < no_outputs; j++) {
+				if (k < 0) {
+					//A state variable stays in the outputs
+					s[j] = Cudd_bddIte(dd, Cudd_bddIthVar(dd, Cudd_NodeReadIndex(r)), sT[j], sE[j]);
+				} else if (j == (size_t) k) {
+					//Bit k is one with any input of the then branch
+					s[j] = sT[no_outputs-1];
+				} else {
+					s[j] = Cudd_bddOr(dd, sT[j], sE[j]);
+				}
+				if (s[j] == NULL)
+					release_and_throw(s, j);
+				Cudd_Ref(s[j]);
+			}
+		}
+		return memo.emplace(f, move(s)).first->second;
+	}
+
+	//Releases the first done outputs of s, which are not in the memo yet, and throws the error of the manager
+	void release_and_throw(vector<DdNode*>& s, size_t done) {
+		for (size_t i = 0; i < done; i++)
+			Cudd_RecursiveDeref(dd, s[i]);
+		manager->checkReturnValue((DdNode*) NULL);
+		//The error handler of the manager did not throw
+		throw runtime_error("CUDD failed while splitting the controller");
+	}
+
+	~split_traversal() {
+		for (auto& m : memo)
+			for (auto& v : m.second)
+				Cudd_RecursiveDeref(dd, v);
+	}
+};
+
+/*Splits the controller C into one BDD per input variable, true where the input
+  bit is 1, followed by the domain of the controller. All of them only depend on
+  the state variables. For determinized controllers the input bit is the one of
+  the single input of the state. All outputs are built in one traversal of C */
+vector<BDD> split_controller(const Cudd& manager, const BDD& C, const vector<int>& readed_inputs){
+	const int size_of_inputs = readed_inputs.size();
+	split_traversal split;
+	split.manager = &manager;
+	split.dd = manager.getManager();
+	split.bit.assign(Cudd_ReadSize(split.dd), -1);
+	for (int k = 0; k < size_of_inputs; k++)
+		split.bit[readed_inputs[0]+k] = k;
+	split.no_outputs = size_of_inputs+1;
+	const vector<DdNode*>& outputs = split.outputs(C.getNode());
+	vector<BDD> s;
+	for (auto& v : outputs)
+		s.push_back(BDD(manager, v));
+	return s;
+}
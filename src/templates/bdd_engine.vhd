@@ -0,0 +1,166 @@
+--////////////////////////////////////////////////////////////////////////////////
+--
+-- Module Name: bdd_engine
+-- Project Name: Symbolic Controller implementation
+-- Target Devices: MyRIO FPGA
+--
+-- Evaluates the BDDs of a controller stored as a node table in a block RAM,
+-- one BDD level per clock cycle. Every node word holds, from the most
+-- significant bit down, the variable index (VAR_BITS), the then child
+-- (ADDR_BITS), the else child (ADDR_BITS) and the complement flag of the else
+-- edge. Address 0 is the constant one node. ROOTS holds NUM_ROOTS entries of
+-- ADDR_BITS+1 bits, root 0 in the least significant bits, each being the root
+-- address followed by its complement flag.
+--
+-- The memory is read synchronously: mem_addr is sampled at a rising edge and
+-- the node word is expected on mem_data during the following cycle. A rising
+-- edge with start = '1' samples x and starts the evaluation, done is high for
+-- one cycle when result holds the value of all roots. The C++ model in
+-- bdd_engine.hh is bit and cycle exact to this entity.
+--////////////////////////////////////////////////////////////////////////////////
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+
+entity bdd_engine is
+generic(
+ADDR_BITS : positive;
+VAR_BITS : positive;
+NUM_VARS : positive;
+NUM_ROOTS : positive;
+ROOTS : STD_LOGIC_VECTOR
+);
+port(
+clk : in STD_LOGIC;
+start : in STD_LOGIC;
+x : in STD_LOGIC_VECTOR(NUM_VARS-1 downto 0);
+mem_addr : out STD_LOGIC_VECTOR(ADDR_BITS-1 downto 0);
+mem_data : in STD_LOGIC_VECTOR(VAR_BITS+2*ADDR_BITS downto 0);
+result : out STD_LOGIC_VECTOR(NUM_ROOTS-1 downto 0);
+busy : out STD_LOGIC;
+done : out STD_LOGIC
+);
+end bdd_engine;
+
+architecture Behavioral of bdd_engine is
+
+constant ROOT_BITS : positive := ADDR_BITS+1;
+constant ROOTS_I : STD_LOGIC_VECTOR(NUM_ROOTS*ROOT_BITS-1 downto 0) := ROOTS;
+constant ZERO_ADDR : unsigned(ADDR_BITS-1 downto 0) := (others => '0');
+
+signal walking : STD_LOGIC := '0';
+signal root : integer range 0 to NUM_ROOTS-1 := 0;
+signal cur : unsigned(ADDR_BITS-1 downto 0) := (others => '0');
+signal comp : STD_LOGIC := '0';
+signal xr : STD_LOGIC_VECTOR(NUM_VARS-1 downto 0) := (others => '0');
+signal res : STD_LOGIC_VECTOR(NUM_ROOTS-1 downto 0) := (others => '0');
+signal done_r : STD_LOGIC := '0';
+
+signal next_walking : STD_LOGIC;
+signal next_root : integer range 0 to NUM_ROOTS-1;
+signal next_cur : unsigned(ADDR_BITS-1 downto 0);
+signal next_comp : STD_LOGIC;
+signal next_res : STD_LOGIC_VECTOR(NUM_ROOTS-1 downto 0);
+signal next_done : STD_LOGIC;
+
+function root_addr(r : integer) return unsigned is
+begin
+if r >= NUM_ROOTS then
+return ZERO_ADDR;
+end if;
+return unsigned(ROOTS_I(r*ROOT_BITS+ADDR_BITS downto r*ROOT_BITS+1));
+end function;
+
+function root_comp(r : integer) return STD_LOGIC is
+begin
+if r >= NUM_ROOTS then
+return '0';
+end if;
+return ROOTS_I(r*ROOT_BITS);
+end function;
+
+begin
+
+-- The address of the node read in the next cycle, taken by the memory at the same edge as by cur
+mem_addr <= std_logic_vector(next_cur);
+result <= res;
+busy <= walking;
+done <= done_r;
+
+process(walking, root, cur, comp, xr, res, start, mem_data)
+variable var : integer;
+variable child : unsigned(ADDR_BITS-1 downto 0);
+variable child_comp : STD_LOGIC;
+variable finished : boolean;
+begin
+next_walking <= walking;
+next_root <= root;
+next_cur <= cur;
+next_comp <= comp;
+next_res <= res;
+next_done <= '0';
+finished := false;
+
+if walking = '0' then
+if start = '1' then
+next_walking <= '1';
+next_root <= 0;
+next_cur <= root_addr(0);
+next_comp <= root_comp(0);
+end if;
+elsif cur = ZERO_ADDR then
+-- A constant root, its value is known without reading the node
+next_res(root) <= not comp;
+finished := true;
+else
+-- Take the edge selected by the variable of the node
+var := to_integer(unsigned(mem_data(VAR_BITS+2*ADDR_BITS downto 2*ADDR_BITS+1)));
+if var < NUM_VARS and xr(var) = '1' then
+child := unsigned(mem_data(2*ADDR_BITS downto ADDR_BITS+1));
+child_comp := comp;
+else
+child := unsigned(mem_data(ADDR_BITS downto 1));
+child_comp := comp xor mem_data(0);
+end if;
+if child = ZERO_ADDR then
+-- Reached the constant node, no need to read it
+next_res(root) <= not child_comp;
+finished := true;
+else
+next_cur <= child;
+next_comp <= child_comp;
+end if;
+end if;
+
+-- Go on with the next root, or stop after the last one
+if finished then
+if root = NUM_ROOTS-1 then
+next_walking <= '0';
+next_done <= '1';
+next_cur <= ZERO_ADDR;
+else
+next_root <= root+1;
+next_cur <= root_addr(root+1);
+next_comp <= root_comp(root+1);
+end if;
+end if;
+end process;
+
+process(clk)
+begin
+if rising_edge(clk) then
+if walking = '0' and start = '1' then
+xr <= x;
+end if;
+walking <= next_walking;
+root <= next_root;
+cur <= next_cur;
+comp <= next_comp;
+res <= next_res;
+done_r <= next_done;
+end if;
+end process;
+
+end Behavioral;
@@ -0,0 +1,89 @@
+--////////////////////////////////////////////////////////////////////////////////
+--
+-- Create Date: #$DATES$#
+-- Module Name: #$ENTITY_MODEL_NAME$#_BDD
+-- Project Name: Symbolic Controller implementation
+-- Target Devices: MyRIO FPGA
+--
+-- The controller as a node table of #$NUM_NODES$# words of #$WORD_BITS$# bits in a
+-- block RAM, evaluated by bdd_engine. x(i) is the value of the BDD variable i,
+-- result(i) the value of the controller input variable #$FIRST_INPUT_VAR$#+i and the
+-- last result bit tells whether x is in the domain of the controller. The
+-- result is ready at most #$MAX_LATENCY$# clock cycles after start. The same table is
+-- given in #$ENTITY_MODEL_NAME$#.coe and #$ENTITY_MODEL_NAME$#.mif to use a block memory core instead.
+--////////////////////////////////////////////////////////////////////////////////
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+
+entity #$ENTITY_MODEL_NAME$#_BDD is
+port(
+clk : in STD_LOGIC;
+start : in STD_LOGIC;
+x : in STD_LOGIC_VECTOR(#$NUM_VARS$#-1 downto 0);
+result : out STD_LOGIC_VECTOR(#$NUM_ROOTS$#-1 downto 0);
+busy : out STD_LOGIC;
+done : out STD_LOGIC
+);
+end #$ENTITY_MODEL_NAME$#_BDD;
+
+architecture Behavioral of #$ENTITY_MODEL_NAME$#_BDD is
+
+component bdd_engine
+generic(
+ADDR_BITS : positive;
+VAR_BITS : positive;
+NUM_VARS : positive;
+NUM_ROOTS : positive;
+ROOTS : STD_LOGIC_VECTOR
+);
+port(
+clk : in STD_LOGIC;
+start : in STD_LOGIC;
+x : in STD_LOGIC_VECTOR(NUM_VARS-1 downto 0);
+mem_addr : out STD_LOGIC_VECTOR(ADDR_BITS-1 downto 0);
+mem_data : in STD_LOGIC_VECTOR(VAR_BITS+2*ADDR_BITS downto 0);
+result : out STD_LOGIC_VECTOR(NUM_ROOTS-1 downto 0);
+busy : out STD_LOGIC;
+done : out STD_LOGIC
+);
+end component;
+
+type rom_t is array(0 to #$NUM_NODES$#-1) of STD_LOGIC_VECTOR(#$WORD_BITS$#-1 downto 0);
+constant ROM : rom_t := (
+#$ROM_WORDS$#);
+
+signal mem_addr : STD_LOGIC_VECTOR(#$ADDR_BITS$#-1 downto 0);
+signal mem_data : STD_LOGIC_VECTOR(#$WORD_BITS$#-1 downto 0);
+
+begin
+
+process(clk)
+begin
+if rising_edge(clk) then
+mem_data <= ROM(to_integer(unsigned(mem_addr)));
+end if;
+end process;
+
+engine : bdd_engine
+generic map (
+ADDR_BITS => #$ADDR_BITS$#,
+VAR_BITS => #$VAR_BITS$#,
+NUM_VARS => #$NUM_VARS$#,
+NUM_ROOTS => #$NUM_ROOTS$#,
+ROOTS => #$ROOTS$#
+)
+port map (
+clk => clk,
+start => start,
+x => x,
+mem_addr => mem_addr,
+mem_data => mem_data,
+result => result,
+busy => busy,
+done => done
+);
+
+end Behavioral;
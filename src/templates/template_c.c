@@ -0,0 +1,66 @@
+/*
+ * #$NAME$#.c
+ *
+ * Created: #$DATES$#
+ * Project Name: Symbolic Controller implementation
+ *
+ * Node table of #$NUM_NODES$# nodes for #$NUM_ROOTS$# BDDs over #$NUM_VARS$# variables. An edge is the
+ * node index << 1 | complement flag, node 0 is the constant one. Its children
+ * point back to it, so a walk that reached it stays there. All BDDs are walked
+ * for the length of the longest path, which gives the same number of steps
+ * for every state and no branch that depends on the state.
+ */
+
+#include <stdint.h>
+#include "#$NAME$#.h"
+
+typedef struct {
+    #$EDGE_TYPE$# child[2];
+    #$VAR_TYPE$# var;
+} #$NAME$#_node_t;
+
+static const #$NAME$#_node_t NODES[#$NUM_NODES$#] = {
+#$NODES$#
+};
+
+static const #$EDGE_TYPE$# ROOTS[#$NUM_ROOTS$#] = { #$ROOTS$# };
+
+/* length of the longest path of the BDDs */
+#define DEPTH #$DEPTH$#
+
+const double #$NAME$#_state_lower[#$PREFIX$#_STATE_DIM] = { #$STATE_LOWER$# };
+const double #$NAME$#_state_upper[#$PREFIX$#_STATE_DIM] = { #$STATE_UPPER$# };
+
+void #$NAME$#_eval(const unsigned char v[#$PREFIX$#_NUM_VARS], unsigned char out[#$NUM_ROOTS$#])
+{
+    uint32_t e[#$NUM_ROOTS$#];
+    int r, d;
+    for (r = 0; r < #$NUM_ROOTS$#; r++)
+        e[r] = ROOTS[r];
+    /* the BDDs are walked side by side, their loads do not wait for each other */
+    for (d = 0; d < DEPTH; d++) {
+        for (r = 0; r < #$NUM_ROOTS$#; r++) {
+            const #$NAME$#_node_t* n = &NODES[e[r] >> 1];
+            e[r] = n->child[v[n->var]] ^ (e[r] & 1);
+        }
+    }
+    for (r = 0; r < #$NUM_ROOTS$#; r++)
+        out[r] = (unsigned char) (~e[r] & 1);
+}
+
+int #$NAME$#_lookup(const double x[#$PREFIX$#_STATE_DIM], double u[#$PREFIX$#_INPUT_DIM])
+{
+    unsigned char v[#$PREFIX$#_NUM_VARS] = { 0 };
+    unsigned char out[#$NUM_ROOTS$#];
+    double q;
+    uint32_t i;
+    int ok, in = 1;
+
+    /* grid index floor((x - first)/eta + 1/2) of each state dimension and its bits */
+#$QUANTIZER$#
+    #$NAME$#_eval(v, out);
+
+    /* input grid points first + i*eta */
+#$DECODER$#
+    return in & out[#$NUM_ROOTS$# - 1];
+}
@@ -0,0 +1,43 @@
+/*
+ * #$NAME$#.h
+ *
+ * Created: #$DATES$#
+ * Project Name: Symbolic Controller implementation
+ *
+ * The controller as a self-contained C99 lookup. #$NAME$#_lookup quantizes the
+ * state to the grid of the controller, walks the #$NUM_NODES$# nodes of its BDDs and
+ * decodes the input grid point. The walk takes the same #$NUM_STEPS$# node steps for
+ * every state, so the execution time does not depend on the state.
+ */
+
+#ifndef #$GUARD$#
+#define #$GUARD$#
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define #$PREFIX$#_STATE_DIM #$STATE_DIM$#
+#define #$PREFIX$#_INPUT_DIM #$INPUT_DIM$#
+/* number of BDD variables and node steps of a lookup */
+#define #$PREFIX$#_NUM_VARS #$NUM_VARS$#
+#define #$PREFIX$#_NUM_STEPS #$NUM_STEPS$#
+
+/* bounds of the states covered by the grid of the controller */
+extern const double #$NAME$#_state_lower[#$PREFIX$#_STATE_DIM];
+extern const double #$NAME$#_state_upper[#$PREFIX$#_STATE_DIM];
+
+/* Sets u to the input of the state x. Returns 1 if x is in the domain of the
+   controller, otherwise 0 and u is not valid. */
+int #$NAME$#_lookup(const double x[#$PREFIX$#_STATE_DIM], double u[#$PREFIX$#_INPUT_DIM]);
+
+/* Evaluates the BDDs for the values v of the BDD variables. out[i] is the
+   value of the input BDD variable #$FIRST_INPUT_VAR$#+i, the last entry tells whether v is
+   in the domain of the controller. */
+void #$NAME$#_eval(const unsigned char v[#$PREFIX$#_NUM_VARS], unsigned char out[#$NUM_ROOTS$#]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* #$GUARD$# */
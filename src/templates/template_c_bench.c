@@ -0,0 +1,64 @@
+/*
+ * #$NAME$#_bench.c
+ *
+ * Created: #$DATES$#
+ * Project Name: Symbolic Controller implementation
+ *
+ * Linux micro-benchmark of #$NAME$#_lookup. It draws random states in the grid of
+ * the controller and reports the lookups per second and the share of states
+ * in the domain. Build it with
+ *   cc -std=c99 -O2 #$NAME$#_bench.c #$NAME$#.c -o #$NAME$#_bench
+ * and run it as #$NAME$#_bench [seconds].
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "#$NAME$#.h"
+
+/* number of states cycled through, a power of two */
+#define NUM_STATES 4096
+
+static double now(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+int main(int argc, char* argv[])
+{
+    static double x[NUM_STATES][#$PREFIX$#_STATE_DIM];
+    double u[#$PREFIX$#_INPUT_DIM], checksum = 0.0, start, elapsed;
+    const double seconds = (argc > 1) ? atof(argv[1]) : 1.0;
+    uint64_t seed = 1, lookups = 0, valid = 0, n;
+    int s, k;
+
+    for (s = 0; s < NUM_STATES; s++) {
+        for (k = 0; k < #$PREFIX$#_STATE_DIM; k++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            x[s][k] = #$NAME$#_state_lower[k] + (double) (seed >> 11) / 9007199254740992.0
+                      * (#$NAME$#_state_upper[k] - #$NAME$#_state_lower[k]);
+        }
+    }
+
+    start = now();
+    do {
+        for (n = 0; n < (1u << 16); n++, lookups++) {
+            if (#$NAME$#_lookup(x[lookups & (NUM_STATES - 1)], u)) {
+                valid++;
+                checksum += u[0];
+            }
+        }
+        elapsed = now() - start;
+    } while (elapsed < seconds);
+
+    printf("%llu lookups in %.3f s: %.0f lookups/s, %.1f ns per lookup\n",
+           (unsigned long long) lookups, elapsed, lookups / elapsed, 1e9 * elapsed / lookups);
+    printf("%.1f %% of the states in the domain, %d node steps per lookup (checksum %g)\n",
+           100.0 * valid / lookups, #$PREFIX$#_NUM_STEPS, checksum);
+    return 0;
+}
@@ -0,0 +1,51 @@
+--////////////////////////////////////////////////////////////////////////////////
+--
+-- Create Date: #$DATES$#
+-- Module Name: #$ENTITY_MODEL_NAME$#
+-- Project Name: Symbolic Controller implementation
+-- Target Devices: MyRIO FPGA
+--
+-- The state is given as #$FXP_FORMAT$# fixed-point values, quantized to
+-- the BDD input bits of the controller. The controller output bits are
+-- decoded back to the input values in the same format. The result is
+-- available #$LATENCY$# clock cycles after the state, flagged by valid.
+--
+-- This file has been created based on the scripts from M. Khaled:
+-- http://www.hcs.ei.tum.de and adapted to MyRIO FPGA
+-- https://gitlab.lrz.de/hcs/BDD2Implement
+--////////////////////////////////////////////////////////////////////////////////
+
+library IEEE;
+use IEEE.STD_LOGIC_1164.ALL;
+use IEEE.NUMERIC_STD.ALL;
+
+
+entity #$ENTITY_MODEL_NAME$#_Wrapper is
+port(
+clk : in STD_LOGIC;
+#$ENTITY_STATE_PORTS$#
+#$ENTITY_VALUE_PORTS$#
+valid : out STD_LOGIC
+);
+end #$ENTITY_MODEL_NAME$#_Wrapper;
+
+architecture Behavioral of #$ENTITY_MODEL_NAME$#_Wrapper is
+
+component #$ENTITY_MODEL_NAME$#
+port (
+#$ENTITY_INPUT_PORTS$#
+#$ENTITY_OUTPUT_PORTS$#);
+end component;
+
+#$QUANTIZER_DECLARATIONS$#
+
+begin
+
+#$QUANTIZER_BODY$#
+
+#$ENTITY_MODEL_NAME$#_x : #$ENTITY_MODEL_NAME$#
+port map (
+#$ENTITY_INPUT_PORTS_MAP$#
+#$ENTITY_OUTPUT_PORTS_MAP$#);
+
+end Behavioral;
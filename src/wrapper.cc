@@ -13,19 +13,199 @@
 #include <string>
 #include <algorithm>
 #include <vector>
+#include <cmath>
 #include "wrapper.hh"
+#include "quantizer.hh"
 
 using namespace std;
 
+//Largest input decoding table, in entries
+const int MAX_DECODER_ROM = 4096;
+
+/*Generates the quantizer and the decoder of the wrapper. The state value of each
+  dimension k is mapped to its grid index floor((x - first + eta/2)/eta) as
+  (x - LOW)*INV >> SHIFT, see FxpDim in quantizer.hh. The index bits drive the controller inputs that
+  belong to the BDD variables of the dimension, the most significant bit being
+  the first variable of BDD_VAR_ID_IN_DIM_k. The controller outputs are the
+  bits of the input BDD variables (see generate_blif.cc) followed by the domain
+  bit, they are decoded through a table of the input grid values. If generate_blif
+  optimized the output codes, its decode table <blif>.codes first maps them back
+  to the bits of the input BDD variables. The bundle of generate_bundle has the mode
+  port in addition, delayed as the state up to the controller inputs.*/
+bool GenerateQuantizer(const string& scs_file, const string& blif_file, int state_dim, int frac_bits,
+                       const vector<string>& vv_inputs, const vector<string>& vv_outputs,
+                       stringstream& statePorts, stringstream& valuePorts,
+                       stringstream& declarations, stringstream& body){
+    vector<double> eta = Read_ScsVector(scs_file, "ETA");
+    vector<double> lower = Read_ScsVector(scs_file, "LOWER_LEFT");
+    vector<double> upper = Read_ScsVector(scs_file, "UPPER_RIGHT");
+    vector<string> blif_inputs = Get_BlifInputs(blif_file);
+    const int dim = eta.size();
+    if (dim == 0 || (int) lower.size() != dim || (int) upper.size() != dim || state_dim <= 0 || state_dim >= dim) {
+        cerr << "Could not read the grid of " << scs_file << " for state dimension " << state_dim << endl;
+        return false;
+    }
+    if (blif_inputs.size() != vv_inputs.size() - 1) {
+        cerr << "The inputs of " << blif_file << " do not match the verilog module" << endl;
+        return false;
+    }
+    const int no_outputs = vv_outputs.size() - 1;
+    const int dw = FXP_OFFSET_BITS;
+    const int pw = FXP_PRODUCT_BITS;
+
+    //The quantizer, three pipeline stages per state dimension
+    stringstream stage1, stage2, stage3, in_range, pins;
+    for (int k = 0; k < state_dim; k++) {
+        vector<double> vars = Read_ScsVector(scs_file, "BDD_VAR_ID_IN_DIM_" + to_string(k+1));
+        const int nb = vars.size();
+        FxpDim fxp;
+        const bool fits = MakeFxpDim(eta, lower, upper, k, frac_bits, fxp);
+        const long long num = fxp.num, low = fxp.low, inv = fxp.inv;
+        const int shift = fxp.shift;
+        if (nb == 0 || !fits) {
+            cerr << "State dimension " << k+1 << " can not be quantized in <" << FXP_WORD_BITS << "," << frac_bits << "> fixed-point" << endl;
+            return false;
+        }
+        const string d = to_string(k);
+        statePorts << "x" << d << " : in STD_LOGIC_VECTOR(" << FXP_WORD_BITS-1 << " downto 0);" << endl;
+        declarations << "constant LOW_" << d << " : signed(" << dw-1 << " downto 0) := " << ToBinary(low, dw) << ";" << endl
+                     << "constant INV_" << d << " : signed(" << FXP_INV_BITS << " downto 0) := " << ToBinary(inv, FXP_INV_BITS+1) << ";" << endl
+                     << "constant NUM_" << d << " : signed(" << pw-1 << " downto 0) := " << ToBinary(num, pw) << ";" << endl
+                     << "signal d_" << d << " : signed(" << dw-1 << " downto 0);" << endl
+                     << "signal p_" << d << " : signed(" << pw-1 << " downto 0);" << endl
+                     << "signal idx_" << d << " : unsigned(" << nb-1 << " downto 0);" << endl
+                     << "signal in_" << d << " : STD_LOGIC;" << endl;
+        stage1 << "d_" << d << " <= shift_left(resize(signed(x" << d << "), " << dw << "), " << FXP_GUARD_BITS << ") - LOW_" << d << ";" << endl;
+        stage2 << "p_" << d << " <= d_" << d << " * INV_" << d << ";" << endl;
+        stage3 << "q := shift_right(p_" << d << ", " << shift << ");" << endl
+               << "idx_" << d << " <= unsigned(q(" << nb-1 << " downto 0));" << endl
+               << "if q >= 0 and q < NUM_" << d << " then in_" << d << " <= '1'; else in_" << d << " <= '0'; end if;" << endl;
+        in_range << (k ? " and " : "") << "in_" << d;
+        //Connect the index bits to the controller inputs of the dimension
+        for (int j = 0; j < nb; j++) {
+            vector<string>::const_iterator pos = find(blif_inputs.begin(), blif_inputs.end(), to_string((int) vars[j]));
+            if (pos != blif_inputs.end())
+                pins << vv_inputs[1 + (pos - blif_inputs.begin())] << " <= idx_" << d << "(" << nb-1-j << ");" << endl;
+        }
+    }
+
+    //The mode bits of a bundle, most significant first
+    const vector<string> modes = Read_Modes(blif_file + ".modes");
+    const int nm = modes.size();
+    if (nm > 0) {
+        statePorts << "mode : in STD_LOGIC_VECTOR(" << nm-1 << " downto 0);" << endl;
+        for (int s = 1; s <= 3; s++)
+            declarations << "signal mode_" << s << " : STD_LOGIC_VECTOR(" << nm-1 << " downto 0);" << endl;
+        stage1 << "mode_1 <= mode;" << endl;
+        stage2 << "mode_2 <= mode_1;" << endl;
+        stage3 << "mode_3 <= mode_2;" << endl;
+        for (int j = 0; j < nm; j++) {
+            vector<string>::const_iterator pos = find(blif_inputs.begin(), blif_inputs.end(), modes[j]);
+            //A mode bit that is not an input does not change the outputs
+            if (pos != blif_inputs.end())
+                pins << vv_inputs[1 + (pos - blif_inputs.begin())] << " <= mode_3(" << nm-1-j << ");" << endl;
+        }
+    }
+
+    //The decoder, the controller output bits are numbered from the first input BDD variable
+    stringstream decode, stage5;
+    const vector<long long> codes = Read_Codes(blif_file + ".codes");
+    const string input_bits = codes.empty() ? "po_r" : "ucode";
+    if (!codes.empty()) {
+        if ((int) codes.size() > MAX_DECODER_ROM || (long long) codes.size() != (1LL << (no_outputs - 1))) {
+            cerr << "The decode table " << blif_file << ".codes does not match the controller outputs" << endl;
+            return false;
+        }
+        declarations << "type code_rom_t is array(0 to " << codes.size()-1 << ") of STD_LOGIC_VECTOR(" << no_outputs-2 << " downto 0);" << endl
+                     << "constant CODE_ROM : code_rom_t := (" << endl;
+        for (size_t k = 0; k < codes.size(); k++)
+            declarations << ToBinary(codes[k], no_outputs-1) << ((k + 1 < codes.size()) ? "," : ");") << endl;
+        declarations << "signal ucode : STD_LOGIC_VECTOR(" << no_outputs-2 << " downto 0);" << endl;
+        decode << "ucode <= CODE_ROM(to_integer(unsigned(po_r(" << no_outputs-2 << " downto 0))));" << endl;
+    }
+    int no_input_vars = 0;
+    const int first_var = Read_ScsVector(scs_file, "BDD_VAR_ID_IN_DIM_" + to_string(state_dim+1)).at(0);
+    for (int m = state_dim; m < dim; m++) {
+        vector<double> vars = Read_ScsVector(scs_file, "BDD_VAR_ID_IN_DIM_" + to_string(m+1));
+        const int nb = vars.size();
+        const long long num = llround((upper[m] - lower[m]) / eta[m]) + 1;
+        if ((1LL << nb) > MAX_DECODER_ROM) {
+            cerr << "Input dimension " << m+1 << " has too many values for the decoder" << endl;
+            return false;
+        }
+        const string d = to_string(m - state_dim);
+        valuePorts << "u" << d << " : out STD_LOGIC_VECTOR(" << FXP_WORD_BITS-1 << " downto 0);" << endl;
+        declarations << "type rom_" << d << "_t is array(0 to " << (1LL << nb)-1 << ") of signed(" << FXP_WORD_BITS-1 << " downto 0);" << endl
+                     << "constant U_ROM_" << d << " : rom_" << d << "_t := (" << endl;
+        for (long long i = 0; i < (1LL << nb); i++) {
+            const long long value = FxpInputValue(eta, lower, num, m, i, frac_bits);
+            if (value >= (1LL << (FXP_WORD_BITS-1)) || value < -(1LL << (FXP_WORD_BITS-1))) {
+                cerr << "Input dimension " << m+1 << " does not fit in <" << FXP_WORD_BITS << "," << frac_bits << "> fixed-point" << endl;
+                return false;
+            }
+            declarations << ToBinary(value, FXP_WORD_BITS) << ((i + 1 < (1LL << nb)) ? "," : ");") << endl;
+        }
+        declarations << "signal uidx_" << d << " : unsigned(" << nb-1 << " downto 0);" << endl;
+        for (int j = 0; j < nb; j++) {
+            const int bit = (int) vars[j] - first_var;
+            if (bit < 0 || bit >= no_outputs - 1) {
+                cerr << "BDD variable " << vars[j] << " is not an output of the controller" << endl;
+                return false;
+            }
+            decode << "uidx_" << d << "(" << nb-1-j << ") <= " << input_bits << "(" << bit << ");" << endl;
+        }
+        stage5 << "u" << d << " <= std_logic_vector(U_ROM_" << d << "(to_integer(uidx_" << d << ")));" << endl;
+        no_input_vars += nb;
+    }
+    if (no_input_vars != no_outputs - 1) {
+        cerr << "The controller outputs do not match the input bits, use the split controller" << endl;
+        return false;
+    }
+
+    //The controller inputs and outputs are internal signals
+    for (vector<string>::const_iterator i = vv_inputs.begin()+1; i != vv_inputs.end(); ++i)
+        declarations << "signal " << *i << " : STD_LOGIC := '0';" << endl;
+    for (vector<string>::const_iterator i = vv_outputs.begin()+1; i != vv_outputs.end(); ++i)
+        declarations << "signal " << *i << " : STD_LOGIC;" << endl;
+    declarations << "signal po_r : STD_LOGIC_VECTOR(" << no_outputs-1 << " downto 0);" << endl
+                 << "signal in_range : STD_LOGIC;";
+
+    body << pins.str() << decode.str() << endl
+         << "process(clk)" << endl
+         << "variable q : signed(" << pw-1 << " downto 0);" << endl
+         << "begin" << endl
+         << "if rising_edge(clk) then" << endl
+         << "-- 1: offset of the state" << endl << stage1.str()
+         << "-- 2: scale by the inverse of eta" << endl << stage2.str()
+         << "-- 3: grid index and range check" << endl << stage3.str()
+         << "-- 4: controller outputs" << endl;
+    for (int j = 0; j < no_outputs; j++)
+        body << "po_r(" << j << ") <= " << vv_outputs[1+j] << ";" << endl;
+    body << "in_range <= " << in_range.str() << ";" << endl
+         << "-- 5: input values, valid if the state is in the controller domain" << endl
+         << "valid <= po_r(" << no_outputs-1 << ") and in_range;" << endl
+         << "end if;" << endl
+         << "end process;" << endl << endl
+         << "process(clk)" << endl
+         << "begin" << endl
+         << "if rising_edge(clk) then" << endl
+         << stage5.str()
+         << "end if;" << endl
+         << "end process;";
+    return true;
+}
+
 int main(int argc, char* argv[]){
 
-    if (argc < 3) {
-        std::cerr << "Usage: " << argv[0] << " <source verilog> <target vhd>" << std::endl;
+    if (argc < 3 || argc == 4 || argc == 5) {
+        std::cerr << "Usage: " << argv[0] << " <source verilog> <target vhd>"
+                  << " [<source controller> <source blif> <state_space_dim> [fraction_bits]]" << std::endl;
         return 1;
     }
+    //With the controller and its blif the wrapper quantizes the state in the fabric
+    const bool quantized = (argc > 5);
 
     cout << "\n\nGenerating VHDL wrapper for" << argv[1] << endl;
-    const string template_file = "../build/src/templates/template.vhd";
 
 	const char* filename   = argv[1];
 
@@ -35,6 +215,10 @@ int main(int argc, char* argv[]){
 		return 1;
 	}
 
+    string templateText;
+    if (!ReadTemplate(quantized ? "template_quantizer.vhd" : "template.vhd", templateText))
+        return 1;
+
     //Storing module, inputs and outputs names in vectors
     vector<string> vv_modname = Get_ModName(file);
     vector<string> vv_inputs = Get_Inputs(file);
@@ -58,13 +242,29 @@ int main(int argc, char* argv[]){
     outPortsMap.seekp(outPortsMap.str().length()-2);
     outPortsMap << " ";
 
-    string templateText = ReadAllFileText(template_file);
+    stringstream statePorts, valuePorts, declarations, body;
+    const int frac_bits = (argc > 6) ? atoi(argv[6]) : FXP_FRAC_BITS;
+    if (quantized && !GenerateQuantizer(string(argv[3]) + ".scs", argv[4], atoi(argv[5]), frac_bits,
+                                        vv_inputs, vv_outputs, statePorts, valuePorts, declarations, body))
+        return 1;
+
     string OutText = ReplaceString(templateText,"#$ENTITY_MODEL_NAME$#",  modelname.str());
     OutText = ReplaceString(OutText,"#$ENTITY_INPUT_PORTS$#",  inPorts.str());
     OutText = ReplaceString(OutText,"#$ENTITY_INPUT_PORTS_MAP$#",  inPortsMap.str());
     OutText = ReplaceString(OutText,"#$ENTITY_OUTPUT_PORTS$#", outPorts.str());
     OutText = ReplaceString(OutText,"#$ENTITY_OUTPUT_PORTS_MAP$#", outPortsMap.str());
     OutText = ReplaceString(OutText, "#$DATES$#", GetCurrentDateTime());
+    if (quantized) {
+        stringstream format, latency;
+        format << "<+/-" << FXP_WORD_BITS << "," << FXP_WORD_BITS-frac_bits << ">";
+        latency << QUANTIZER_LATENCY;
+        OutText = ReplaceString(OutText, "#$FXP_FORMAT$#", format.str());
+        OutText = ReplaceString(OutText, "#$LATENCY$#", latency.str());
+        OutText = ReplaceString(OutText, "#$ENTITY_STATE_PORTS$#", statePorts.str());
+        OutText = ReplaceString(OutText, "#$ENTITY_VALUE_PORTS$#", valuePorts.str());
+        OutText = ReplaceString(OutText, "#$QUANTIZER_DECLARATIONS$#", declarations.str());
+        OutText = ReplaceString(OutText, "#$QUANTIZER_BODY$#", body.str());
+    }
 
     const string outFilename = argv[2] + modelname.str() + "_Wrapper.vhd";
 
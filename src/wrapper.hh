@@ -2,6 +2,8 @@
 #include <iterator>
 #include <cstring>
 #include <time.h>
+#include <cstdlib>
+#include <unistd.h>
 
 using namespace std;
 
@@ -95,6 +97,36 @@ string ReadAllFileText(const string& fname){
     return strStream.str();//str holds the content of the file
 }
 
+//The directory of the running executable, "." if /proc/self/exe can not be read
+string ExecutableDir(){
+    char path[4096];
+    const ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (len <= 0)
+        return ".";
+    const string exe(path, len);
+    return exe.substr(0, exe.rfind('/'));
+}
+
+/*The directory of the templates, ending in '/': the one of SCOTS_TEMPLATE_DIR if it is
+  set, otherwise templates/ next to the executable, where the build copies them*/
+string TemplateDir(){
+    const char* dir = getenv("SCOTS_TEMPLATE_DIR");
+    if (dir && *dir)
+        return string(dir) + "/";
+    return ExecutableDir() + "/templates/";
+}
+
+//Reads the template fname of TemplateDir(), false with an error if it is missing or empty
+bool ReadTemplate(const string& fname, string& text){
+    const string path = TemplateDir() + fname;
+    text = ReadAllFileText(path);
+    if (text.empty()) {
+        cerr << "Could not read the template " << path << endl;
+        return false;
+    }
+    return true;
+}
+
 // Function Extracted from utils.hh of BDD2Implement
 string ReplaceString(string subject, const string& search,
                           const string& replace) {
@@ -112,3 +144,79 @@ void FileWriteAllText(const std::string& fname, string data){
     out << data;
     out.close();
 }
+
+// Function to read the values of a #VECTOR:<name> of a .scs file
+vector<double> Read_ScsVector(const string& fname, const string& name){
+    ifstream file(fname);
+    string line;
+    while ( getline( file, line ) ) {
+        if ( line == "#VECTOR:" + name ) {
+            vector<double> values;
+            getline( file, line );
+            const int size = stoi(line.substr(line.find(':') + 1));
+            for (int i = 0; i < size && getline( file, line ); i++)
+                values.push_back(stod(line));
+            return values;
+        }
+    }
+    return vector<double>();
+}
+
+// Function to find the names of the .inputs of a .blif file, Cudd_DumpBlif
+// names them after the BDD variable ids, in the order abc numbers them
+vector<string> Get_BlifInputs(const string& fname){
+    ifstream file(fname);
+    string line, inputs;
+    while ( getline( file, line ) ) {
+        if ( line.compare(0, 7, ".inputs") == 0 ) {
+            inputs = line.substr(7);
+            //The list continues on the next line after a backslash
+            while ( !inputs.empty() && inputs[inputs.size()-1] == '\\' && getline( file, line ) )
+                inputs = inputs.substr(0, inputs.size()-1) + " " + line;
+            break;
+        }
+    }
+    stringstream ss(inputs);
+    istream_iterator<string> begin(ss);
+    istream_iterator<string> end;
+    return vector<string>(begin, end);
+}
+
+// Function to read the decode table of the output codes written by generate_blif,
+// the input code of every output code, empty if there is no table
+vector<long long> Read_Codes(const string& fname){
+    ifstream file(fname);
+    string line;
+    vector<long long> codes;
+    while ( getline( file, line ) ) {
+        if ( line.empty() || line[0] == '#' )
+            continue;
+        stringstream ss(line);
+        long long code, input;
+        if ( !(ss >> code >> input) || code != (long long) codes.size() )
+            return vector<long long>();
+        codes.push_back(input);
+    }
+    return codes;
+}
+
+// Function to read the BDD variable ids of the mode bits of a bundle written by
+// generate_bundle, empty if the controller is not a bundle
+vector<string> Read_Modes(const string& fname){
+    ifstream file(fname);
+    string line;
+    vector<string> modes;
+    while ( getline( file, line ) )
+        if ( !line.empty() && line[0] != '#' )
+            modes.push_back(line);
+    return modes;
+}
+
+// Function to write a two's complement value as a VHDL bit string literal
+string ToBinary(long long value, int width){
+    string bits(width, '0');
+    for (int i = 0; i < width; i++)
+        if ((value >> min(i, 63)) & 1)
+            bits[width-1-i] = '1';
+    return "\"" + bits + "\"";
+}